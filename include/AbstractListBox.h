@@ -2,9 +2,11 @@
 
 #include <string>
 #include <vector>
+#include <memory>     // shared_ptr
 #include <curses.h>
 #include "MouseEvent.h"
 #include "CursesWidget.h"
+#include "ListSource.h"
 
 class ListItem;
 
@@ -20,8 +22,17 @@ class AbstractListBox: public CursesWidget {
 
     std::string _name;
     std::vector<ListItem *> _items;
+    std::shared_ptr<const ListSource> _source;  // Used instead of _items if set
     int _firstprint;
 
+    /* Item at an index, from the source or _items. Does not check bounds. */
+
+    ListItem * item(unsigned int idx) const;
+
+    /* Copies items from the source into _items, so they can be edited */
+
+    void detachSource();
+
     virtual void redrawFrame();
     virtual void redrawSingleItem(unsigned int idx) = 0;
     virtual void redrawScrollIndicator() const = 0;
@@ -40,6 +51,11 @@ class AbstractListBox: public CursesWidget {
     virtual void removeItem(unsigned int idx);
     virtual void clearList();
 
+    /* Shows items from a source instead of a list of its own. List boxes
+       copied from this one share the source. */
+
+    void setSource(const std::shared_ptr<const ListSource> & source);
+
     /* Set attributes */
 
     void setName(const std::string & name);
@@ -57,7 +73,7 @@ class AbstractListBox: public CursesWidget {
 
     /* Handles mouse event */
 
-    std::string handleMouseEvent(MouseEvent *mevent) = 0;
+    Signal handleMouseEvent(MouseEvent *mevent) = 0;
 
     /* Draws frame, items, etc. as needed */
 
@@ -65,5 +81,5 @@ class AbstractListBox: public CursesWidget {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL) = 0;
+    virtual Signal exec(MouseEvent * mevent=NULL) = 0;
 };
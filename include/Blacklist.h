@@ -2,18 +2,47 @@
 
 #include <vector>
 #include <string>
-#include <regex>
+#include <unordered_map>
+#include <mutex>
+#include "PatternMatcher.h"
 
 /*******************************************************************************
 
-Reads blacklist files and checks packages and SlackBuilds for matches
+Reads blacklist files and checks packages and SlackBuilds for matches. Verdicts
+are remembered and saved to a cache file along with a hash of the blacklist
+file, so that packages seen before are not matched again on the next run. The
+cache is discarded when the blacklist file changes.
 
 *******************************************************************************/
 class Blacklist {
 
   private:
 
-    std::vector<std::regex> _patterns;
+    /* Cached verdict, and whether it has been looked up in this session */
+
+    struct verdict {
+      bool blacklisted;
+      bool used;
+    };
+
+    PatternMatcher _patterns;
+    bool _empty;
+    std::string _hash, _cache_path;
+    mutable std::unordered_map<std::string, verdict> _verdicts;
+    mutable std::mutex _mutex;
+    mutable bool _dirty;
+
+    /* Reads cached verdicts if they were saved for the same patterns */
+
+    void loadCache();
+
+    /* Looks up or computes and remembers a verdict. Keys of installed packages
+       and SlackBuild names are kept apart by a prefix. */
+
+    bool cachedMatch(const std::string & key, const std::string & pkg,
+                     const std::string & name, const std::string & version,
+                     const std::string & arch, const std::string & build,
+                     bool by_name) const;
 
   public:
 
@@ -21,10 +50,19 @@ class Blacklist {
 
     Blacklist();
 
+    /* Set location of cache file (call before read) */
+
+    void setCachePath(const std::string & path);
+
     /* Reads blacklist patterns from file */
 
     int read(const std::string & filename); 
 
+    /* Saves verdicts to the cache file if any are new. Those not looked up
+       in this session are dropped. */
+
+    int save();
+
     /* Checks installed package for matches in name, version, arch, build, and
        fullname */
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+
+class BuildListItem;
+
+/*******************************************************************************
+
+Log of SlackBuilds whose state has changed (installed, upgraded, removed,
+tagged, etc.), so that the lists can be updated for just those instead of
+being filtered again from scratch. Each change gets the next generation number;
+a reader remembers the generation it has caught up to and asks for the
+SlackBuilds changed since then. May be used from several threads.
+
+*******************************************************************************/
+class BuildChanges {
+
+  private:
+
+    struct change {
+      unsigned int generation;
+      BuildListItem *build;
+    };
+
+    std::vector<change> _changes;      // In order of generation
+    unsigned int _generation;
+    unsigned int _held;                // Changes after this are kept
+    bool _holding;
+    mutable std::mutex _mutex;
+
+  public:
+
+    /* Constructor */
+
+    BuildChanges();
+
+    /* Records a change to a SlackBuild */
+
+    void record(BuildListItem *build);
+
+    /* Generation of the latest change */
+
+    unsigned int generation() const;
+
+    /* Gets the SlackBuilds changed after a generation, each listed once */
+
+    void since(unsigned int generation,
+               std::vector<BuildListItem *> & builds) const;
+
+    /* Forgets changes up to and including a generation, once they have been
+       read */
+
+    void discard(unsigned int generation);
+
+    /* Keeps changes after a generation from being discarded until released,
+       for a reader that catches up less often than the main lists */
+
+    void hold(unsigned int generation);
+    void release();
+
+    /* Forgets all changes. Must be called when the SlackBuilds they point to
+       are deleted. */
+
+    void clear();
+};
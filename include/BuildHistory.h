@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include "BuildListItem.h"
+
+/*******************************************************************************
+
+A single entry in the build history
+
+*******************************************************************************/
+struct build_record {
+  double seconds;           // Wall time taken to build and install
+  double cpu_seconds;       // User plus system CPU time (0 if unknown)
+  long max_rss;             // Peak memory use in kilobytes (0 if unknown)
+  long long source_size;    // Size of SlackBuild directory incl. sources
+  long long timestamp;      // When the build finished (seconds since epoch)
+};
+
+/*******************************************************************************
+
+Records how long SlackBuilds take to build and predicts the time needed to
+carry out a set of changes
+
+*******************************************************************************/
+class BuildHistory {
+
+  private:
+
+    std::string _path;
+    std::map<std::string, build_record> _records;
+    double _seconds_per_byte, _median_seconds;
+    bool _loaded;
+
+    /* Reads history file the first time it is needed */
+
+    void load();
+
+    /* Computes the rates used to estimate builds with no record, whenever the
+       records change */
+
+    void fit();
+
+  public:
+
+    /* Constructor */
+
+    BuildHistory();
+
+    /* Set location of history file */
+
+    void setPath(const std::string & path);
+
+    /* Records a successful build */
+
+    int record(const BuildListItem & build, double seconds,
+               double cpu_seconds=0., long max_rss=0);
+
+    /* Looks up the most recent build of a SlackBuild */
+
+    bool lookup(const std::string & name, build_record & rec);
+
+    /* Predicted time to build a SlackBuild */
+
+    double estimate(const BuildListItem & build);
+
+    /* Predicts total, critical path, and parallel (njobs) time for a list of
+       marked SlackBuilds given in build order */
+
+    void predict(const std::vector<BuildListItem *> & builds,
+                 unsigned int njobs, double & total, double & critical,
+                 double & parallel);
+};
+
+long long slackbuild_size(const BuildListItem & build);
@@ -18,6 +18,7 @@ class BuildListBox: public ListBox {
 
     TagList *_taglist;
 
+    chtype itemAttributes(unsigned int idx) const;
     virtual void redrawFrame();
     virtual void redrawSingleItem(unsigned int idx);
 
@@ -41,5 +42,5 @@ class BuildListBox: public ListBox {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include "ListItem.h"
+#include "VersionKey.h"
+
+class PackageDatabase;
 
 /*******************************************************************************
 
@@ -13,10 +16,30 @@ class BuildListItem: public ListItem {
 
   private:
 
+    // Result of the last read of repo info (-1 if not read yet) and the repo
+    // generation it was read from
+
+    int _repo_check;
+    unsigned int _repo_generation;
+
+    // Interned IDs of name, category, and requirements (see interned_names)
+
+    unsigned int _name_id, _category_id;
+    std::vector<unsigned int> _requires_ids;
+
+    // Default props are added to one prototype item and copied from it, so
+    // that items are quick to create
+
+    struct prototype_tag {};
+    BuildListItem(prototype_tag);
+
+    // Installed and available versions, parsed for comparison
+
+    VersionKey _installed_key, _available_key;
+
     // Checks whether a SlackBuild can be upgraded
 
-    bool differsByKernel(const std::string & installed_version,
-                         const std::string & available_version) const;
+    void updateVersionKeys();
     bool upgradable() const;
 
   public:
@@ -25,14 +48,45 @@ class BuildListItem: public ListItem {
 
     BuildListItem();
 
+    // Sets name and category and gets their IDs
+
+    void setNameAndCategory(const std::string & name,
+                            const std::string & category);
+
+    // Interned IDs. requiresIds() is only set once repo info has been read.
+
+    unsigned int nameId() const;
+    unsigned int categoryId() const;
+    const std::vector<unsigned int> & requiresIds() const;
+
     // Convert ListItem to BuildListItem
 
     void operator = (const ListItem & item);
 
-    // Reads properties from repo 
+    // Reads properties from repo. ensureRepoProps only reads available
+    // version, requirements, and build number if they haven't been read
+    // since the repo was last synced, and otherwise returns the result of
+    // the last read.
 
-    void readInstalledProps(std::vector<std::string> & installedpkgs);
+    void readInstalledProps(const PackageDatabase & packages);
     int readPropsFromRepo();
+    int ensureRepoProps();
+    bool repoPropsRead() const;
+
+    // Sets properties read from repo by get_repo_info elsewhere
+
+    void setRepoInfo(int check, const std::string & available_version,
+                     const std::string & reqs,
+                     const std::string & available_buildnum);
+
+    // Sets upgradable status, if repo info has been read
+
+    void updateUpgradable();
+
+    // Compares available version to installed version: positive if newer,
+    // negative if older (a downgrade), or 0 if the same or either is unknown
+
+    int versionChange();
 
     // Determines BUILD number from last portion of package name
 
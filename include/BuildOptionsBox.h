@@ -45,7 +45,7 @@ class BuildOptionsBox: public InputBox {
     std::string entry(unsigned int idx) const;
     std::string entries() const;
 
-    /* Write build options to file */
+    /* Saves build options */
 
     int write(const BuildListItem & build) const;
 
@@ -55,5 +55,5 @@ class BuildOptionsBox: public InputBox {
 
     /* User interaction loop */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
+
+/*******************************************************************************
+
+Saved build options for all SlackBuilds, kept in a single file. Changes are
+appended to the file as they are made, one line per SlackBuild, and synced to
+disk, so a crash can at most lose a line that was being written. The file is
+read in full at startup, with later lines overriding earlier ones, and is
+rewritten without the overridden lines when enough of them have built up.
+Options for SlackBuilds that are no longer in the repository are kept. If the
+file does not exist yet, options are imported from the directory of
+.buildopts files used by older versions.
+
+*******************************************************************************/
+class BuildOptionsStore {
+
+  private:
+
+    std::string _path, _legacy_dir;
+    std::unordered_map<std::string, std::string> _options;
+    unsigned int _nrecords;    // Lines in the file, including overridden ones
+    bool _loaded;
+    mutable std::mutex _mutex;
+
+    /* Creates the directory holding the file if needed */
+
+    int createDir() const;
+
+    /* Parses one line of the file */
+
+    void parseRecord(std::string_view line);
+
+    /* Reads the file. The caller must hold the lock. */
+
+    int load();
+
+    /* Reads the legacy directory of .buildopts files */
+
+    int importLegacy();
+
+    /* Appends a line to the file and syncs it to disk */
+
+    int append(const std::string & line) const;
+
+    /* Rewrites the file with only the current options */
+
+    int compact();
+
+  public:
+
+    /* Constructor */
+
+    BuildOptionsStore();
+
+    /* Set/get location of the file and of the legacy directory */
+
+    void setPath(const std::string & path);
+    void setLegacyDir(const std::string & dir);
+    const std::string & path() const;
+
+    /* Reads the file, or imports the legacy directory if there is no file.
+       Returns 0 on success (including when there is nothing to read) or 1 if
+       the file exists but can't be read. */
+
+    int read();
+    bool loaded() const;
+
+    /* Number of SlackBuilds with options */
+
+    unsigned int size() const;
+
+    /* Looks up options for a SlackBuild. Returns true if found. */
+
+    bool lookup(const std::string & name, std::string & options) const;
+
+    /* Saves options for a SlackBuild, or removes them if options is empty.
+       Returns 0 on success or 1 if they could not be saved. */
+
+    int set(const std::string & name, const std::string & options);
+};
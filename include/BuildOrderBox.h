@@ -41,5 +41,5 @@ class BuildOrderBox: public BuildListBox {
 
     /* Handles mouse event */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 };
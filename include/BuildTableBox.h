@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <curses.h>
+#include "BuildListItem.h"
+#include "BuildListBox.h"
+#include "VersionKey.h"
+
+/*******************************************************************************
+
+Single list of all SlackBuilds in a table, with columns for name, category,
+installed and available versions, size, and time taken by the last build. The
+table can be sorted by any column.
+
+*******************************************************************************/
+class BuildTableBox: public BuildListBox {
+
+  public:
+
+    enum column { Name, Category, Installed, Available, Size, LastBuild,
+                  ncolumns };
+
+  private:
+
+    /* Sort keys and display text computed once per SlackBuild */
+
+    struct row_keys {
+      BuildListItem *build;
+      std::string category, sizetext, buildtext;
+      VersionKey installed, available;
+      long long size;
+      double build_seconds;
+    };
+
+    std::vector<row_keys> _rows;       // In original order
+    std::vector<unsigned int> _order;  // _rows indices in sorted order
+    std::unordered_map<BuildListItem *, unsigned int> _row_index;
+    column _sort_column;
+    bool _descending;
+
+    void columnWidths(int cols, std::vector<int> & widths) const;
+    std::string composeRow(const std::vector<std::string> & fields,
+                           const std::vector<int> & widths) const;
+    void setLocalKeys(row_keys & row) const;
+    void setRepoKeys(row_keys & row) const;
+    void applyOrder();
+    void reorder();
+
+    /* Drawing */
+
+    void redrawFrame();
+    void redrawSingleItem(unsigned int idx);
+
+  public:
+
+    /* Constructor */
+
+    BuildTableBox();
+
+    /* Sizes and places window between main window header and footer */
+
+    void placeWindow() const;
+
+    /* Lists all SlackBuilds, computing sort keys for each. Keeps the current
+       sort order and highlighted SlackBuild if possible. */
+
+    void setBuilds(std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    /* Computes sort keys again for SlackBuilds that have changed, then sorts
+       again */
+
+    void updateBuilds(const std::vector<BuildListItem *> & changed);
+
+    /* Sorts by a column. Sorting by the same column again reverses the
+       order. */
+
+    void sortBy(column col);
+};
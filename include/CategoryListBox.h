@@ -31,5 +31,5 @@ class CategoryListBox: public ListBox {
 
     /* User interaction loop */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 };
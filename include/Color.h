@@ -6,6 +6,22 @@
 
 /*******************************************************************************
 
+Color labels set by color themes. Pairs are referenced by a foreground and a
+background label.
+
+*******************************************************************************/
+namespace color
+{
+  enum label {
+    fg_normal, bg_normal, fg_title, bg_title, fg_info, bg_info,
+    fg_highlight_active, bg_highlight_active, fg_highlight_inactive,
+    bg_highlight_inactive, header, header_popup, tagged, fg_popup, bg_popup,
+    fg_warning, bg_warning, hotkey, fg_combobox, bg_combobox, nlabels
+  };
+}
+
+/*******************************************************************************
+
 Manages colors for ncurses, making color pairs easy to reference by foreground
 and background color.
 
@@ -15,7 +31,8 @@ class Color {
   private:
 
     struct color_entry {
-      std::string label, name, basename, type;
+      color::label label;
+      std::string name, basename, type;
       bool bright;
     };
 
@@ -28,6 +45,10 @@ class Color {
     std::vector<color_pair> _colors;
     int _active_pair;
 
+    /* Index in _colors for each foreground and background label, or -1 */
+
+    int _table[color::nlabels][color::nlabels];
+
     /* Translate string color (red, green, etc.) into ncurses variable */
 
     void baseColorName(const std::string & colorname, std::string & basename,
@@ -42,24 +63,26 @@ class Color {
 
     /* Create or access color pair by foreground & background colors */
 
-    void addPair(const std::string & fg_label, const std::string & fg_name,
-                 const std::string & bg_label, const std::string & bg_name);
-    int getPair(const std::string & fg_label,
-                const std::string & bg_label) const;
+    void addPair(color::label fg_label, const std::string & fg_name,
+                 color::label bg_label, const std::string & bg_name);
+    int getPair(color::label fg_label, color::label bg_label) const;
 
     /* Bold / blink properties */
 
     bool pairIsBold(int vec_idx) const;
     bool pairBlinks(int vec_idx) const;
 
+    /* Attributes set by a color pair, for use in chtype strings */
+
+    int getAttributes(int vec_idx, chtype & attr) const;
+
     /* Turn color setting on or off in window */
 
-    int turnOn(WINDOW *win, const std::string & fg_label,
-               const std::string & bg_label);
+    int turnOn(WINDOW *win, color::label fg_label, color::label bg_label);
     int turnOn(WINDOW *win, int vec_idx);
     int turnOff(WINDOW *win);
-    int setBackground(WINDOW *win, const std::string & fg_label,
-                      const std::string & bg_label) const;
+    int setBackground(WINDOW *win, color::label fg_label,
+                      color::label bg_label) const;
     int setBackground(WINDOW *win, int vec_idx) const;
 
     /* Clears all colors */
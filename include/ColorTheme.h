@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "Color.h"
 
 /*******************************************************************************
@@ -25,6 +26,10 @@ class ColorTheme {
     std::string _hotkey;
     std::string _fg_combobox, _bg_combobox;
 
+    /* Pointers to each color setting, in a fixed order */
+
+    void colorVars(std::vector<std::string *> & vars);
+
   public:
 
     /* Constructor */
@@ -44,6 +49,11 @@ class ColorTheme {
 
     int read(const std::string & color_theme_file);
 
+    /* Get or set all colors at once, in a fixed order */
+
+    void getColors(std::vector<std::string> & colors) const;
+    int setColors(const std::vector<std::string> & colors);
+
     /* Set UI colors from theme */
 
     void applyTheme(Color & colors) const;
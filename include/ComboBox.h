@@ -27,7 +27,7 @@ class ComboBox: public InputItem {
 
     /* User interaction with list */
 
-    std::string execList(int y_offset, MouseEvent * mevent=NULL);
+    Signal execList(int y_offset, MouseEvent * mevent=NULL);
 
   public:
 
@@ -46,9 +46,9 @@ class ComboBox: public InputItem {
 
     /* User interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent, int y_offset);
+    Signal handleMouseEvent(MouseEvent * mevent, int y_offset);
     void draw(int y_offset, bool force=false, bool highlight=false); 
-    std::string exec(int y_offset, MouseEvent * mevent=NULL);
+    Signal exec(int y_offset, MouseEvent * mevent=NULL);
 
     /* Accessing properties */
 
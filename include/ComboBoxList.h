@@ -38,5 +38,5 @@ class ComboBoxList: public SelectionBox {
 
     /* Handles mouse event */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 };
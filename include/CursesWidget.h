@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <curses.h>
+#include "Color.h"
+#include "redraw.h"
+#include "signals.h"
 #include "MouseEvent.h"
 
 /*******************************************************************************
@@ -23,15 +26,15 @@ class CursesWidget {
     virtual void redrawButtons();
 
     std::vector<std::string> _buttons;  // At the bottom, e.g. OK/Cancel
-    std::vector<std::string> _button_signals;
+    std::vector<Signal> _button_signals;
     std::vector<int> _button_left;      // Left edge of each button
     std::vector<int> _button_right;     // Right edge of each button
 
     int _highlighted_button;
     unsigned int _reserved_rows, _header_rows;
-    std::string _redraw_type;
-    std::string _button_fg, _button_bg;
-    std::string _bg_color, _fg_color;   // Default colors
+    unsigned int _redraw_type;          // Bitmask from redraw.h
+    color::label _button_fg, _button_bg;
+    color::label _bg_color, _fg_color;  // Default colors
 
     WINDOW *_win;
 
@@ -44,13 +47,12 @@ class CursesWidget {
     /* Set attributes */
 
     virtual void setWindow(WINDOW *win);
-    void addButton(const std::string & button, const std::string & signal);
+    void addButton(const std::string & button, const Signal & signal);
     void clearButtons();
     void setButtons(const std::vector<std::string> & buttons,
-                    const std::vector<std::string> & button_signals);
-    void setButtonColor(const std::string & button_fg,
-                        const std::string & button_bg);
-    void setColor(const std::string & fg_color, const std::string & bg_color);
+                    const std::vector<Signal> & button_signals);
+    void setButtonColor(color::label button_fg, color::label button_bg);
+    void setColor(color::label fg_color, color::label bg_color);
 
     /* Sets size and position of popup boxes */
 
@@ -66,12 +68,12 @@ class CursesWidget {
     virtual void minimumSize(int & height, int & width) const = 0;
     virtual void preferredSize(int & height, int & width) const = 0;
     int highlightedButton() const;
-    const std::string & fgColor() const;
-    const std::string & bgColor() const;
+    color::label fgColor() const;
+    color::label bgColor() const;
 
     /* Mouse interaction */
 
-    virtual std::string handleMouseEvent(MouseEvent * mevent) = 0;
+    virtual Signal handleMouseEvent(MouseEvent * mevent) = 0;
 
     /* Draws frame and message */
 
@@ -79,5 +81,5 @@ class CursesWidget {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL) = 0;
+    virtual Signal exec(MouseEvent * mevent=NULL) = 0;
 };
@@ -41,5 +41,5 @@ class DirListBox: public SelectionBox {
 
     /* User interaction loop */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 };
@@ -72,7 +72,7 @@ class InputBox: public CursesWidget {
 
     /* Mouse interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* Draws frame, entry, etc. as needed */
 
@@ -80,7 +80,7 @@ class InputBox: public CursesWidget {
 
     /* User interaction loop */
 
-    std::string handleInput(std::string & selection, bool & getting_input,
-                            bool & needs_selection, MouseEvent * mevent=NULL);
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    Signal handleInput(Signal & selection, bool & getting_input,
+                       bool & needs_selection, MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <curses.h>
+#include "redraw.h"
+#include "signals.h"
 #include "MouseEvent.h"
 
 /*******************************************************************************
@@ -16,7 +18,8 @@ class InputItem {
 
     WINDOW *_win;
     int _posx, _posy, _width; 
-    std::string _name, _redraw_type, _item_type;
+    std::string _name, _item_type;
+    unsigned int _redraw_type;          // Bitmask from redraw.h
     bool _selectable, _auto_position;
 
     /* Prints to end of line or specified number of spaces */
@@ -55,9 +58,9 @@ class InputItem {
 
     // User interaction
 
-    virtual std::string handleMouseEvent(MouseEvent * mevent, int y_offset) = 0;
+    virtual Signal handleMouseEvent(MouseEvent * mevent, int y_offset) = 0;
     virtual void draw(int y_offset, bool force=false, bool highlight=false) = 0;
-    virtual std::string exec(int y_offset, MouseEvent * mevent=NULL);
+    virtual Signal exec(int y_offset, MouseEvent * mevent=NULL);
 
     // Accessing properties of different types. Derived classes should
     // reimplement these as needed.
@@ -5,6 +5,8 @@
 #include <curses.h>
 #include "BuildListItem.h"
 #include "BuildOrderBox.h"
+#include "Journal.h"
+#include "JobQueue.h"
 #include "MouseEvent.h"
 
 /*******************************************************************************
@@ -21,6 +23,7 @@ class InstallBox: public BuildOrderBox {
        for many of the operations. */
 
     std::vector<BuildListItem *> _builds;
+    std::vector<bool> _requested;
     int _ndeps, _ninvdeps;
 
     /* Drawing */
@@ -46,21 +49,31 @@ class InstallBox: public BuildOrderBox {
     bool installingAllDeps() const;
     bool installingRequested() const;
 
-    /* Creates list based on SlackBuild selected */
+    /* Predicted time to apply marked changes */
 
-    int create(BuildListItem & build,
+    void predictTimes(unsigned int njobs, double & total, double & critical,
+                      double & parallel) const;
+
+    /* Creates list based on SlackBuilds selected */
+
+    int create(const std::vector<BuildListItem *> & builds,
                std::vector<std::vector<BuildListItem> > & slackbuilds,
                const std::string & action, bool resolve_deps=true,
-               bool batch=false, bool rebuild_inv_deps=false);
+               bool rebuild_inv_deps=false);
+
+    /* Creates list from steps remaining in an interrupted batch */
+
+    int createFromSteps(const std::vector<journal_step> & steps,
+                        std::vector<std::vector<BuildListItem> > & slackbuilds);
 
     /* Handles mouse event */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* User interaction loop. Differs from standard BuildListBox exec() in
        that the space bar is used to tag (select/unselect) items */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 
     /* Make a list of packages from a different repo that will be changed */
 
@@ -70,4 +83,8 @@ class InstallBox: public BuildOrderBox {
 
     int applyChanges(int & ninstalled, int & nupgraded, int & nreinstalled,
                      int & nremoved);
+
+    /* Queue changes to run in the background instead */
+
+    int queueChanges(JobQueue & jobs) const;
 };
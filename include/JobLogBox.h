@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <curses.h>
+#include "ListItem.h"
+#include "ScrollBox.h"
+#include "JobQueue.h"
+
+/*******************************************************************************
+
+Shows background jobs and their output, following new output as it arrives
+unless the user has scrolled up
+
+*******************************************************************************/
+class JobLogBox: public ScrollBox {
+
+  private:
+
+    std::vector<ListItem> _lines;
+    unsigned int _generation;
+    bool _initialized;
+
+    /* Drawing */
+
+    void redrawSingleItem(unsigned int idx);
+
+  public:
+
+    /* Constructor */
+
+    JobLogBox();
+
+    /* Sizes and places window (full screen) */
+
+    void placeWindow() const;
+
+    /* Updates list from job queue. Returns true if anything changed. */
+
+    bool update(const JobQueue & jobs);
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include "BuildListItem.h"
+#include "Process.h"
+
+/*******************************************************************************
+
+A package operation run in the background
+
+*******************************************************************************/
+struct job {
+  BuildListItem *build;   // Only valid while queued or running; the lists
+                          //   may be read again (e.g. by a sync) afterwards
+  std::string name;       // Name of the SlackBuild, kept for the job log
+  std::string action;     // Install, Upgrade, Reinstall, or Remove
+  std::string phase;      // Action currently running (an upgrade may turn
+                          //   into a reinstall)
+  std::string status;     // Queued, Running, Done, Failed, or Cancelled
+  unsigned int batch;     // Jobs queued together; a failure cancels the rest
+  std::vector<std::string> log;
+  pid_t pid;              // Process running the current phase
+  double seconds;         // Wall time for all phases
+  double cpu_seconds;     // User plus system CPU time for all phases
+  long max_rss;           // Peak memory use in kilobytes
+};
+
+/*******************************************************************************
+
+Runs install/upgrade/reinstall/remove operations one at a time in a child
+process while the user interface keeps running. poll() must be called
+regularly (e.g. from an idle hook) to collect output and start the next job.
+
+*******************************************************************************/
+class JobQueue {
+
+  private:
+
+    std::vector<job> _jobs;
+    unsigned int _current, _round_start, _nbatches, _generation;
+    bool _changed;
+    Process _process;
+    std::string _partial;
+    std::chrono::steady_clock::time_point _start;
+
+    void appendOutput(const std::string & text);
+    int startPhase(job & current);
+    void startNext();
+    void finishCurrent(int status);
+
+  public:
+
+    /* Constructor */
+
+    JobQueue();
+
+    /* Adds a job. Jobs added with the same batch number are cancelled if one
+       of them fails. Returns 0 if added or 1 if the same job is already
+       pending. */
+
+    unsigned int newBatch();
+    int add(BuildListItem *build, const std::string & action,
+            unsigned int batch);
+
+    /* Collects output, finishes, and starts jobs. Returns true while any jobs
+       are queued or running. */
+
+    bool poll();
+
+    /* Stops the running job and cancels queued ones */
+
+    void cancel();
+
+    /* Get attributes */
+
+    bool busy() const;
+    const std::vector<job> & jobs() const;
+    unsigned int generation() const;
+    std::string statusText() const;
+
+    /* Returns true (once) if any SlackBuild was changed since the last call */
+
+    bool takeChanged();
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+/*******************************************************************************
+
+A single step recorded in the journal
+
+*******************************************************************************/
+struct journal_step {
+  std::string action, name;
+  bool done;
+};
+
+/*******************************************************************************
+
+Write-ahead journal for install/upgrade/reinstall/remove operations. Planned
+steps are written to disk before they are applied and marked as done once they
+succeed, so that a batch interrupted by a crash or lost session can be resumed.
+
+*******************************************************************************/
+class Journal {
+
+  private:
+
+    std::string _path;
+    bool _active;
+
+    /* Appends a line to the journal file and syncs it to disk */
+
+    int append(const std::string & line) const;
+
+  public:
+
+    /* Constructor */
+
+    Journal();
+
+    /* Set/get location of journal file */
+
+    void setPath(const std::string & path);
+    const std::string & path() const;
+
+    /* Starts a new batch, discarding any previous journal */
+
+    int begin();
+
+    /* Records a planned step and its completion */
+
+    int plan(const std::string & action, const std::string & name);
+    int complete(const std::string & name);
+
+    /* Ends the batch and removes the journal */
+
+    int finish();
+
+    /* Reads steps that were planned but not completed in a previous run */
+
+    int pending(std::vector<journal_step> & steps) const;
+};
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <curses.h>
+#include "Color.h"
 #include "AbstractListBox.h"
 #include "MouseEvent.h"
 
@@ -20,6 +21,18 @@ class ListBox: public AbstractListBox {
     int _highlight, _prevhighlight;
     bool _activated;
 
+    /* Rows as last drawn, one per line of the window, reused while an item's
+       text, attributes, and width are unchanged, so that scrolling doesn't
+       compose rows again */
+
+    struct cached_row {
+      std::string text;
+      int hotkey = -1, width = 0, divider = -1;
+      chtype attr = 0, hotattr = 0;
+      std::vector<chtype> line;
+    };
+    std::vector<cached_row> _rowcache;
+
     /* Setting item to be highlighted */
 
     int highlightFirst();
@@ -30,12 +43,22 @@ class ListBox: public AbstractListBox {
     int highlightPreviousPage();
     int highlightFractional(const double & frac);
 
+    /* Moves highlight for an arrow or page key, including any repeats of it
+       already typed, and returns the parts of the list to redraw */
+
+    unsigned int moveHighlight(int key);
+
     /* Determines first item to print (needed for scrolling) */
 
     int determineFirstPrint();
 
     /* Drawing */
 
+    chtype colorAttributes(color::label fg, color::label bg,
+                           chtype fallback) const;
+    void printRow(unsigned int idx, int y, int x, int width,
+                  const std::string & text, int hotkey, chtype attr,
+                  chtype hotattr, int divider=-1);
     virtual void redrawSingleItem(unsigned int idx);
     virtual void redrawScrollIndicator() const;
     void redrawChangedItems();
@@ -47,8 +70,9 @@ class ListBox: public AbstractListBox {
     ListBox();
     ListBox(WINDOW *win, const std::string & name);
 
-    /* Edit list */
+    /* Edit list. Inserting or removing keeps the highlighted item. */
 
+    void insertItem(unsigned int idx, ListItem *item);
     void removeItem(unsigned int idx);
     virtual void clearList();
 
@@ -73,7 +97,7 @@ class ListBox: public AbstractListBox {
 
     /* Handles mouse event */
 
-    virtual std::string handleMouseEvent(MouseEvent * mevent);
+    virtual Signal handleMouseEvent(MouseEvent * mevent);
 
     /* Draws frame, items, etc. as needed */
  
@@ -81,5 +105,5 @@ class ListBox: public AbstractListBox {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
@@ -2,13 +2,15 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 /*******************************************************************************
 
 Basic class for an item that goes in a list box. Each item can have multiple
 properties and values, but it must at least have a name. Additional properties
 are stored as strings, but helper functions are included to set and get them via
-other types; e.g., addBoolProp, setBoolProp, and getBoolProp.
+other types; e.g., addBoolProp, setBoolProp, and getBoolProp. Property names
+are stored once for all items, so each item only holds its values.
 
 *******************************************************************************/
 class ListItem {
@@ -16,7 +18,7 @@ class ListItem {
   protected:
 
     struct listprop {
-      std::string propname;
+      const std::string *propname;   // Shared; see internPropName
       std::string value;
     };
 
@@ -26,15 +28,15 @@ class ListItem {
 
     // Conversions
 
-    std::string bool2String(bool value) const;
+    const char * bool2String(bool value) const;
     bool string2Bool(const std::string & value) const;
 
     // Accessing props
 
-    int findPropByName(const std::string & propname, int & propidx,
-                       int & lbound, int & rbound) const;
-    int propIdxByName(const std::string & propname) const;
-    void setPropByIdx(unsigned int idx, const std::string & value);
+    static const std::string * internPropName(std::string_view propname);
+    int propIdxByName(std::string_view propname) const;
+    void setPropByIdx(unsigned int idx, std::string_view value);
+    void insertProp(std::string_view propname, std::string_view value);
 
   public:
 
@@ -50,16 +52,16 @@ class ListItem {
        is returned. By default it is set to -1. */
     void setHotKey(int hotkey); 
                                    
-    void addProp(const std::string & propname, const std::string & value);
-    void addBoolProp(const std::string & propname, bool value);
-    int setProp(const std::string & propname, const std::string & value);
-    int setBoolProp(const std::string & propname, bool value);
+    void addProp(std::string_view propname, std::string_view value);
+    void addBoolProp(std::string_view propname, bool value);
+    int setProp(std::string_view propname, std::string_view value);
+    int setBoolProp(std::string_view propname, bool value);
 
     // Get properties
 
     const std::string & name() const;
     int hotKey() const;
-    bool checkProp(const std::string & propname) const;
-    const std::string & getProp(const std::string & propname) const;
-    bool getBoolProp(const std::string & propname) const;
+    bool checkProp(std::string_view propname) const;
+    const std::string & getProp(std::string_view propname) const;
+    bool getBoolProp(std::string_view propname) const;
 };
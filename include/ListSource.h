@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include "ListItem.h"
+
+/*******************************************************************************
+
+Items shown in a list box, when they are kept somewhere else instead of being
+copied into the list box. A list box only asks for the items it draws, so the
+cost of scrolling and redrawing depends on the number of visible rows, not on
+the length of the list.
+
+*******************************************************************************/
+class ListSource {
+
+  public:
+
+    virtual ~ListSource() {}
+
+    /* Number of items and item at an index */
+
+    virtual unsigned int size() const = 0;
+    virtual ListItem * item(unsigned int idx) const = 0;
+
+    ListItem * operator [] (unsigned int idx) const { return item(idx); }
+};
+
+/*******************************************************************************
+
+Source for items stored by value in a vector owned elsewhere, e.g. all the
+SlackBuilds in a category. The vector must not be resized or destroyed while a
+list box is using it.
+
+*******************************************************************************/
+template<typename T>
+class VectorSource: public ListSource {
+
+  private:
+
+    std::vector<T> & _list;
+
+  public:
+
+    VectorSource(std::vector<T> & list) : _list(list) {}
+
+    unsigned int size() const { return _list.size(); }
+    ListItem * item(unsigned int idx) const { return &_list[idx]; }
+};
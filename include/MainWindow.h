@@ -9,10 +9,15 @@
 #include "CategoryListBox.h"
 #include "BuildListItem.h"
 #include "BuildListBox.h"
+#include "BuildTableBox.h"
 #include "FilterBox.h"
 #include "SearchBox.h"
 #include "InputBox.h"
 #include "TagList.h"
+#include "InstallBox.h"
+#include "JobQueue.h"
+#include "JobLogBox.h"
+#include "RepoLoader.h"
 #include "OptionsWindow.h"
 #include "KeyHelpWindow.h"
 #include "MouseHelpWindow.h"
@@ -42,8 +47,14 @@ class MainWindow: public CursesWidget {
     KeyHelpWindow _help;
     MouseHelpWindow _mousehelp;
     Menubar _menubar;
-    std::string _filter, _info, _status, _conf_file;
+    JobQueue _jobs;
+    JobLogBox *_joblog;
+    RepoLoader _loader;
+    std::string _filter, _info, _status, _conf_file, _jobstatus;
+    std::string _loaded_status;
     unsigned int _category_idx, _activated_listbox;
+    unsigned int _shown_generation;   // Of build_changes, when lists updated
+    bool _browsing;    // Waiting for input in the category or SlackBuild list
 
     void printStatus(const std::string & msg, bool bold=false);
     void clearStatus();
@@ -59,8 +70,13 @@ class MainWindow: public CursesWidget {
 
     void clearData();
     int readLists(MouseEvent * mevent=NULL, bool interactive=true);
+    void showLoadWarnings(const std::vector<std::string> & pkg_errors,
+                          const std::vector<std::string> & missing_info,
+                          bool interactive, MouseEvent * mevent=NULL);
     void clearTags();
     void rebuild(MouseEvent * mevent=NULL);
+    void refilter(MouseEvent * mevent=NULL);
+    void updateCategoryTags(unsigned int generation);
     void resetDisplayedSlackBuilds();
 
     /* Asks for confirmation and quits */
@@ -78,6 +94,7 @@ class MainWindow: public CursesWidget {
     void filterBuildOptions();
     void filterSearch(const std::string & searchterm, bool case_sensitive=false,
                       bool whole_whord=false, bool search_readmes=false);
+    void printFilterStatus(unsigned int nfiltered);
 
     /* Displays options window */
 
@@ -94,10 +111,11 @@ class MainWindow: public CursesWidget {
     /* Actions for a selected SlackBuild */
 
     void browseFiles(const BuildListItem & build, MouseEvent * mevent=NULL);
-    bool modifyPackage(BuildListItem & build, const std::string & action,
-                       int & ninstalled, int & nupgraded, int & nreinstalled,
-                       int & nremoved, bool & cancel_all, bool batch=false,
-                       MouseEvent * mevent=NULL);
+    bool modifyPackage(const std::vector<BuildListItem *> & builds,
+                       const std::string & action, int & ninstalled,
+                       int & nupgraded, int & nreinstalled, int & nremoved,
+                       bool batch=false, MouseEvent * mevent=NULL);
+    std::string predictedTimeText(const InstallBox & installer) const;
     void setBuildOptions(BuildListItem & build, MouseEvent * mevent=NULL);
     void showBuildOrder(BuildListItem & build,
                         const std::string & mode="forward",
@@ -112,24 +130,44 @@ class MainWindow: public CursesWidget {
 
     void applyTags(const std::string & action, MouseEvent * mevent=NULL);
 
+    /* Background jobs */
+
+    bool pollJobs();
+    void showJobs(MouseEvent * mevent=NULL);
+
+    /* Background loading of installed packages at startup. Anything that
+       needs to know what is installed calls waitForLoading first. */
+
+    bool pollLoading();
+    void finishLoading(MouseEvent * mevent=NULL);
+    void waitForLoading(MouseEvent * mevent=NULL);
+
+    /* Shows all SlackBuilds in a single sortable table */
+
+    void showBuildTable(MouseEvent * mevent=NULL);
+
+    /* Resume changes left unfinished by an interrupted batch */
+
+    void resumeJournal(MouseEvent * mevent=NULL);
+
     /* View command line output */
  
     void viewCommandLine() const;
 
     /* Displays an error message */
 
-    std::string displayError(const std::string & msg, bool centered,
-                             const std::string & name,
-                             const std::string & buttonnames,
-                             MouseEvent * mevent=NULL);
-    std::string displayMessage(const std::string & msg, bool centered,
-                               const std::string & name,
-                               const std::string & buttonnames,
-                               MouseEvent * mevent=NULL);
+    Signal displayError(const std::string & msg, bool centered,
+                        const std::string & name,
+                        const std::string & buttonnames,
+                        MouseEvent * mevent=NULL);
+    Signal displayMessage(const std::string & msg, bool centered,
+                          const std::string & name,
+                          const std::string & buttonnames,
+                          MouseEvent * mevent=NULL);
 
     /* Prints package version information as status */
 
-    void printPackageVersion(const BuildListItem & build);
+    void printPackageVersion(BuildListItem & build);
 
     /* Shows 'About' dialog */
 
@@ -193,7 +231,7 @@ class MainWindow: public CursesWidget {
 
     /* Mouse interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* Redraws the main window */
 
@@ -201,5 +239,5 @@ class MainWindow: public CursesWidget {
 
     /* Shows the main window */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 };
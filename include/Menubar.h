@@ -38,7 +38,7 @@ class Menubar: public CursesWidget {
     void redrawChangedItems();
     void redrawAllItems();
 
-    std::string execList(MouseEvent * mevent=NULL);
+    Signal execList(MouseEvent * mevent=NULL);
 
   public:
 
@@ -73,7 +73,7 @@ class Menubar: public CursesWidget {
 
     /* Handles mouse event */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* Draws frame, items, etc. as needed */
 
@@ -81,5 +81,5 @@ class Menubar: public CursesWidget {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
@@ -41,7 +41,7 @@ class MessageBox: public CursesWidget {
 
     /* Mouse interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* Draws frame and message */
 
@@ -49,5 +49,5 @@ class MessageBox: public CursesWidget {
 
     /* User interaction loop */
 
-    std::string exec(MouseEvent * mevent=NULL);
+    Signal exec(MouseEvent * mevent=NULL);
 };
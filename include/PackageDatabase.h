@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*******************************************************************************
+
+List of installed packages, read from the package database directory. All
+package names are kept in one buffer, and each is split into name, version,
+arch, and build as it is read, so that reading the list takes no allocations
+per package. Fields are returned as views into the buffer, which are valid
+until the next read.
+
+*******************************************************************************/
+class PackageDatabase {
+
+  private:
+
+    enum field { Name, Version, Arch, Build, nfields };
+
+    /* A package: position and length of its full name in the buffer, and of
+       each field (relative to the full name) if the name is valid */
+
+    struct entry {
+      unsigned int pos, len;
+      unsigned int field_pos[nfields], field_len[nfields];
+      bool valid;
+    };
+
+    std::string _names;
+    std::vector<entry> _packages;
+
+    std::string_view getField(unsigned int idx, field fld) const;
+
+  public:
+
+    /* Constructor */
+
+    PackageDatabase();
+
+    /* Reads the package database, or another directory of packages. Returns
+       1 if the directory can't be read or 0 on success. */
+
+    int read();
+    int read(const std::string & path);
+
+    /* Number of packages and whether a package name is well formed */
+
+    unsigned int size() const;
+    bool valid(unsigned int idx) const;
+
+    /* Full package name and its fields. Fields are empty if the package name
+       is not well formed. */
+
+    std::string_view package(unsigned int idx) const;
+    std::string_view name(unsigned int idx) const;
+    std::string_view version(unsigned int idx) const;
+    std::string_view arch(unsigned int idx) const;
+    std::string_view build(unsigned int idx) const;
+
+    /* Index of the first well-formed package with a name, or -1 if none */
+
+    int find(std::string_view name) const;
+};
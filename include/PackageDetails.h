@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include "BuildListItem.h"
+
+/*******************************************************************************
+
+Extended package info that takes time to gather: description, homepage,
+sources, dependency counts, and disk usage of the installed package. Fields
+are computed on a worker thread and filled in one at a time, so that they can
+be shown as they arrive. The worker only gets a small snapshot of each
+SlackBuild (name, category, whether installed, and requirements if already
+read), so the user interface can keep changing them in the meantime. Repo info
+the worker has to read itself is handed back by apply(), so it is only read
+once.
+
+*******************************************************************************/
+class PackageDetails {
+
+  public:
+
+    enum field { Description, Homepage, Sources, Dependencies, Dependents,
+                 DiskUsage, nfields };
+
+  private:
+
+    /* What the worker knows about each SlackBuild */
+
+    struct build_entry {
+      unsigned int category, build;     // Position in the SlackBuild lists
+      unsigned int name_id, category_id;
+      bool installed, reqs_read;
+      std::vector<unsigned int> reqs;   // Interned names, once read
+    };
+
+    /* Repo info read by the worker, to be copied back into the lists */
+
+    struct repo_info {
+      unsigned int category, build, name_id;
+      int check;
+      std::string available_version, reqs, available_buildnum;
+    };
+
+    BuildListItem _build;
+    std::vector<build_entry> _entries;
+    std::unordered_map<unsigned int, unsigned int> _index;   // By name ID
+    std::vector<repo_info> _read;
+    std::vector<std::string> _values;   // Empty until computed
+    std::thread _worker;
+    mutable std::mutex _mutex;
+    std::atomic<bool> _running, _stop;
+    std::atomic<unsigned int> _generation;
+
+    void set(field fld, const std::string & value);
+
+    /* Gets requirements of a SlackBuild, reading them if needed. Returns
+       false if it is not in the lists. */
+
+    bool requirements(unsigned int name_id, std::vector<unsigned int> & reqs);
+
+    /* Computing fields */
+
+    std::string readDescription() const;
+    std::string readHomepage() const;
+    std::string readSources() const;
+    std::string countDependencies();
+    std::string countDependents();
+    std::string readDiskUsage() const;
+
+    void run();
+
+  public:
+
+    /* Constructor and destructor */
+
+    PackageDetails();
+    ~PackageDetails();
+
+    /* Starts computing fields for a SlackBuild */
+
+    void start(const BuildListItem & build,
+               const std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    /* Copies repo info read by the worker so far into the lists, for
+       SlackBuilds that haven't had it read since */
+
+    void apply(std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    /* Stops the worker as soon as possible */
+
+    void stop();
+
+    /* Get attributes. generation() changes each time a field is filled in.
+       text() gives one line per field, with ... for fields not computed
+       yet. */
+
+    bool busy() const;
+    unsigned int generation() const;
+    std::string text() const;
+};
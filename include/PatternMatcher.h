@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_set>
+#include <regex>
+
+/*******************************************************************************
+
+Trie of strings that can tell whether any of them is a prefix of a given
+string, in time proportional to the length of the given string
+
+*******************************************************************************/
+class PrefixTrie {
+
+  private:
+
+    struct node {
+      std::map<char, unsigned int> children;
+      bool terminal;
+    };
+
+    std::vector<node> _nodes;
+
+  public:
+
+    /* Constructor */
+
+    PrefixTrie();
+
+    /* Adds a string or removes all of them */
+
+    void insert(const std::string & prefix);
+    void clear();
+
+    /* Checks whether any string in the trie is a prefix of str */
+
+    bool hasPrefixOf(const std::string & str) const;
+    bool empty() const;
+};
+
+/*******************************************************************************
+
+Set of regular expressions that checks whether a string fully matches any of
+them (like std::regex_match), without running every one in turn. Patterns are
+sorted by form when added: literals go into a hash set, literal prefixes (e.g.
+foo.*) and suffixes (.*foo) into tries, and literal substrings (.*foo.*) into a
+list. Only the remaining, true regular expressions are matched with
+std::regex, all combined into a single alternation. compile() must be called
+after adding patterns.
+
+*******************************************************************************/
+class PatternMatcher {
+
+  private:
+
+    std::unordered_set<std::string> _literals;
+    PrefixTrie _prefixes, _suffixes;
+    std::vector<std::string> _substrings;
+    std::vector<std::string> _regex_sources;
+    std::vector<std::regex> _backref_regexes;   // Can't be combined
+    std::regex _combined;
+    bool _have_combined;
+
+  public:
+
+    /* Constructor */
+
+    PatternMatcher();
+
+    /* Adds a pattern. Throws std::regex_error if it is not a valid regular
+       expression, like std::regex would. */
+
+    void add(const std::string & pattern);
+
+    /* Builds the combined regular expression from those added */
+
+    void compile();
+
+    /* Checks whether str fully matches any pattern */
+
+    bool match(const std::string & str) const;
+};
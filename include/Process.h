@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <sys/types.h>
+#include <sys/resource.h>  // rusage
+
+/*******************************************************************************
+
+A command split into environment assignments and an argument vector, ready to
+be executed without a shell
+
+*******************************************************************************/
+struct command_line {
+  std::vector<std::string> env;   // VAR=value, added to sboui's environment
+  std::vector<std::string> argv;  // Program (searched in PATH) and arguments
+};
+
+/*******************************************************************************
+
+Resources used by a finished process
+
+*******************************************************************************/
+struct process_usage {
+  pid_t pid;
+  int status;               // Exit status, or -1 if killed by a signal
+  double wall_seconds;      // Time from start to exit
+  double user_seconds;      // CPU time of the process and its children
+  double system_seconds;
+  long max_rss;             // Largest resident set size in kilobytes
+};
+
+/*******************************************************************************
+
+Runs a command in a child process, either attached to the terminal or with
+stdout and stderr captured through a pipe without blocking the caller
+
+*******************************************************************************/
+class Process {
+
+  private:
+
+    pid_t _pid;
+    int _outfd;
+    bool _running, _capture;
+    std::chrono::steady_clock::time_point _start;
+    process_usage _usage;
+
+    void reap(int status, const struct rusage & ru);
+
+  public:
+
+    /* Constructor and destructor */
+
+    Process();
+    ~Process();
+
+    /* Starts command. If capture is true, output is read with readOutput and
+       stdin is /dev/null; otherwise the command uses the terminal. Returns 0
+       on success or 1 if it could not be started. */
+
+    int start(const command_line & cmd, bool capture=true);
+
+    /* Appends any output available now to out. Does not block. Returns the
+       number of bytes read. */
+
+    int readOutput(std::string & out);
+
+    /* Checks whether the process is still running, without blocking */
+
+    bool running();
+
+    /* Waits for the process to exit and returns its exit status */
+
+    int wait();
+
+    /* Exit status (-1 if killed by signal) and resources used once the process
+       has finished */
+
+    int exitStatus() const;
+    const process_usage & usage() const;
+    pid_t pid() const;
+
+    /* Terminates the process and anything it started */
+
+    void terminate();
+};
+
+/* Splits a command string into leading VAR=value assignments and arguments.
+   Commands using shell features are run through /bin/sh -c instead. */
+
+int parse_command(const std::string & cmd, command_line & cl);
+
+/* Parses a string of VAR=value assignments and appends them to env */
+
+int parse_assignments(const std::string & str, std::vector<std::string> & env);
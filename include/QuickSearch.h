@@ -16,5 +16,5 @@ class QuickSearch: public TextInput {
 
     /* User interaction */
 
-    virtual std::string exec(int y_offset, MouseEvent * mevent=NULL);
+    virtual Signal exec(int y_offset, MouseEvent * mevent=NULL);
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "BuildListItem.h"
+#include "backend.h"   // build_location
+
+/*******************************************************************************
+
+Determines which SlackBuilds are installed and reads saved build options on a
+worker thread, so that the lists can be shown and browsed in the meantime. The
+worker only gets the location of each SlackBuild by name ID and publishes
+results for each one as it goes, so it never touches the SlackBuilds
+themselves. apply() merges published results into the displayed SlackBuilds
+and must be called from the user interface thread (e.g. from an idle hook).
+
+*******************************************************************************/
+class RepoLoader {
+
+  private:
+
+    /* Results for a SlackBuild, and its location in the list */
+
+    struct loaded_build {
+      build_location loc;
+      unsigned int name_id;
+      bool installed, blacklisted;
+      std::string installed_version, pkgbuild, package_name, build_options;
+    };
+
+    std::vector<build_location> _locations;  // Indexed by name ID
+    std::vector<loaded_build> _published;
+    std::vector<std::string> _pkg_errors;
+    std::thread _worker;
+    std::mutex _mutex;
+    std::atomic<bool> _running, _stop;
+    bool _active, _read_buildopts;
+
+    bool locate(unsigned int name_id, build_location & loc) const;
+    void publish(std::vector<loaded_build> & results);
+    void readInstalled();
+    void readBuildOpts();
+    void run();
+
+  public:
+
+    /* Constructor and destructor */
+
+    RepoLoader();
+    ~RepoLoader();
+
+    /* Starts the worker for slackbuilds. Build options are also read if
+       read_buildopts is true. */
+
+    void start(const std::vector<std::vector<BuildListItem> > & slackbuilds,
+               bool read_buildopts);
+
+    /* Merges results published since the last call into slackbuilds, which
+       must be the list passed to start. Returns the number of SlackBuilds
+       updated. */
+
+    unsigned int apply(std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    /* Waits for the worker to finish */
+
+    void wait();
+
+    /* Waits for the worker to finish, gets invalid package names, and
+       becomes inactive. Results not yet applied are dropped, so apply should
+       be called first. */
+
+    void finish(std::vector<std::string> & pkg_errors);
+
+    /* Stops the worker as soon as possible and discards results */
+
+    void stop();
+
+    /* Get attributes. active() is true from start until finish or stop;
+       busy() is true while the worker is running. */
+
+    bool active() const;
+    bool busy() const;
+};
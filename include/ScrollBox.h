@@ -38,9 +38,9 @@ class ScrollBox: public AbstractListBox {
 
     /* Mouse interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent);
+    Signal handleMouseEvent(MouseEvent * mevent);
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
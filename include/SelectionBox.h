@@ -36,5 +36,5 @@ class SelectionBox: public ListBox {
 
     /* User interaction loop */
 
-    virtual std::string exec(MouseEvent * mevent=NULL);
+    virtual Signal exec(MouseEvent * mevent=NULL);
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+
+Small binary cache of values worked out from other files, so that they don't
+have to be parsed again next time. Along with the values, the snapshot records
+the modification time and size of each file (or directory) they depend on, and
+it is only loaded if none of those have changed and the key it was saved with
+matches. Values are read back in the order they were put in.
+
+*******************************************************************************/
+class Snapshot {
+
+  private:
+
+    /* State of a file the values depend on */
+
+    struct stamp {
+      std::string path;
+      long long mtime_sec, mtime_nsec, size;
+      bool exists;
+    };
+
+    std::string _path;
+    std::vector<stamp> _deps;
+    std::string _data;
+    std::string::size_type _pos;   // Read position in _data
+
+    static void stampFile(const std::string & path, stamp & st);
+
+    /* Encode or decode values in the binary format */
+
+    static void encodeInt(std::string & buffer, long long val);
+    static void encodeString(std::string & buffer, const std::string & str);
+    bool decodeInt(const std::string & buffer, std::string::size_type & pos,
+                   long long & val) const;
+    bool decodeString(const std::string & buffer,
+                      std::string::size_type & pos, std::string & str) const;
+
+  public:
+
+    /* Constructor */
+
+    Snapshot();
+
+    /* Set location of snapshot file */
+
+    void setPath(const std::string & path);
+
+    /* Discards all values and dependencies */
+
+    void clear();
+
+    /* Records the current state of a file the values depend on */
+
+    void addDependency(const std::string & path);
+
+    /* Adds values */
+
+    void putString(const std::string & str);
+    void putBool(bool val);
+
+    /* Writes snapshot. Returns 0 on success or 1 on failure. */
+
+    int save(const std::string & key) const;
+
+    /* Reads snapshot. Returns 0 if it was read and is still valid, or 1 if
+       not, in which case it should be discarded. */
+
+    int load(const std::string & key);
+
+    /* Reads the next value. Returns false if there are no more. */
+
+    bool getString(std::string & str);
+    bool getBool(bool & val);
+};
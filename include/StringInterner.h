@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+/*******************************************************************************
+
+Gives each distinct string a small integer ID, so that strings stored or
+compared many times (like SlackBuild names in requirement lists) can be kept
+and compared as IDs. IDs are never reused, and the strings they stand for stay
+in place for the life of the interner. May be used from several threads.
+
+*******************************************************************************/
+class StringInterner {
+
+  private:
+
+    std::deque<std::string> _strings;   // Elements never move
+    std::unordered_map<std::string_view, unsigned int> _ids;
+    mutable std::mutex _mutex;
+
+    unsigned int internLocked(std::string_view str);
+
+  public:
+
+    /* Returned by find for strings that have no ID */
+
+    static const unsigned int none;
+
+    /* Gets the ID of a string, giving it one if needed */
+
+    unsigned int intern(std::string_view str);
+
+    /* Interns each word of a space-separated list, e.g. a REQUIRES line */
+
+    void internList(std::string_view list, std::vector<unsigned int> & ids);
+
+    /* Gets the ID of a string, or none if it doesn't have one */
+
+    unsigned int find(std::string_view str) const;
+
+    /* Gets the string for an ID */
+
+    const std::string & str(unsigned int id) const;
+};
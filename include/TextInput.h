@@ -40,9 +40,9 @@ class TextInput: public InputItem {
 
     /* User interaction */
 
-    std::string handleMouseEvent(MouseEvent * mevent, int y_offset);
+    Signal handleMouseEvent(MouseEvent * mevent, int y_offset);
     void draw(int y_offset, bool force=false, bool highlight=false);
-    virtual std::string exec(int y_offset, MouseEvent * mevent=NULL);
+    virtual Signal exec(int y_offset, MouseEvent * mevent=NULL);
 
     /* Accessing properties */
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+
+Version string parsed once into a key for comparisons: runs of digits and of
+letters, and whether it ends in a kernel tag like _5.15.19 (appended by
+SlackBuilds of kernel modules). Keys can tell whether two versions differ only
+by kernel tag, and which of two versions is newer.
+
+*******************************************************************************/
+class VersionKey {
+
+  private:
+
+    /* A run of digits or letters in the version string */
+
+    struct segment {
+      unsigned int pos, len;
+      bool numeric;
+    };
+
+    std::string _version;
+    std::vector<segment> _segments;   // Not including kernel tag
+    bool _kernel_tagged;
+
+    void parse();
+    int compareSegments(const VersionKey & other, unsigned int a,
+                        unsigned int b) const;
+    bool preRelease(unsigned int a) const;
+
+  public:
+
+    /* Constructors */
+
+    VersionKey();
+    VersionKey(const std::string & version);
+
+    /* Sets version string. Only parses it if it has changed. */
+
+    void set(const std::string & version);
+
+    /* Get attributes */
+
+    const std::string & str() const;
+    bool kernelTagged() const;
+
+    /* Checks whether this (installed) version is the other (available) one
+       with a kernel tag appended */
+
+    bool differsByKernel(const VersionKey & other) const;
+
+    /* Compares to another version, ignoring kernel tags. Returns a negative
+       number if this one is older, positive if newer, or 0 if neither. */
+
+    int compare(const VersionKey & other) const;
+};
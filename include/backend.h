@@ -1,28 +1,67 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cmath>   // floor
 #include "BuildListItem.h"
 #include "Blacklist.h"
+#include "Journal.h"
+#include "BuildHistory.h"
+#include "BuildOptionsStore.h"
+#include "Process.h"
+#include "PackageDatabase.h"
+#include "StringInterner.h"
+#include "BuildChanges.h"
+
+/* Position of a SlackBuild in the list of categories */
+
+struct build_location {
+  int category, build;
+};
 
 extern Blacklist blacklist;
+extern Journal journal;
+extern BuildHistory build_history;
+extern BuildOptionsStore buildopts_store;
+
+/* IDs for SlackBuild and category names, so that requirement lists can be
+   stored and compared as numbers */
+
+extern StringInterner interned_names;
+
+/* Incremented when the repo is synced. Repo info read for a SlackBuild is kept
+   until this changes. */
+
+extern unsigned int repo_generation;
+
+/* SlackBuilds whose state has changed since the lists were last updated */
+
+extern BuildChanges build_changes;
 
 int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds);
 int read_buildopts(std::vector<std::vector<BuildListItem> > & slackbuilds);
 int find_slackbuild(const std::string & name,
                     std::vector<std::vector<BuildListItem> > & slackbuilds,
                     int & idx0, int & idx1);
+int split_pkg_name(std::string_view pkg, std::string_view & name,
+                   std::string_view & version, std::string_view & arch,
+                   std::string_view & build);
 int get_pkg_info(const std::string & pkg, std::string & name,
                  std::string & version, std::string & arch,
                  std::string & build);
 bool check_installed(const BuildListItem & build, 
-                     const std::vector<std::string> & installedpkgs,
+                     const PackageDatabase & packages,
                      std::string & pkg, std::string & version,
                      std::string & arch, std::string & pkgbuild);
 int get_reqs(const BuildListItem & build, std::string & reqs);
 int get_repo_info(const BuildListItem & build, std::string & available_version,
                   std::string & reqs, std::string & available_buildnum);
+void mark_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
+                    std::vector<std::string> & pkg_errors,
+                    std::vector<build_location> & installed);
+void ensure_repo_props(const std::vector<BuildListItem *> & builds,
+                       std::vector<std::string> & missing_info);
 void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
                          std::vector<std::string> & pkg_errors,
                          std::vector<std::string> & missing_info);
@@ -30,6 +69,11 @@ std::vector<BuildListItem *> list_installed(
                         std::vector<std::vector<BuildListItem> > & slackbuilds);
 std::vector<BuildListItem *> list_nondeps(
                         std::vector<std::vector<BuildListItem> > & slackbuilds);
+int run_command(const command_line & cmd, process_usage & usage);
+int run_command(const std::string & cmd);
+int action_command(const BuildListItem & build, const std::string & action,
+                   command_line & cmd);
+int check_action(BuildListItem & build, const std::string & action);
 int install_slackbuild(BuildListItem & build);
 int upgrade_slackbuild(BuildListItem & build); 
 int reinstall_slackbuild(BuildListItem & build); 
@@ -54,7 +98,8 @@ T * ptr(T * obj) { return obj; }
 
 /*******************************************************************************
 
-Finds an item by name in a sorted list. If whole_word is set to false, it
+Finds an item by name in a sorted list (a vector of items or item pointers, or
+anything else indexed the same way). If whole_word is set to false, it
 will only search the first N characters of items in the list, where N is the
 length of the input name. Returns 0 if found, 1 if not found.
 
@@ -62,8 +107,8 @@ Note: the implementation is placed in the header file to avoid the need for
 explicit instantiation of the template.
 
 *******************************************************************************/
-template<typename T>
-int find_name_in_list(const std::string & name, std::vector<T> & list,
+template<typename List>
+int find_name_in_list(const std::string & name, List & list,
                       int & idx, int & lbound, int & rbound,
                       bool whole_word=true)
 {
@@ -21,6 +21,20 @@ void filter_by_func(std::vector<std::vector<BuildListItem *> > & slackbuilds,
                     WINDOW *blistboxwin, CategoryListBox & clistbox,
                     std::vector<BuildListBox> & blistboxes,
                     unsigned int & nfiltered, bool overwrite=true);
+void update_category_tags(const std::vector<BuildListItem *> & builds,
+                          CategoryListBox & clistbox,
+                          std::vector<BuildListBox> & blistboxes);
+void patch_filter(const std::vector<BuildListItem *> & changed,
+                  std::vector<std::vector<BuildListItem *> > & slackbuilds,
+                  bool (*func)(const BuildListItem &),
+                  std::vector<CategoryListItem *> & categories,
+                  WINDOW *blistboxwin, CategoryListBox & clistbox,
+                  std::vector<BuildListBox> & blistboxes,
+                  unsigned int & nfiltered, bool overwrite=true);
+void list_all(std::vector<std::vector<BuildListItem> > & slackbuilds,
+              std::vector<CategoryListItem *> & categories,
+              WINDOW *blistboxwin, CategoryListBox & clistbox,
+              std::vector<BuildListBox> & blistboxes, unsigned int & nbuilds);
 void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
                     std::vector<std::vector<BuildListItem *> > & slackbuilds,
                     std::vector<CategoryListItem *> & categories,
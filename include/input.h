@@ -0,0 +1,24 @@
+#pragma once
+
+#include <functional>
+
+/* Reads a key from the terminal like getch(). While waiting, idle hooks are
+   run periodically so that background work (e.g. package operations) can
+   make progress and update the screen. */
+
+int read_key();
+
+/* Removes further presses of key already waiting in the input queue, without
+   blocking, and returns how many there were. The first different key is left
+   in the queue. Used to act on a held-down key once per screen update instead
+   of once per repeat. */
+
+int drain_repeats(int key);
+
+/* Registers a function to be called while waiting for input. It should return
+   true if it has work in progress and wants to be called again soon, or false
+   if it can wait until the next key press. Returns an id that can be used to
+   remove the hook, e.g. when the dialog it updates is closed. */
+
+unsigned int add_idle_hook(const std::function<bool()> & hook);
+void remove_idle_hook(unsigned int id);
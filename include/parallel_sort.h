@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>   // stable_sort, inplace_merge, min
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*******************************************************************************
+
+Stable sort that splits the list into one chunk per thread, sorts the chunks
+at the same time, and then merges neighboring chunks pairwise until one is
+left. Equal elements keep their order, because each chunk is sorted stably and
+a merge takes from the left chunk first. Falls back to std::stable_sort for
+short lists or when built without OpenMP.
+
+Note: the implementation is placed in the header file to avoid the need for
+explicit instantiation of the template.
+
+*******************************************************************************/
+template<typename T, typename Compare>
+void parallel_stable_sort(std::vector<T> & list, Compare comp)
+{
+  int i, nchunks, width, mid, end;
+  std::vector<unsigned int> bounds;
+  const unsigned int min_chunk = 1024;
+
+  nchunks = 1;
+#ifdef _OPENMP
+  nchunks = omp_get_max_threads();
+#endif
+  if (list.size()/min_chunk < (unsigned int)(nchunks))
+    nchunks = list.size()/min_chunk;
+  if (nchunks < 2)
+  {
+    std::stable_sort(list.begin(), list.end(), comp);
+    return;
+  }
+
+  bounds.resize(nchunks+1);
+  for ( i = 0; i <= nchunks; i++ )
+  {
+    bounds[i] = (unsigned long long)(list.size())*i/nchunks;
+  }
+
+  #pragma omp parallel for
+  for ( i = 0; i < nchunks; i++ )
+  {
+    std::stable_sort(list.begin()+bounds[i], list.begin()+bounds[i+1], comp);
+  }
+
+  for ( width = 1; width < nchunks; width *= 2 )
+  {
+    #pragma omp parallel for private(mid, end)
+    for ( i = 0; i < nchunks; i += 2*width )
+    {
+      mid = std::min(i+width, nchunks);
+      end = std::min(i+2*width, nchunks);
+      if (mid < end)
+        std::inplace_merge(list.begin()+bounds[i], list.begin()+bounds[mid],
+                           list.begin()+bounds[end], comp);
+    }
+  }
+}
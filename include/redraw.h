@@ -0,0 +1,19 @@
+#pragma once
+
+/*******************************************************************************
+
+Parts of a widget that need to be redrawn, as a bitmask. all includes every
+part, so it can be tested for with any of the others.
+
+*******************************************************************************/
+namespace redraw
+{
+  const unsigned int none = 0;
+  const unsigned int changed = 1 << 0;  // Items whose highlight changed
+  const unsigned int items = 1 << 1;    // All visible items
+  const unsigned int buttons = 1 << 2;
+  const unsigned int entry = 1 << 3;    // Entry area of an input item
+  const unsigned int label = 1 << 4;
+  const unsigned int box = 1 << 5;
+  const unsigned int all = changed | items | buttons | entry | label | box;
+}
@@ -6,6 +6,9 @@
 int compute_reqs_order(const BuildListItem & build,
                        std::vector<BuildListItem *> & reqlist,
                        std::vector<std::vector<BuildListItem> > & slackbuilds);
+int compute_reqs_order(const std::vector<BuildListItem *> & builds,
+                       std::vector<BuildListItem *> & reqlist,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds);
 void compute_inv_reqs(const BuildListItem & build,
                       std::vector<BuildListItem *> & invreqlist,
                       std::vector<std::vector<BuildListItem> > & slackbuilds);
@@ -21,6 +21,7 @@ namespace settings
   extern std::string layout;
   extern bool resolve_deps, confirm_changes, enable_color, rebuild_inv_deps;
   extern bool save_buildopts, warn_invalid_pkgnames, cumulative_filters;
+  extern bool background_jobs;
 }
 
 extern Color colors;
@@ -29,6 +30,7 @@ extern std::vector<ColorTheme> color_themes;
 int read_config(const std::string & conf_file="");
 int write_config(const std::string & conf_file="");
 int setup_color();
+void get_color_themes();
 int apply_color_theme(const std::string & theme);
 int activate_color(const std::string & theme);
 void deactivate_color();
@@ -1,26 +1,68 @@
 #pragma once
 
-#include <string>
+/*******************************************************************************
+
+Event returned by widgets' exec and handleMouseEvent methods: an event type
+and, for plain keypresses, the key
+
+*******************************************************************************/
+class Signal {
+
+  public:
+
+    enum event {
+      None, Key, Resize, Quit, Highlight, HighlightFirst, HighlightLast,
+      HighlightPrev, HighlightNext, HighlightPrevPage, HighlightNextPage,
+      KeyTab, KeyEnter, Scroll, KeyRight, KeyLeft, KeySpace, Mouse,
+      NullEvent, Tag, KeyF9, Ignore
+    };
+
+  private:
+
+    event _type;
+    int _key;
+
+  public:
+
+    /* Constructors. A character or one-character string is a keypress; an
+       empty string is no event. */
+
+    Signal();
+    Signal(event type);
+    Signal(char key);
+    Signal(const char *key);
+
+    /* Get attributes */
+
+    event type() const;
+    int key() const;
+
+    /* Comparison */
+
+    bool operator == (const Signal & other) const;
+    bool operator != (const Signal & other) const;
+};
 
 namespace signals 
 {
-  extern std::string resize;
-  extern std::string quit;
-  extern std::string highlight;
-  extern std::string highlightFirst;
-  extern std::string highlightLast;
-  extern std::string highlightPrev;
-  extern std::string highlightNext;
-  extern std::string highlightPrevPage;
-  extern std::string highlightNextPage;
-  extern std::string keyTab;
-  extern std::string keyEnter;
-  extern std::string scroll;
-  extern std::string keyRight;
-  extern std::string keyLeft;
-  extern std::string keySpace;
-  extern std::string mouseEvent;
-  extern std::string nullEvent;
-  extern std::string tag;
-  extern std::string keyF9;
+  extern const Signal resize;
+  extern const Signal quit;
+  extern const Signal highlight;
+  extern const Signal highlightFirst;
+  extern const Signal highlightLast;
+  extern const Signal highlightPrev;
+  extern const Signal highlightNext;
+  extern const Signal highlightPrevPage;
+  extern const Signal highlightNextPage;
+  extern const Signal keyTab;
+  extern const Signal keyEnter;
+  extern const Signal scroll;
+  extern const Signal keyRight;
+  extern const Signal keyLeft;
+  extern const Signal keySpace;
+  extern const Signal mouseEvent;
+  extern const Signal nullEvent;
+  extern const Signal tag;
+  extern const Signal keyF9;
+  extern const Signal ignore;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 extern std::string int_to_string(int inval);
@@ -18,3 +19,39 @@ extern std::vector<std::string> wrap_words(const std::string & instr,
 extern bool find_in_file(const std::string & pattern,
                          const std::string & filename, bool whole_word=false,
                          bool case_sensitive=false);
+extern std::string duration_to_string(double seconds);
+extern std::string size_to_string(long long size);
+
+/* Variants that don't allocate. Returned views point into the input and are
+   only valid as long as it is. */
+
+extern std::string_view trim_view(std::string_view instr);
+extern std::string_view remove_leading_whitespace_view(std::string_view instr);
+extern std::string_view remove_comment_view(std::string_view instr,
+                                            char comment='#');
+extern void to_lower_inplace(std::string & str);
+
+/*******************************************************************************
+
+Steps through the fields of a string separated by a delimiter, giving the same
+fields as split but as views into the string rather than copies
+
+*******************************************************************************/
+class Tokenizer {
+
+  private:
+
+    std::string_view _str;
+    std::string_view::size_type _pos;
+    char _delim;
+
+  public:
+
+    /* Constructor */
+
+    Tokenizer(std::string_view instr, char delim=' ');
+
+    /* Gets the next field. Returns false when there are no more. */
+
+    bool next(std::string_view & token);
+};
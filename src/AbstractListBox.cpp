@@ -1,9 +1,11 @@
 #include <string>
 #include <curses.h>
 #include <cmath>     // floor, ceil
+#include <memory>    // shared_ptr
 #include "settings.h"
 #include "Color.h"
 #include "ListItem.h"
+#include "ListSource.h"
 #include "AbstractListBox.h"
 
 /*******************************************************************************
@@ -25,7 +27,7 @@ void AbstractListBox::redrawFrame()
   left = std::floor(mid - double(namelen)/2.0);
   wmove(_win, 1, 1);
   wclrtoeol(_win);
-  color_pair = colors.getPair("fg_title", "bg_title");
+  color_pair = colors.getPair(color::fg_title, color::bg_title);
   if (colors.turnOn(_win, color_pair) != 0)
     wattron(_win, A_BOLD);
   printSpaces(left-1);
@@ -94,15 +96,15 @@ void AbstractListBox::redrawAllItems()
   getmaxyx(_win, rows, cols);
   rowsavail = rows-_reserved_rows;
 
-  if (_items.size() == 0)
+  if (numItems() == 0)
   {
-    wrefresh(_win);
+    wnoutrefresh(_win);
     return;
   }
   for ( i = _firstprint; i < _firstprint+rowsavail; i++ )
   {
     redrawSingleItem(i);
-    if (i == int(_items.size())-1) { break; }
+    if (i == int(numItems())-1) { break; }
   }
 }
 
@@ -114,7 +116,7 @@ Constructors
 AbstractListBox::AbstractListBox()
 {
   _name = "";
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
   _items.resize(0);
   _firstprint = 0;
   _header_rows = 3;
@@ -125,7 +127,7 @@ AbstractListBox::AbstractListBox(WINDOW *win, const std::string & name)
 {
   _win = win;
   _name = name;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
   _items.resize(0);
   _firstprint = 0;
   _header_rows = 3;
@@ -137,19 +139,57 @@ AbstractListBox::AbstractListBox(WINDOW *win, const std::string & name)
 Edit list items
 
 *******************************************************************************/
-void AbstractListBox::addItem(ListItem *item) { _items.push_back(item); }
+void AbstractListBox::addItem(ListItem *item)
+{
+  detachSource();
+  _items.push_back(item);
+}
+
 void AbstractListBox::removeItem(unsigned int idx)
 {
-  if (idx <= _items.size()) { _items.erase(_items.begin()+idx); }
+  detachSource();
+  if (idx <= numItems()) { _items.erase(_items.begin()+idx); }
   _firstprint = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 void AbstractListBox::clearList()
 {
   _items.resize(0);
+  _source.reset();
   _firstprint = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
+}
+
+/*******************************************************************************
+
+Shows items from a source. Nothing is copied, so a very long list costs no more
+than the rows that are drawn.
+
+*******************************************************************************/
+void AbstractListBox::setSource(
+                            const std::shared_ptr<const ListSource> & source)
+{
+  _items.resize(0);
+  _source = source;
+  _firstprint = 0;
+  _redraw_type = redraw::all;
+}
+
+/*******************************************************************************
+
+Copies items from the source into _items, so they can be edited
+
+*******************************************************************************/
+void AbstractListBox::detachSource()
+{
+  unsigned int i, nitems;
+
+  if (! _source) { return; }
+  nitems = _source->size();
+  _items.resize(nitems);
+  for ( i = 0; i < nitems; i++ ) { _items[i] = _source->item(i); }
+  _source.reset();
 }
 
 /*******************************************************************************
@@ -165,7 +205,11 @@ Get attributes
 
 *******************************************************************************/
 const std::string & AbstractListBox::name() const { return _name; }
-unsigned int AbstractListBox::numItems() const { return _items.size(); }
+unsigned int AbstractListBox::numItems() const
+{
+  if (_source) { return _source->size(); }
+  else { return _items.size(); }
+}
 
 void AbstractListBox::minimumSize(int & height, int & width) const
 {
@@ -190,10 +234,10 @@ void AbstractListBox::minimumSize(int & height, int & width) const
     }
     if (namelen > width) { width = namelen; }
   }
-  nitems = _items.size();
+  nitems = numItems();
   for ( i = 0; i < nitems; i++ )
   {
-    namelen = _items[i]->name().size();
+    namelen = item(i)->name().size();
     if (namelen > width) { width = namelen; }
   }
   width += reserved_cols;
@@ -206,7 +250,7 @@ void AbstractListBox::preferredSize(int & height, int & width) const
 
   // Preferred height: no scrolling
 
-  nitems = _items.size();
+  nitems = numItems();
   height = _reserved_rows + nitems;
 
   // Preferred width: minimum usable + some padding
@@ -226,7 +270,7 @@ void AbstractListBox::preferredSize(int & height, int & width) const
   }
   for ( i = 0; i < nitems; i++ )
   {
-    namelen = _items[i]->name().size();
+    namelen = item(i)->name().size();
     if (namelen > width) { width = namelen; }
   }
   width += reserved_cols + widthpadding;
@@ -241,8 +285,14 @@ ListItem * AbstractListBox::itemByIdx(unsigned int idx)
 {
   unsigned int nitems;
 
-  nitems = _items.size();
+  nitems = numItems();
   if (idx >= nitems) { return NULL; }
+  else { return item(idx); }
+}
+
+ListItem * AbstractListBox::item(unsigned int idx) const
+{
+  if (_source) { return _source->item(idx); }
   else { return _items[idx]; }
 }
 
@@ -253,23 +303,22 @@ Draws list box (frame, items, etc.) as needed
 *******************************************************************************/
 void AbstractListBox::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
   // Draw list elements
 
-  if (_redraw_type == "all")
+  if (_redraw_type == redraw::all)
   { 
     clearWindow();
     colors.setBackground(_win, _fg_color, _bg_color);
   }
-  if (_redraw_type == "buttons") { redrawButtons(); }
-  else if (_redraw_type != "none")
+  if (_redraw_type == redraw::buttons) { redrawButtons(); }
+  else if (_redraw_type != redraw::none)
   {
     redrawFrame();
     redrawScrollIndicator();
   }
-  if ( (_redraw_type == "all") || (_redraw_type == "items")) { 
-                                                            redrawAllItems(); }
-  wrefresh(_win);
+  if (_redraw_type & redraw::items) { redrawAllItems(); }
+  wnoutrefresh(_win);
 }
 
@@ -1,96 +1,251 @@
 #include <string>
 #include <vector>
 #include <fstream>
-#include <regex>
+#include <sstream>
+#include <unordered_map>
+#include <mutex>
+#include <stdio.h>     // rename, snprintf
+#include "DirListing.h"
 #include "string_util.h"
 #include "backend.h"
+#include "PatternMatcher.h"
 #include "Blacklist.h"
 
 /*******************************************************************************
 
+Cache file header. The version is bumped if the format or the meaning of a
+verdict changes.
+
+*******************************************************************************/
+static const std::string cache_header = "sboui-blacklist-cache 1";
+
+/*******************************************************************************
+
+64-bit FNV-1a hash of a string, in hex
+
+*******************************************************************************/
+static std::string fnv1a_hex(const std::string & str)
+{
+  unsigned long long hash;
+  unsigned int i, len;
+  char buf[17];
+
+  hash = 14695981039346656037ULL;
+  len = str.size();
+  for ( i = 0; i < len; i++ )
+  {
+    hash ^= (unsigned char)str[i];
+    hash *= 1099511628211ULL;
+  }
+  snprintf(buf, sizeof(buf), "%016llx", hash);
+
+  return std::string(buf);
+}
+
+/*******************************************************************************
+
 Constructor
 
 *******************************************************************************/
-Blacklist::Blacklist() { _patterns.resize(0); }
+Blacklist::Blacklist()
+{
+  _empty = true;
+  _hash = "";
+  _cache_path = "/var/lib/sboui/blacklist-cache";
+  _dirty = false;
+}
+
+/*******************************************************************************
+
+Reads cached verdicts. Each line after the header holds a key and a verdict,
+0 or 1. Nothing is read if the cache was saved for a different blacklist.
+
+*******************************************************************************/
+void Blacklist::loadCache()
+{
+  std::ifstream file;
+  std::string line, key;
+  std::string::size_type pos;
+  verdict vdt;
+
+  _verdicts.clear();
+  _dirty = false;
+
+  file.open(_cache_path.c_str());
+  if (not file.is_open()) { return; }
+
+  if ( (! std::getline(file, line)) ||
+       (line != cache_header + " " + _hash) )
+  {
+    file.close();
+    return;
+  }
+
+  vdt.used = false;
+  while (std::getline(file, line))
+  {
+    pos = line.rfind(' ');
+    if ( (pos == std::string::npos) || (pos+2 != line.size()) ) { continue; }
+    if ( (line[pos+1] != '0') && (line[pos+1] != '1') ) { continue; }
+    key = line.substr(0, pos);
+    vdt.blacklisted = (line[pos+1] == '1');
+    _verdicts[key] = vdt;
+  }
+  file.close();
+}
+
+/*******************************************************************************
+
+Set location of cache file
+
+*******************************************************************************/
+void Blacklist::setCachePath(const std::string & path) { _cache_path = path; }
 
 /*******************************************************************************
 
-Reads and stores patterns from blacklist file
+Reads and stores patterns from blacklist file. Patterns are sorted by form
+as they are added, so that most checks don't need std::regex. The contents of
+the file are hashed to tell whether cached verdicts still apply.
 
 *******************************************************************************/
 int Blacklist::read(const std::string & filename)
 {
   std::ifstream file;
+  std::stringstream contents;
   std::string line;
 
   file.open(filename.c_str());
   if (not file.is_open()) { return 1; }
+  contents << file.rdbuf();
+  file.close();
 
-  while (! file.eof())
+  while (! contents.eof())
   {
-    std::getline(file, line); 
+    std::getline(contents, line); 
     line = remove_leading_whitespace(line);
     if (line[0] == '#') { continue; }
     line = remove_comment(line, '#');
     line = trim(line);
     if (line.size() > 0)
     {
-      std::regex reg(line);
-      _patterns.push_back(reg);
+      _patterns.add(line);
+      _empty = false;
     }
   }
 
+  _patterns.compile();
+  _hash = fnv1a_hex(contents.str());
+  if (! _empty) { loadCache(); }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Saves verdicts to the cache file if any were computed in this session, via a
+temporary file. Verdicts not looked up in this session belong to packages that
+are gone and are dropped. Returns 0 on success or if there was nothing to save,
+1 if the cache could not be written.
+
+*******************************************************************************/
+int Blacklist::save()
+{
+  DirListing listing;
+  std::ofstream file;
+  std::string tmppath;
+  std::string::size_type pos;
+  std::unordered_map<std::string, verdict>::const_iterator it;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (! _dirty) { return 0; }
+
+  pos = _cache_path.rfind('/');
+  if ( (pos != std::string::npos) && (pos > 0) )
+  {
+    if (listing.createFromPath(_cache_path.substr(0, pos)) != 0) { return 1; }
+  }
+
+  tmppath = _cache_path + ".tmp";
+  file.open(tmppath.c_str());
+  if (not file.is_open()) { return 1; }
+  file << cache_header << " " << _hash << "\n";
+  for ( it = _verdicts.begin(); it != _verdicts.end(); it++ )
+  {
+    if (! it->second.used) { continue; }
+    file << it->first << " " << (it->second.blacklisted ? "1" : "0") << "\n";
+  }
   file.close();
+  if (file.fail()) { return 1; }
+
+  if (rename(tmppath.c_str(), _cache_path.c_str()) != 0) { return 1; }
+  _dirty = false;
 
   return 0;
 }
 
 /*******************************************************************************
 
+Looks up a verdict, or computes and remembers it. May be called from several
+threads at once; matching itself is done without holding the lock.
+
+*******************************************************************************/
+bool Blacklist::cachedMatch(const std::string & key, const std::string & pkg,
+                          const std::string & name, const std::string & version,
+                          const std::string & arch, const std::string & build,
+                          bool by_name) const
+{
+  std::unordered_map<std::string, verdict>::iterator it;
+  verdict vdt;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    it = _verdicts.find(key);
+    if (it != _verdicts.end())
+    {
+      it->second.used = true;
+      return it->second.blacklisted;
+    }
+  }
+
+  if (by_name) { vdt.blacklisted = _patterns.match(name); }
+  else
+  {
+    vdt.blacklisted = ( _patterns.match(name) || _patterns.match(version) ||
+                        _patterns.match(arch) || _patterns.match(build) ||
+                        _patterns.match(pkg) );
+  }
+  vdt.used = true;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _verdicts[key] = vdt;
+  _dirty = true;
+
+  return vdt.blacklisted;
+}
+
+/*******************************************************************************
+
 Checks installed package for matches in name, version, arch, build, and fullname
 
 *******************************************************************************/
 bool Blacklist::blacklisted(const std::string & pkg) const
 {
   std::string name, version, arch, build;
-  unsigned int i, npatterns;
 
   get_pkg_info(pkg, name, version, arch, build);
 
-  // Check for blacklist pattern matching info in package name
-
-  npatterns = _patterns.size();
-  for ( i = 0; i < npatterns; i++ )
-  {
-    if (std::regex_match(name, _patterns[i])) { return true; }
-    if (std::regex_match(version, _patterns[i])) { return true; }
-    if (std::regex_match(arch, _patterns[i])) { return true; }
-    if (std::regex_match(build, _patterns[i])) { return true; }
-    if (std::regex_match(pkg, _patterns[i])) { return true; }
-  }
-
-  return false;
+  return blacklisted(pkg, name, version, arch, build);
 }
 
 bool Blacklist::blacklisted(const std::string & pkg, const std::string & name,
                           const std::string & version, const std::string & arch,
                           const std::string & build) const
 {
-  unsigned int i, npatterns;
-
   // Check for blacklist pattern matching info in package name
 
-  npatterns = _patterns.size();
-  for ( i = 0; i < npatterns; i++ )
-  {
-    if (std::regex_match(name, _patterns[i])) { return true; }
-    if (std::regex_match(version, _patterns[i])) { return true; }
-    if (std::regex_match(arch, _patterns[i])) { return true; }
-    if (std::regex_match(build, _patterns[i])) { return true; }
-    if (std::regex_match(pkg, _patterns[i])) { return true; }
-  }
+  if (_empty) { return false; }
 
-  return false;
+  return cachedMatch("p " + pkg, pkg, name, version, arch, build, false);
 }
 
 /*******************************************************************************
@@ -100,13 +255,7 @@ Checks for match by name only (used for not-installed SlackBuilds)
 *******************************************************************************/
 bool Blacklist::nameBlacklisted(const std::string & name) const
 {
-  unsigned int i, npatterns;
-
-  npatterns = _patterns.size();
-  for ( i = 0; i < npatterns; i++ )
-  {
-    if (std::regex_match(name, _patterns[i])) { return true; }
-  }
+  if (_empty) { return false; }
 
-  return false;
+  return cachedMatch("n " + name, "", name, "", "", "", true);
 }
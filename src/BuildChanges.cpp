@@ -0,0 +1,122 @@
+#include <vector>
+#include <mutex>
+#include <unordered_set>
+#include "BuildListItem.h"
+#include "BuildChanges.h"
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildChanges::BuildChanges()
+{
+  _generation = 0;
+  _held = 0;
+  _holding = false;
+}
+
+/*******************************************************************************
+
+Records a change to a SlackBuild
+
+*******************************************************************************/
+void BuildChanges::record(BuildListItem *build)
+{
+  change chg;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _generation++;
+  chg.generation = _generation;
+  chg.build = build;
+  _changes.push_back(chg);
+}
+
+/*******************************************************************************
+
+Generation of the latest change
+
+*******************************************************************************/
+unsigned int BuildChanges::generation() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _generation;
+}
+
+/*******************************************************************************
+
+Gets the SlackBuilds changed after a generation, in the order they first
+changed, each listed once
+
+*******************************************************************************/
+void BuildChanges::since(unsigned int generation,
+                         std::vector<BuildListItem *> & builds) const
+{
+  std::unordered_set<BuildListItem *> seen;
+  unsigned int i, nchanges;
+
+  builds.resize(0);
+  std::lock_guard<std::mutex> lock(_mutex);
+  nchanges = _changes.size();
+  for ( i = 0; i < nchanges; i++ )
+  {
+    if (_changes[i].generation <= generation) { continue; }
+    if (seen.insert(_changes[i].build).second)
+      builds.push_back(_changes[i].build);
+  }
+}
+
+/*******************************************************************************
+
+Forgets changes up to and including a generation, except those after a held
+generation
+
+*******************************************************************************/
+void BuildChanges::discard(unsigned int generation)
+{
+  unsigned int i, nchanges;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if ( _holding && (_held < generation) ) { generation = _held; }
+  nchanges = _changes.size();
+  for ( i = 0; i < nchanges; i++ )
+  {
+    if (_changes[i].generation > generation) { break; }
+  }
+  _changes.erase(_changes.begin(), _changes.begin()+i);
+}
+
+/*******************************************************************************
+
+Keeps changes after a generation from being discarded until released
+
+*******************************************************************************/
+void BuildChanges::hold(unsigned int generation)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _held = generation;
+  _holding = true;
+}
+
+/*******************************************************************************
+
+Lets held changes be discarded again
+
+*******************************************************************************/
+void BuildChanges::release()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _holding = false;
+}
+
+/*******************************************************************************
+
+Forgets all changes. The generation keeps counting up, so that readers never
+see an old generation number again.
+
+*******************************************************************************/
+void BuildChanges::clear()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _changes.resize(0);
+}
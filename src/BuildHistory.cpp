@@ -0,0 +1,315 @@
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <algorithm>   // max, nth_element
+#include <ctime>       // time
+#include <stdio.h>     // rename
+#include <sys/stat.h>  // stat
+#include "DirListing.h"
+#include "BuildListItem.h"
+#include "settings.h"
+#include "string_util.h"
+#include "backend.h"
+#include "BuildHistory.h"
+
+/* Assumed build time when there is no history at all to go on */
+
+static const double default_build_seconds = 60.0;
+
+/*******************************************************************************
+
+Returns total size in bytes of the regular files in a SlackBuild's directory in
+the local repository. This includes any source tarballs kept there by the
+package manager, so it serves as a rough measure of how much there is to build.
+
+*******************************************************************************/
+long long slackbuild_size(const BuildListItem & build)
+{
+  DirListing listing;
+  unsigned int i, nentries;
+  long long size;
+  struct stat st;
+
+  if (listing.setFromPath(settings::repo_dir + "/" + build.getProp("category")
+                          + "/" + build.name()) != 0) { return 0; }
+
+  size = 0;
+  nentries = listing.size();
+  for ( i = 0; i < nentries; i++ )
+  {
+    if (listing(i).type != "reg") { continue; }
+    if (stat(listing(i).path.c_str(), &st) == 0) { size += st.st_size; }
+  }
+
+  return size;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildHistory::BuildHistory()
+{
+  _path = "/var/lib/sboui/build-history";
+  _seconds_per_byte = 0.;
+  _median_seconds = default_build_seconds;
+  _loaded = false;
+}
+
+/*******************************************************************************
+
+Reads history file the first time it is needed. Each line has the form
+name seconds source_size timestamp cpu_seconds max_rss. The last two fields are
+missing in files written by older versions.
+
+*******************************************************************************/
+void BuildHistory::load()
+{
+  std::ifstream file;
+  std::string line, name;
+  std::vector<std::string> fields;
+  build_record rec;
+
+  if (_loaded) { return; }
+  _loaded = true;
+
+  file.open(_path.c_str());
+  if (not file.is_open()) { return; }
+
+  while (std::getline(file, line))
+  {
+    fields = split(line, ' ');
+    if ( (fields.size() != 4) && (fields.size() != 6) ) { continue; }
+    std::stringstream ss(line);
+    rec.cpu_seconds = 0.;
+    rec.max_rss = 0;
+    if (! (ss >> name >> rec.seconds >> rec.source_size >> rec.timestamp))
+      continue;
+    if ( (fields.size() == 6) && (! (ss >> rec.cpu_seconds >> rec.max_rss)) )
+      continue;
+    _records[name] = rec;
+  }
+  file.close();
+
+  fit();
+}
+
+/*******************************************************************************
+
+Computes the rates used to estimate builds with no record: the average build
+seconds per byte of source over all builds with a known size (0 if there are
+none), and the median recorded build time (a fixed default if there are no
+records). Called whenever the records change, so that estimates don't go
+through all records each time.
+
+*******************************************************************************/
+void BuildHistory::fit()
+{
+  std::map<std::string, build_record>::const_iterator it;
+  std::vector<double> times;
+  double seconds, bytes;
+
+  seconds = 0.;
+  bytes = 0.;
+  for ( it = _records.begin(); it != _records.end(); it++ )
+  {
+    times.push_back(it->second.seconds);
+    if (it->second.source_size > 0)
+    {
+      seconds += it->second.seconds;
+      bytes += double(it->second.source_size);
+    }
+  }
+
+  if (bytes > 0.) { _seconds_per_byte = seconds/bytes; }
+  else { _seconds_per_byte = 0.; }
+
+  if (times.size() == 0) { _median_seconds = default_build_seconds; }
+  else
+  {
+    std::nth_element(times.begin(), times.begin()+times.size()/2,
+                     times.end());
+    _median_seconds = times[times.size()/2];
+  }
+}
+
+/*******************************************************************************
+
+Set location of history file
+
+*******************************************************************************/
+void BuildHistory::setPath(const std::string & path)
+{
+  _path = path;
+  _records.clear();
+  _seconds_per_byte = 0.;
+  _median_seconds = default_build_seconds;
+  _loaded = false;
+}
+
+/*******************************************************************************
+
+Records a successful build, with the resources it used if known, and saves the
+history. The file is rewritten in full via a temporary file, so it only ever
+holds the latest build of each SlackBuild. Returns 0 on success or 1 if the
+history could not be saved.
+
+*******************************************************************************/
+int BuildHistory::record(const BuildListItem & build, double seconds,
+                         double cpu_seconds, long max_rss)
+{
+  DirListing listing;
+  std::ofstream file;
+  std::string tmppath;
+  std::string::size_type pos;
+  std::map<std::string, build_record>::const_iterator it;
+  build_record rec;
+
+  load();
+
+  rec.seconds = seconds;
+  rec.cpu_seconds = cpu_seconds;
+  rec.max_rss = max_rss;
+  rec.source_size = slackbuild_size(build);
+  rec.timestamp = (long long)time(NULL);
+  _records[build.name()] = rec;
+  fit();
+
+  pos = _path.rfind('/');
+  if ( (pos != std::string::npos) && (pos > 0) )
+  {
+    if (listing.createFromPath(_path.substr(0, pos)) != 0) { return 1; }
+  }
+
+  tmppath = _path + ".tmp";
+  file.open(tmppath.c_str());
+  if (not file.is_open()) { return 1; }
+  for ( it = _records.begin(); it != _records.end(); it++ )
+  {
+    file << it->first << " " << it->second.seconds << " "
+         << it->second.source_size << " " << it->second.timestamp << " "
+         << it->second.cpu_seconds << " " << it->second.max_rss << "\n";
+  }
+  file.close();
+  if (file.fail()) { return 1; }
+
+  if (rename(tmppath.c_str(), _path.c_str()) != 0) { return 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Looks up the most recent build of a SlackBuild. Returns true if found.
+
+*******************************************************************************/
+bool BuildHistory::lookup(const std::string & name, build_record & rec)
+{
+  std::map<std::string, build_record>::const_iterator it;
+
+  load();
+  it = _records.find(name);
+  if (it == _records.end()) { return false; }
+  rec = it->second;
+
+  return true;
+}
+
+/*******************************************************************************
+
+Predicted time in seconds to build a SlackBuild. Uses the last recorded build
+if there is one. Otherwise, scales the size of the SlackBuild by the average
+rate from the history, falling back to the median recorded build time or a
+fixed default if nothing better is known. The rates are computed by fit.
+
+*******************************************************************************/
+double BuildHistory::estimate(const BuildListItem & build)
+{
+  build_record rec;
+  long long size;
+
+  if (lookup(build.name(), rec)) { return rec.seconds; }
+
+  if (_seconds_per_byte > 0.)
+  {
+    size = slackbuild_size(build);
+    if (size > 0) { return _seconds_per_byte*double(size); }
+  }
+
+  return _median_seconds;
+}
+
+/*******************************************************************************
+
+Predicts time for a list of SlackBuilds given in build order. Only marked
+SlackBuilds are counted, and removals are taken to be free. total is the time
+to do everything one after another, critical is the longest chain of
+dependencies within the list, and parallel is the time taken by a greedy
+schedule running up to njobs builds at once, each waiting for its
+dependencies to finish.
+
+*******************************************************************************/
+void BuildHistory::predict(const std::vector<BuildListItem *> & builds,
+                           unsigned int njobs, double & total,
+                           double & critical, double & parallel)
+{
+  unsigned int i, j, k, nbuilds, ndeps;
+  std::unordered_map<unsigned int, unsigned int> index;
+  std::unordered_map<unsigned int, unsigned int>::const_iterator it;
+  std::vector<double> cost, chain, finish, workers;
+  std::vector<unsigned int> deps;
+  double ready, start;
+
+  total = 0.;
+  critical = 0.;
+  parallel = 0.;
+  if (njobs < 1) { njobs = 1; }
+  workers.assign(njobs, 0.);
+
+  nbuilds = builds.size();
+  cost.assign(nbuilds, 0.);
+  chain.assign(nbuilds, 0.);
+  finish.assign(nbuilds, 0.);
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (! builds[i]->getBoolProp("marked")) { continue; }
+    if (builds[i]->getProp("action") != "Remove")
+      cost[i] = estimate(*builds[i]);
+    total += cost[i];
+
+    // Dependencies on SlackBuilds earlier in the list. Requirements are kept
+    // once read, so the .info file is not read again on the next prediction.
+
+    if (builds[i]->ensureRepoProps() == 0) { deps = builds[i]->requiresIds(); }
+    else { deps.resize(0); }
+    ndeps = deps.size();
+    ready = 0.;
+    for ( j = 0; j < ndeps; j++ )
+    {
+      it = index.find(deps[j]);
+      if (it == index.end()) { continue; }
+      chain[i] = std::max(chain[i], chain[it->second]);
+      ready = std::max(ready, finish[it->second]);
+    }
+    chain[i] += cost[i];
+    critical = std::max(critical, chain[i]);
+
+    // Start on whichever job slot frees up first
+
+    k = 0;
+    for ( j = 1; j < njobs; j++ )
+    {
+      if (workers[j] < workers[k]) { k = j; }
+    }
+    start = std::max(workers[k], ready);
+    finish[i] = start + cost[i];
+    workers[k] = finish[i];
+    parallel = std::max(parallel, finish[i]);
+
+    index[interned_names.intern(builds[i]->name())] = i;
+  }
+}
@@ -1,13 +1,15 @@
 #include <vector>
 #include <string>
 #include <cmath>     // floor
-#include <algorithm> // min
+#include <algorithm> // min, max
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "TagList.h"
 #include "BuildListItem.h"
 #include "BuildListBox.h"
+#include "backend.h"  // build_changes
 
 /*******************************************************************************
 
@@ -66,7 +68,7 @@ void BuildListBox::redrawFrame()
   // Draw header
 
   wmove(_win, 1, 1);
-  colors.turnOn(_win, "header", "bg_normal");
+  colors.turnOn(_win, color::header, color::bg_normal);
   wprintw(_win, "Name");
   colors.turnOff(_win);
 
@@ -74,7 +76,7 @@ void BuildListBox::redrawFrame()
   nspaces = vlineloc - std::string("Name").size();
   for ( i = 0; i < nspaces; i++ ) { waddch(_win, ' '); }
 
-  colors.turnOn(_win, "header", "bg_normal");
+  colors.turnOn(_win, color::header, color::bg_normal);
   printToEol("Installed");
   wmove(_win, 2, 1);
   colors.turnOff(_win);
@@ -93,93 +95,77 @@ void BuildListBox::redrawFrame()
 }
 
 /*******************************************************************************
- 
-Redraws a single item. Note: doesn't check if the item is actually on the
-screen or not.
+
+Attributes for an item. Tagged items are bold if colors are not available.
 
 *******************************************************************************/
-void BuildListBox::redrawSingleItem(unsigned int idx)
+chtype BuildListBox::itemAttributes(unsigned int idx) const
 {
-  std::string fg, bg;
-  int nspaces, vlineloc, printlen, rows, cols, i, nast;
-
-  getmaxyx(_win, rows, cols);
-
-  // Print divider before applying color
-
-  vlineloc = cols-2 - std::string("Installed").size() - 1;
-  wmove(_win, idx-_firstprint+_header_rows, vlineloc+1);
-  waddch(_win, ACS_VLINE);
-
-  // Go to item location, optionally highlight, and print item
-
-  wmove(_win, idx-_firstprint+3, 1);
-
-  // Turn on highlight color
+  color::label fg, bg;
+  chtype fallback;
+  bool tagged;
 
+  tagged = item(idx)->getBoolProp("tagged");
+  fallback = A_NORMAL;
+  if (tagged) { fallback = A_BOLD; }
   if (int(idx) == _highlight)
   {
     if (_activated) 
     { 
-      if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-      else { fg = "fg_highlight_active"; }
-      bg = "bg_highlight_active"; 
+      if (tagged) { fg = color::tagged; }
+      else { fg = color::fg_highlight_active; }
+      bg = color::bg_highlight_active; 
+      fallback |= A_REVERSE;
     }
     else
     {
-      if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-      else { fg = "fg_highlight_inactive"; }
-      bg = "bg_highlight_inactive"; 
-    }
-    if (colors.turnOn(_win, fg, bg) != 0)
-    { 
-      if (_activated) { wattron(_win, A_REVERSE); }
-      if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); } 
+      if (tagged) { fg = color::tagged; }
+      else { fg = color::fg_highlight_inactive; }
+      bg = color::bg_highlight_inactive; 
     }
   } 
   else
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_normal"; }
-    bg = "bg_normal";
-    if (colors.turnOn(_win, fg, bg) != 0)
-    {
-      if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); } 
-    }
+    if (tagged) { fg = color::tagged; }
+    else { fg = color::fg_normal; }
+    bg = color::bg_normal;
   }
 
-  // Save highlight idx for redrawing later.
-  // Note: prevents this method from being const.
-  
-  if (int(idx) == _highlight) { _prevhighlight = _highlight; }
-
-  // Print an asterisk next to any SlackBuild with build options set
+  return colorAttributes(fg, bg, fallback);
+}
 
-  nast = 0;
-  if (_items[idx]->getProp("build_options") != "")
-    nast = 1;
+/*******************************************************************************
+ 
+Redraws a single item. Note: doesn't check if the item is actually on the
+screen or not.
 
-  // Print item, spaces, install status
+*******************************************************************************/
+void BuildListBox::redrawSingleItem(unsigned int idx)
+{
+  std::string text;
+  chtype attr;
+  int vlineloc, cols;
 
-  printlen = std::min(int(_items[idx]->name().size()), vlineloc);
-  nspaces = vlineloc - _items[idx]->name().size() - nast;
-  wprintw(_win, "%s", _items[idx]->name().substr(0,printlen).c_str());
-  if (nast == 1)
-    waddch(_win, '*');
+  cols = getmaxx(_win);
+  vlineloc = cols-2 - std::string("Installed").size() - 1;
+  attr = itemAttributes(idx);
 
-  for ( i = 0; int(i) < nspaces; i++ ) { waddch(_win, ' '); }
+  // Save highlight idx for redrawing later.
+  // Note: prevents this method from being const.
+  
+  if (int(idx) == _highlight) { _prevhighlight = _highlight; }
 
-  wmove(_win, idx-_firstprint+3, vlineloc+2);
-  if (_items[idx]->getBoolProp("installed")) { printToEol("   [X]   "); }
-  else { printToEol("   [ ]   "); }
+  // Compose row: item, an asterisk if build options are set, spaces, divider,
+  // and install status
 
-  // Turn off color
+  text = item(idx)->name().substr(0, std::max(vlineloc, 0));
+  if (item(idx)->getProp("build_options") != "") { text += "*"; }
+  if (vlineloc >= 0) { text.resize(vlineloc+1, ' '); }
+  if (item(idx)->getBoolProp("installed")) { text += "   [X]   "; }
+  else { text += "   [ ]   "; }
 
-  if (colors.turnOff(_win) != 0)
-  {
-    if ( (int(idx) == _highlight) && _activated ) { wattroff(_win, A_REVERSE); }
-    if (_items[idx]->getBoolProp("tagged")) { wattroff(_win, A_BOLD); } 
-  }
+  printRow(idx, idx-_firstprint+_header_rows, 1, cols-2, text, -1, attr,
+           attr, vlineloc);
 }
 
 /*******************************************************************************
@@ -212,11 +198,11 @@ bool BuildListBox::allTagged() const
   unsigned int i, nitems;
   bool all_tagged;
 
-  nitems = _items.size();
+  nitems = numItems();
   all_tagged = true;
   for ( i = 0; i < nitems; i++ )
   {
-    if (! _items[i]->getBoolProp("tagged")) 
+    if (! item(i)->getBoolProp("tagged")) 
     {
       all_tagged = false;
       break;
@@ -242,9 +228,10 @@ void BuildListBox::tagSlackBuild(unsigned int idx)
 {
   if (idx < numItems())
   {
-    _items[idx]->setBoolProp("tagged", ! _items[idx]->getBoolProp("tagged"));
-    if (_items[idx]->getBoolProp("tagged")) { _taglist->addItem(_items[idx]); }
-    else { _taglist->removeItem(_items[idx]); }
+    item(idx)->setBoolProp("tagged", ! item(idx)->getBoolProp("tagged"));
+    if (item(idx)->getBoolProp("tagged")) { _taglist->addItem(item(idx)); }
+    else { _taglist->removeItem(item(idx)); }
+    build_changes.record(static_cast<BuildListItem *>(item(idx)));
   }
 }
 void BuildListBox::tagHighlightedSlackBuild() { tagSlackBuild(_highlight); }
@@ -261,15 +248,16 @@ unsigned int BuildListBox::tagAll()
 
   // First check if everything is tagged
 
-  nitems = _items.size();
+  nitems = numItems();
   if (! allTagged())
   {
     for ( i = 0; i < nitems; i++ ) 
     { 
-      if (! _items[i]->getBoolProp("tagged")) 
+      if (! item(i)->getBoolProp("tagged")) 
       { 
-        _items[i]->setBoolProp("tagged", true); 
-        _taglist->addItem(_items[i]);
+        item(i)->setBoolProp("tagged", true); 
+        _taglist->addItem(item(i));
+        build_changes.record(static_cast<BuildListItem *>(item(i)));
       }
     }
     retval = 0;
@@ -278,10 +266,11 @@ unsigned int BuildListBox::tagAll()
   {
     for ( i = 0; i < nitems; i++ ) 
     { 
-      if (_items[i]->getBoolProp("tagged")) 
+      if (item(i)->getBoolProp("tagged")) 
       {
-        _items[i]->setBoolProp("tagged", false); 
-        _taglist->removeItem(_items[i]);
+        item(i)->setBoolProp("tagged", false); 
+        _taglist->removeItem(item(i));
+        build_changes.record(static_cast<BuildListItem *>(item(i)));
       }
     }
     retval = 1;
@@ -289,7 +278,7 @@ unsigned int BuildListBox::tagAll()
 
   // Set all items to be redrawn
 
-  _redraw_type = "items";
+  _redraw_type = redraw::items;
 
   return retval;
 }
@@ -299,10 +288,10 @@ unsigned int BuildListBox::tagAll()
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
-std::string BuildListBox::exec(MouseEvent * mevent)
+Signal BuildListBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -318,14 +307,14 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
     case '\n':
     case '\r':
     case KEY_ENTER:
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       if (int(_button_signals.size()) >= _highlighted_button+1)
         retval = _button_signals[_highlighted_button];
       else
@@ -336,46 +325,29 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
 
     case KEY_UP:
-      retval = signals::highlight;
-      check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_DOWN:
-      retval = signals::highlight;
-      check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_PPAGE:
-      retval = signals::highlight;
-      check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_NPAGE:
       retval = signals::highlight;
-      check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      _redraw_type = moveHighlight(ch);
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Right and left keys: change highlighted button (if present)
@@ -383,46 +355,46 @@ std::string BuildListBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // t and T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // F9 key: activates menubar
 
     case KEY_F(9):
       retval = signals::keyF9;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Mouse
@@ -431,7 +403,7 @@ std::string BuildListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
         retval = signals::mouseEvent;
       }
       else
@@ -440,7 +412,7 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
       break;
   }
   return retval;
@@ -1,7 +1,9 @@
 #include <string>
+#include <string_view>
 #include <vector>
-#include <algorithm> 	// count
 #include <cctype>	// isdigit
+#include "PackageDatabase.h"
+#include "StringInterner.h"
 #include "backend.h"
 #include "string_util.h"
 #include "ListItem.h"
@@ -9,78 +11,37 @@
 
 /*******************************************************************************
 
-Checks if installed version is the same as available version, but with a kernel
-tag appended. Returns true if the two match except for a kernel tag appended to
-the installed version string. Otherwise returns false.
+Parses installed and available versions if they have changed
 
 *******************************************************************************/
-bool BuildListItem::differsByKernel(const std::string & installed_version,
-                                    const std::string & available_version) const
+void BuildListItem::updateVersionKeys()
 {
-  std::size_t underpos;
-  unsigned int lenavail, ndot, i;
-  std::vector<std::string> splitstr;
-  std::string tag;
-
-  // Check if the version matches
-
-  lenavail = available_version.length();
-  if (installed_version.length() < lenavail)
-    return false;
-  else if (installed_version.substr(0, lenavail) != available_version)
-    return false;
-  
-  // Check if there is a kernel tag appended
-
-  underpos = installed_version.find_first_of('_');
-  if (underpos == std::string::npos)
-    return false;
-
-  splitstr = split(installed_version, '_');
-  tag = splitstr[1];
-
-  ndot = std::count(tag.begin(), tag.end(), '.');
-  if (ndot != 2)
-    return false;
-
-  splitstr = split(tag, '.');
-  for ( i = 0; i < splitstr.size(); i++ )
-  {
-    if ( ! is_integer(splitstr[i]) )
-      return false;
-  }
-  return true;
+  _installed_key.set(getProp("installed_version"));
+  _available_key.set(getProp("available_version"));
 }
 
 /*******************************************************************************
 
-Checks whether SlackBuild can be upgraded
+Checks whether SlackBuild can be upgraded. Version keys must be up to date.
 
 *******************************************************************************/
 bool BuildListItem::upgradable() const
 {
   bool test_version, test_buildnum;
-  std::string installed_version, available_version;
-  std::string installed_buildnum, available_buildnum;
 
   test_version = false;
-  installed_version = getProp("installed_version");
-  available_version = getProp("available_version");
-
   test_buildnum = false;
-  installed_buildnum = getProp("installed_buildnum");
-  available_buildnum = getProp("available_buildnum");
 
   // Check if new VERSION or BUILD is available
 
   if ( (getBoolProp("installed")) && (! getBoolProp("blacklisted")) )
   {
-    if (installed_version != available_version)
+    if (_installed_key.str() != _available_key.str())
     {
-      if (! differsByKernel(installed_version, available_version))
+      if (! _installed_key.differsByKernel(_available_key))
         test_version = true;
     }
-    if (installed_buildnum != available_buildnum)
+    if (getProp("installed_buildnum") != getProp("available_buildnum"))
       test_buildnum = true;
   }
 
@@ -89,13 +50,29 @@ bool BuildListItem::upgradable() const
 
 /*******************************************************************************
 
-Constructor
+Constructors. Props are set up once, on a prototype made with the second
+constructor, and copied from it after that.
 
 *******************************************************************************/
 BuildListItem::BuildListItem() 
 { 
+  static const BuildListItem prototype(prototype_tag{});
+
   _name = ""; 
+  _repo_check = -1;
+  _repo_generation = 0;
+  _name_id = StringInterner::none;
+  _category_id = StringInterner::none;
+  _props = prototype._props;
+}
 
+BuildListItem::BuildListItem(prototype_tag)
+{
+  _name = "";
+  _repo_check = -1;
+  _repo_generation = 0;
+  _name_id = StringInterner::none;
+  _category_id = StringInterner::none;
   // Add props in reverse alphabetical order (should be fastest)
 
   addBoolProp("upgradable", false);
@@ -116,16 +93,42 @@ BuildListItem::BuildListItem()
 
 /*******************************************************************************
 
+Sets name and category and gets their IDs
+
+*******************************************************************************/
+void BuildListItem::setNameAndCategory(const std::string & name,
+                                       const std::string & category)
+{
+  _name = name;
+  setProp("category", category);
+  _name_id = interned_names.intern(name);
+  _category_id = interned_names.intern(category);
+}
+
+/*******************************************************************************
+
+Interned IDs
+
+*******************************************************************************/
+unsigned int BuildListItem::nameId() const { return _name_id; }
+unsigned int BuildListItem::categoryId() const { return _category_id; }
+const std::vector<unsigned int> & BuildListItem::requiresIds() const
+{
+  return _requires_ids;
+}
+
+/*******************************************************************************
+
 Checks whether this BuildListItem is installed and gets information about it
 if so. If repo info has been read already, checks whether installed SlackBuild
 is also upgradable.
 
 *******************************************************************************/
-void BuildListItem::readInstalledProps(std::vector<std::string> & installedpkgs)
+void BuildListItem::readInstalledProps(const PackageDatabase & packages)
 {
   std::string pkg, version, arch, build;
 
-  if (check_installed(*this, installedpkgs, pkg, version, arch, build))
+  if (check_installed(*this, packages, pkg, version, arch, build))
   {
     setBoolProp("installed", true);
     setProp("installed_version", version);
@@ -133,8 +136,7 @@ void BuildListItem::readInstalledProps(std::vector<std::string> & installedpkgs)
     setBoolProp("blacklisted", blacklist.blacklisted(pkg, _name, 
                                version, arch, build));
     parseBuildNum(build);
-    if (getProp("available_version") != "")
-      setBoolProp("upgradable", upgradable());
+    updateUpgradable();
   }
   else
   {
@@ -157,15 +159,82 @@ int BuildListItem::readPropsFromRepo()
   int check;
 
   check = get_repo_info(*this, available_version, reqs, available_buildnum);
+  setRepoInfo(check, available_version, reqs, available_buildnum);
+
+  return check;
+}
+
+/*******************************************************************************
+
+Sets properties read from repo by get_repo_info, e.g. on another thread. check
+is its return value.
+
+*******************************************************************************/
+void BuildListItem::setRepoInfo(int check,
+                                const std::string & available_version,
+                                const std::string & reqs,
+                                const std::string & available_buildnum)
+{
   if (check == 0)
   {
     setProp("available_version", available_version);
     setProp("requires", reqs);
+    interned_names.internList(reqs, _requires_ids);
     setProp("available_buildnum", available_buildnum);
-    if (getBoolProp("installed")) { setBoolProp("upgradable", upgradable()); }
+    if (getBoolProp("installed"))
+    {
+      updateVersionKeys();
+      setBoolProp("upgradable", upgradable());
+    }
   }
+  _repo_check = check;
+  _repo_generation = repo_generation;
+}
 
-  return check;
+/*******************************************************************************
+
+Reads properties from repo unless already read since the last sync
+
+*******************************************************************************/
+int BuildListItem::ensureRepoProps()
+{
+  if (repoPropsRead()) { return _repo_check; }
+  else { return readPropsFromRepo(); }
+}
+
+bool BuildListItem::repoPropsRead() const
+{
+  return (_repo_check != -1) && (_repo_generation == repo_generation);
+}
+
+/*******************************************************************************
+
+Sets upgradable status, if repo info has been read
+
+*******************************************************************************/
+void BuildListItem::updateUpgradable()
+{
+  if (repoPropsRead() && (getProp("available_version") != ""))
+  {
+    updateVersionKeys();
+    setBoolProp("upgradable", upgradable());
+  }
+}
+
+/*******************************************************************************
+
+Compares available version to installed version
+
+*******************************************************************************/
+int BuildListItem::versionChange()
+{
+  if ( (! getBoolProp("installed")) || (getProp("available_version") == "") )
+    return 0;
+
+  updateVersionKeys();
+  if (_installed_key.differsByKernel(_available_key)) { return 0; }
+
+  return _available_key.compare(_installed_key);
 }
 
 /*******************************************************************************
@@ -200,18 +269,16 @@ Returns build options as string of environment variables
 *******************************************************************************/
 std::string BuildListItem::buildOptionsEnv() const
 {
-  int i, noptions;
-  std::vector<std::string> build_options;
+  Tokenizer build_options(getProp("build_options"), ';');
+  std::string_view option;
   std::string build_options_string;
 
-  build_options = split(getProp("build_options"), ';');
   build_options_string = "";
-  noptions = build_options.size();
-  for ( i = 0; i < noptions-1; i++ )
+  while (build_options.next(option))
   {
-    build_options_string += build_options[i] + " ";
+    if (build_options_string.size() > 0) { build_options_string += " "; }
+    build_options_string += option;
   }
-  if (noptions > 0) { build_options_string += build_options[noptions-1]; }
 
   return build_options_string;
 }
@@ -1,7 +1,5 @@
 #include <string>
 #include <curses.h>
-#include <fstream>
-#include <cstdio>	// remove
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
@@ -9,7 +7,7 @@
 #include "BuildListItem.h"
 #include "TextInput.h"
 #include "Label.h"
-#include "DirListing.h"
+#include "backend.h"     // buildopts_store
 #include "BuildOptionsBox.h"
 #include "MouseEvent.h"
 
@@ -84,10 +82,10 @@ BuildOptionsBox::BuildOptionsBox()
   _addlbl.setSelectable(true);
   _addlbl.setName("+ Add (press space)");
   _addlbl.setPosition(3,1);
-  _addlbl.setColor(colors.getPair("header_popup", "bg_popup"));
+  _addlbl.setColor(colors.getPair(color::header_popup, color::bg_popup));
   _removelbl.setSelectable(true);
   _removelbl.setName("- Remove last (press space)");
-  _removelbl.setColor(colors.getPair("header_popup", "bg_popup"));
+  _removelbl.setColor(colors.getPair(color::header_popup, color::bg_popup));
   _entries.clear();
   setUp();
 }
@@ -149,37 +147,13 @@ std::string BuildOptionsBox::entries() const
 
 /*******************************************************************************
 
-Writes build options to file. Deletes file if it exists and no build options
-are set.
+Saves build options in the build options store. Removes them from the store if
+no build options are set.
 
 *******************************************************************************/
 int BuildOptionsBox::write(const BuildListItem & build) const
 {
-  DirListing listing;
-  std::ofstream file;
-  std::string fname;
-  unsigned int check, nentries, i;
-
-  check = listing.createFromPath("/var/lib/sboui/buildopts");
-  if (check != 0) { return 1; }
-  fname = listing.path() + build.name() + ".buildopts";
-  nentries = numEntries();
-  file.open(fname.c_str());
-  if (not file.is_open()) { return 2; }
-
-  // Delete existing file if there are no entries or write to file
-
-  if (nentries == 0) { remove(fname.c_str()); }
-  else
-  {
-    for ( i = 0; i < nentries; i++ )
-    {
-      file << _entries[i].text() << std::endl;
-    }
-  }
-  file.close();
-
-  return 0;
+  return buildopts_store.set(build.name(), entries());
 }
 
 /*******************************************************************************
@@ -192,11 +166,11 @@ void BuildOptionsBox::draw(bool force)
   int rows, cols;
   unsigned int i, nitems;
 
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
   // Set width of everything
 
-  if (_redraw_type == "all")
+  if (_redraw_type == redraw::all)
   {
     determineFirstPrint();
     getmaxyx(_win, rows, cols);
@@ -214,11 +188,11 @@ void BuildOptionsBox::draw(bool force)
 User interaction with input items in the box
 
 *******************************************************************************/
-std::string BuildOptionsBox::exec(MouseEvent * mevent)
+Signal BuildOptionsBox::exec(MouseEvent * mevent)
 {
   bool getting_input, needs_selection;
   int y_offset;
-  std::string selection, retval;
+  Signal selection, retval;
 
   getting_input = true;
   needs_selection = true;
@@ -227,7 +201,7 @@ std::string BuildOptionsBox::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _redraw_type = redraw::changed;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
@@ -246,7 +220,7 @@ std::string BuildOptionsBox::exec(MouseEvent * mevent)
       else if (_items[_highlight]->name() == "- Remove last (press space)")
         removeLast();
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       getting_input = false;
     }
   }
@@ -0,0 +1,327 @@
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
+#include <fstream>
+#include <fcntl.h>      // open
+#include <unistd.h>     // read, write, fsync, close
+#include <sys/stat.h>   // fstat
+#include <stdio.h>      // rename
+#include "DirListing.h"
+#include "BuildOptionsStore.h"
+
+/* Rewrite the file once it has this many lines more than twice the number of
+   SlackBuilds with options */
+
+static const unsigned int compact_slack = 64;
+
+/*******************************************************************************
+
+Creates the directory holding the file if needed
+
+*******************************************************************************/
+int BuildOptionsStore::createDir() const
+{
+  DirListing listing;
+  std::string::size_type pos;
+
+  pos = _path.rfind('/');
+  if ( (pos != std::string::npos) && (pos > 0) )
+  {
+    if (listing.createFromPath(_path.substr(0, pos)) != 0) { return 1; }
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Parses one line of the file. Each line is the SlackBuild name, a space, and its
+options joined by semicolons, as in the build_options prop. A line with a name
+and no options removes them.
+
+*******************************************************************************/
+void BuildOptionsStore::parseRecord(std::string_view line)
+{
+  std::string_view::size_type pos;
+  std::string_view name, options;
+
+  pos = line.find(' ');
+  name = line.substr(0, pos);
+  if (name.size() == 0) { return; }
+  if (pos != std::string_view::npos) { options = line.substr(pos+1); }
+
+  if (options.size() == 0) { _options.erase(std::string(name)); }
+  else { _options[std::string(name)] = options; }
+  _nrecords++;
+}
+
+/*******************************************************************************
+
+Reads the file in one go. A last line without a newline was cut short while
+being appended and is skipped. If there is no file, imports the legacy
+directory instead. Compacts the file if it has built up many overridden lines,
+or to drop a cut-short line so that the next one isn't appended to it.
+
+*******************************************************************************/
+int BuildOptionsStore::load()
+{
+  std::string buffer;
+  std::string_view contents;
+  std::string_view::size_type pos;
+  struct stat st;
+  ssize_t nread;
+  int fd;
+
+  _options.clear();
+  _nrecords = 0;
+  _loaded = true;
+
+  fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    if (importLegacy() == 0) { compact(); }
+    return 0;
+  }
+
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    return 1;
+  }
+  buffer.resize(st.st_size);
+  nread = ::read(fd, &buffer[0], buffer.size());
+  close(fd);
+  if (nread < 0) { return 1; }
+  buffer.resize(nread);
+
+  contents = buffer;
+  while ((pos = contents.find('\n')) != std::string_view::npos)
+  {
+    parseRecord(contents.substr(0, pos));
+    contents.remove_prefix(pos+1);
+  }
+
+  if ( (contents.size() > 0) ||
+       (_nrecords > 2*_options.size() + compact_slack) )
+    compact();
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads the legacy directory, which has a file name.buildopts for each SlackBuild
+with one option per line. Returns 0 if it was read or 1 if it doesn't exist.
+The directory is left as it is.
+
+*******************************************************************************/
+int BuildOptionsStore::importLegacy()
+{
+  DirListing listing;
+  std::ifstream file;
+  std::string fname, options, opt;
+  std::string::size_type ext_idx;
+  unsigned int k, nfiles;
+  const std::string ext = ".buildopts";
+
+  if (listing.setFromPath(_legacy_dir, false) != 0) { return 1; }
+
+  nfiles = listing.size();
+  for ( k = 0; k < nfiles; k++ )
+  {
+    fname = listing(k).name;
+    if (fname.size() <= ext.size()) { continue; }
+    ext_idx = fname.size() - ext.size();
+    if (fname.compare(ext_idx, ext.size(), ext) != 0) { continue; }
+
+    file.open((_legacy_dir + "/" + fname).c_str());
+    if (not file.is_open()) { continue; }
+    options = "";
+    while (std::getline(file, opt))
+    {
+      if (opt.size() == 0) { continue; }
+      if (options.size() > 0) { options += ";"; }
+      options += opt;
+    }
+    file.close();
+    file.clear();
+
+    if (options.size() > 0) { _options[fname.substr(0, ext_idx)] = options; }
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Appends a line to the file and syncs it to disk
+
+*******************************************************************************/
+int BuildOptionsStore::append(const std::string & line) const
+{
+  int fd, check;
+  std::string buffer;
+
+  fd = open(_path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd < 0) { return 1; }
+
+  buffer = line + "\n";
+  check = 0;
+  if (write(fd, buffer.c_str(), buffer.size()) != ssize_t(buffer.size()))
+    check = 1;
+  if (fsync(fd) != 0) { check = 1; }
+  close(fd);
+
+  return check;
+}
+
+/*******************************************************************************
+
+Rewrites the file with only the current options. A temporary file is written
+and synced first and then renamed over the old one, so that a crash leaves
+either the old or the new file in place.
+
+*******************************************************************************/
+int BuildOptionsStore::compact()
+{
+  std::unordered_map<std::string, std::string>::const_iterator it;
+  std::string tmppath, buffer;
+  int fd, check;
+
+  if (createDir() != 0) { return 1; }
+
+  for ( it = _options.begin(); it != _options.end(); it++ )
+  {
+    buffer += it->first + " " + it->second + "\n";
+  }
+
+  tmppath = _path + ".tmp";
+  fd = open(tmppath.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 0644);
+  if (fd < 0) { return 1; }
+  check = 0;
+  if (write(fd, buffer.c_str(), buffer.size()) != ssize_t(buffer.size()))
+    check = 1;
+  if (fsync(fd) != 0) { check = 1; }
+  close(fd);
+  if (check != 0) { return 1; }
+
+  if (rename(tmppath.c_str(), _path.c_str()) != 0) { return 1; }
+  _nrecords = _options.size();
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildOptionsStore::BuildOptionsStore()
+{
+  _path = "/var/lib/sboui/buildopts.log";
+  _legacy_dir = "/var/lib/sboui/buildopts";
+  _nrecords = 0;
+  _loaded = false;
+}
+
+/*******************************************************************************
+
+Set/get location of the file and of the legacy directory
+
+*******************************************************************************/
+void BuildOptionsStore::setPath(const std::string & path)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _path = path;
+  _options.clear();
+  _nrecords = 0;
+  _loaded = false;
+}
+
+void BuildOptionsStore::setLegacyDir(const std::string & dir)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _legacy_dir = dir;
+}
+
+const std::string & BuildOptionsStore::path() const { return _path; }
+
+/*******************************************************************************
+
+Reads the file, or imports the legacy directory if there is no file
+
+*******************************************************************************/
+int BuildOptionsStore::read()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return load();
+}
+
+bool BuildOptionsStore::loaded() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _loaded;
+}
+
+/*******************************************************************************
+
+Number of SlackBuilds with options
+
+*******************************************************************************/
+unsigned int BuildOptionsStore::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _options.size();
+}
+
+/*******************************************************************************
+
+Looks up options for a SlackBuild. Returns true if found.
+
+*******************************************************************************/
+bool BuildOptionsStore::lookup(const std::string & name,
+                               std::string & options) const
+{
+  std::unordered_map<std::string, std::string>::const_iterator it;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  it = _options.find(name);
+  if (it == _options.end()) { return false; }
+  options = it->second;
+
+  return true;
+}
+
+/*******************************************************************************
+
+Saves options for a SlackBuild, or removes them if options is empty. The file
+is read first if it hasn't been, so that the legacy directory is still imported
+before anything is appended. Returns 0 on success or 1 if the options could not
+be saved (e.g., not running as root).
+
+*******************************************************************************/
+int BuildOptionsStore::set(const std::string & name,
+                           const std::string & options)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (! _loaded) { load(); }
+
+  if (options.size() == 0)
+  {
+    if (_options.erase(name) == 0) { return 0; }
+  }
+  else
+  {
+    if ( (_options.count(name) > 0) && (_options[name] == options) )
+      return 0;
+    _options[name] = options;
+  }
+
+  if (createDir() != 0) { return 1; }
+  if (append(name + " " + options) != 0) { return 1; }
+  _nrecords++;
+
+  return 0;
+}
@@ -30,7 +30,7 @@ void BuildOrderBox::redrawFrame()
   left = std::floor(mid - double(namelen)/2.0);
   right = left + namelen;
   wmove(_win, 0, left);
-  if (colors.turnOn(_win, "fg_title", "bg_title") != 0)
+  if (colors.turnOn(_win, color::fg_title, color::bg_title) != 0)
     wattron(_win, A_BOLD);
   wprintw(_win, "%s", _name.c_str());
   if (colors.turnOff(_win) != 0)
@@ -71,7 +71,7 @@ void BuildOrderBox::redrawFrame()
   // Draw header
 
   wmove(_win, 1, 1);
-  colors.turnOn(_win, "header_popup", "bg_popup");
+  colors.turnOn(_win, color::header_popup, color::bg_popup);
   wprintw(_win, "Name");
 
   vlineloc = cols-2 - std::string("Installed").size();
@@ -112,7 +112,7 @@ screen or not.
 *******************************************************************************/
 void BuildOrderBox::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
   int nspaces, vlineloc, printlen, rows, cols, i, nast;
 
   getmaxyx(_win, rows, cols);
@@ -131,9 +131,9 @@ void BuildOrderBox::redrawSingleItem(unsigned int idx)
 
   if (int(idx) == _highlight)
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_highlight_active"; }
-    bg = "bg_highlight_active"; 
+    if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+    else { fg = color::fg_highlight_active; }
+    bg = color::bg_highlight_active; 
 
     if (colors.turnOn(_win, fg, bg) != 0)
     { 
@@ -143,9 +143,9 @@ void BuildOrderBox::redrawSingleItem(unsigned int idx)
   } 
   else
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_popup"; }
-    bg = "bg_popup";
+    if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+    else { fg = color::fg_popup; }
+    bg = color::bg_popup;
     if (colors.turnOn(_win, fg, bg) != 0)
     {
       if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); } 
@@ -193,7 +193,8 @@ Constructors
 *******************************************************************************/
 BuildOrderBox::BuildOrderBox()
 { 
-  std::vector<std::string> buttons(2), button_signals(2);
+  std::vector<std::string> buttons(2);
+  std::vector<Signal> button_signals(2);
 
   _reserved_rows = 6;
   _header_rows = 3;
@@ -202,12 +203,13 @@ BuildOrderBox::BuildOrderBox()
   button_signals[0] = signals::quit;
   button_signals[1] = "a";
   setButtons(buttons, button_signals);
-  setColor("fg_popup", "bg_popup");
+  setColor(color::fg_popup, color::bg_popup);
 }
 
 BuildOrderBox::BuildOrderBox(WINDOW *win, const std::string & name)
 {
-  std::vector<std::string> buttons(2), button_signals(2);
+  std::vector<std::string> buttons(2);
+  std::vector<Signal> button_signals(2);
 
   _reserved_rows = 6;
   _header_rows = 3;
@@ -216,7 +218,7 @@ BuildOrderBox::BuildOrderBox(WINDOW *win, const std::string & name)
   button_signals[0] = signals::quit;
   button_signals[1] = "a";
   setButtons(buttons, button_signals);
-  setColor("fg_popup", "bg_popup");
+  setColor(color::fg_popup, color::bg_popup);
   _win = win;
   _name = name;
 }
@@ -292,7 +294,8 @@ int BuildOrderBox::create(BuildListItem & build,
   int check; 
   unsigned int nbuilds, i;
   std::vector<BuildListItem *> reqlist;
-  std::vector<std::string> buttons, button_signals;
+  std::vector<std::string> buttons;
+  std::vector<Signal> button_signals;
 
   if (mode == "forward")
   {
@@ -338,10 +341,10 @@ int BuildOrderBox::create(BuildListItem & build,
 Handles mouse events
 
 *******************************************************************************/
-std::string BuildOrderBox::handleMouseEvent(MouseEvent * mevent)
+Signal BuildOrderBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs;
-  std::string retval;
+  Signal retval;
 
   getmaxyx(_win, rows, cols);
   getbegyx(_win, begy, begx);
@@ -0,0 +1,375 @@
+#include <vector>
+#include <string>
+#include <cmath>     // floor
+#include <algorithm> // max, min
+#include <utility>   // swap
+#include <unordered_map>
+#include <curses.h>
+#include "Color.h"
+#include "settings.h"  // colors
+#include "string_util.h"
+#include "parallel_sort.h"
+#include "BuildListItem.h"
+#include "VersionKey.h"
+#include "BuildHistory.h"
+#include "backend.h"   // build_history
+#include "BuildTableBox.h"
+
+/* Column titles and fixed widths (the name column takes the rest) */
+
+static const char *column_titles[BuildTableBox::ncolumns] =
+  { "Name", "Category", "Installed", "Available", "Size", "Build" };
+static const int column_widths[BuildTableBox::ncolumns] =
+  { 0, 16, 14, 14, 8, 8 };
+static const int min_name_width = 10;
+
+/*******************************************************************************
+
+Widths of columns to fit in cols, with a space between columns. Columns that
+don't fit get a width of 0.
+
+*******************************************************************************/
+void BuildTableBox::columnWidths(int cols, std::vector<int> & widths) const
+{
+  int i, avail;
+
+  widths.assign(ncolumns, 0);
+  avail = cols - min_name_width;
+  for ( i = 1; i < ncolumns; i++ )
+  {
+    if (avail < column_widths[i] + 1) { break; }
+    widths[i] = column_widths[i];
+    avail -= column_widths[i] + 1;
+  }
+  widths[Name] = std::max(min_name_width + avail, 0);
+}
+
+/*******************************************************************************
+
+Pads or truncates each field to its column width and joins them
+
+*******************************************************************************/
+std::string BuildTableBox::composeRow(const std::vector<std::string> & fields,
+                                      const std::vector<int> & widths) const
+{
+  int i;
+  std::string row, field;
+
+  for ( i = 0; i < ncolumns; i++ )
+  {
+    if (widths[i] <= 0) { continue; }
+    if (i > 0) { row += " "; }
+    field = fields[i].substr(0, widths[i]);
+    field.resize(widths[i], ' ');
+    row += field;
+  }
+
+  return row;
+}
+
+/*******************************************************************************
+
+Draws window border, title, and column headers. The sorted column is marked
+with ^ (ascending) or v (descending).
+
+*******************************************************************************/
+void BuildTableBox::redrawFrame()
+{
+  int rows, cols, namelen, i, left, right;
+  std::vector<int> widths;
+  std::vector<std::string> titles(ncolumns);
+
+  getmaxyx(_win, rows, cols);
+
+  // Title
+
+  namelen = _name.size();
+  left = std::floor(double(cols)/2.0 - double(namelen)/2.0);
+  right = left + namelen;
+  wmove(_win, 0, left);
+  wattron(_win, A_BOLD);
+  wprintw(_win, "%s", _name.c_str());
+  wattroff(_win, A_BOLD);
+
+  // Corners and borders
+
+  mvwaddch(_win, 0, 0, ACS_ULCORNER);
+  mvwaddch(_win, rows-1, 0, ACS_LLCORNER);
+  mvwaddch(_win, rows-1, cols-1, ACS_LRCORNER);
+  mvwaddch(_win, 0, cols-1, ACS_URCORNER);
+  wmove(_win, 0, 1);
+  for ( i = 1; i < left-1; i++ ) { waddch(_win, ACS_HLINE); }
+  wmove(_win, 0, right+1);
+  for ( i = right+1; i < cols-1; i++ ) { waddch(_win, ACS_HLINE); }
+  for ( i = 1; i < rows-1; i++ ) { mvwaddch(_win, i, 0, ACS_VLINE); }
+  mvwaddch(_win, 1, cols-1, ACS_VLINE);
+  wmove(_win, rows-1, 1);
+  for ( i = 1; i < cols-1; i++ ) { waddch(_win, ACS_HLINE); }
+
+  // Column headers
+
+  for ( i = 0; i < ncolumns; i++ )
+  {
+    titles[i] = int_to_string(i+1) + ":" + column_titles[i];
+    if (i == _sort_column)
+    {
+      if (_descending) { titles[i] += " v"; }
+      else { titles[i] += " ^"; }
+    }
+  }
+  columnWidths(cols-2, widths);
+  wmove(_win, 1, 1);
+  colors.turnOn(_win, color::header, color::bg_normal);
+  printToEol(composeRow(titles, widths), cols-2);
+  colors.turnOff(_win);
+
+  // Divider below header
+
+  wmove(_win, 2, 1);
+  for ( i = 1; i < cols-1; i++ ) { waddch(_win, ACS_HLINE); }
+  mvwaddch(_win, 2, 0, ACS_LTEE);
+  mvwaddch(_win, 2, cols-1, ACS_RTEE);
+}
+
+/*******************************************************************************
+
+Redraws a single item. Note: doesn't check if the item is actually on the
+screen or not.
+
+*******************************************************************************/
+void BuildTableBox::redrawSingleItem(unsigned int idx)
+{
+  int cols;
+  chtype attr;
+  std::vector<int> widths;
+  std::vector<std::string> fields(ncolumns);
+
+  cols = getmaxx(_win);
+  attr = itemAttributes(idx);
+  if (int(idx) == _highlight) { _prevhighlight = _highlight; }
+
+  const row_keys & row = _rows[_order[idx]];
+  fields[Name] = row.build->name();
+  if (row.build->getProp("build_options") != "") { fields[Name] += "*"; }
+  fields[Category] = row.category;
+  fields[Installed] = row.installed.str();
+  fields[Available] = row.available.str();
+  fields[Size] = row.sizetext;
+  fields[LastBuild] = row.buildtext;
+  columnWidths(cols-2, widths);
+
+  printRow(idx, idx-_firstprint+_header_rows, 1, cols-2,
+           composeRow(fields, widths), -1, attr, attr);
+}
+
+/*******************************************************************************
+
+Sorts rows by the current column and direction and lists them in that order
+
+*******************************************************************************/
+void BuildTableBox::applyOrder()
+{
+  unsigned int i, nrows;
+  const std::vector<row_keys> & rows = _rows;
+  const column col = _sort_column;
+  const bool descending = _descending;
+
+  parallel_stable_sort(_order, [&rows, col, descending](unsigned int a,
+                                                        unsigned int b)
+  {
+    if (descending) { std::swap(a, b); }
+    switch (col) {
+      case Category: return rows[a].category < rows[b].category;
+      case Installed: return rows[a].installed.compare(rows[b].installed) < 0;
+      case Available: return rows[a].available.compare(rows[b].available) < 0;
+      case Size: return rows[a].size < rows[b].size;
+      case LastBuild: return rows[a].build_seconds < rows[b].build_seconds;
+      default: return rows[a].build->name() < rows[b].build->name();
+    }
+  });
+
+  nrows = _order.size();
+  _items.resize(nrows);
+  for ( i = 0; i < nrows; i++ ) { _items[i] = _rows[_order[i]].build; }
+  _redraw_type = redraw::all;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildTableBox::BuildTableBox()
+{
+  _name = "All SlackBuilds (1-6: sort, Esc: back)";
+  _reserved_rows = 4;
+  _header_rows = 3;
+  _sort_column = Name;
+  _descending = false;
+  _activated = true;
+}
+
+/*******************************************************************************
+
+Sizes and places window between main window header and footer
+
+*******************************************************************************/
+void BuildTableBox::placeWindow() const
+{
+  int rows, cols;
+
+  getmaxyx(stdscr, rows, cols);
+  mvwin(_win, 3, 0);
+  wresize(_win, std::max(rows-5, 3), cols);
+}
+
+/*******************************************************************************
+
+Computes sort keys that come from the installed package and the build history
+
+*******************************************************************************/
+void BuildTableBox::setLocalKeys(row_keys & row) const
+{
+  build_record rec;
+
+  row.category = row.build->getProp("category");
+  row.installed.set(row.build->getProp("installed_version"));
+  if (build_history.lookup(row.build->name(), rec))
+  {
+    row.build_seconds = rec.seconds;
+    row.buildtext = duration_to_string(rec.seconds);
+  }
+  else
+  {
+    row.build_seconds = 0.;
+    row.buildtext = "";
+  }
+}
+
+/*******************************************************************************
+
+Computes sort keys that need files in the repo to be read. Safe to call for
+different rows in parallel.
+
+*******************************************************************************/
+void BuildTableBox::setRepoKeys(row_keys & row) const
+{
+  row.build->ensureRepoProps();
+  row.available.set(row.build->getProp("available_version"));
+  row.size = slackbuild_size(*row.build);
+  row.sizetext = size_to_string(row.size);
+}
+
+/*******************************************************************************
+
+Sorts rows again and highlights the same SlackBuild as before if possible
+
+*******************************************************************************/
+void BuildTableBox::reorder()
+{
+  int i, nitems;
+  ListItem *highlighted;
+
+  highlighted = highlightedItem();
+  applyOrder();
+  nitems = _items.size();
+  for ( i = 0; i < nitems; i++ )
+  {
+    if (_items[i] == highlighted)
+    {
+      setHighlight(i);
+      break;
+    }
+  }
+}
+
+/*******************************************************************************
+
+Lists all SlackBuilds, computing sort keys for each. Available versions and
+sizes need files to be read for each SlackBuild, so they are computed in
+parallel.
+
+*******************************************************************************/
+void BuildTableBox::setBuilds(
+                       std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, j, ncategories, nbuilds;
+  int k, nrows;
+  ListItem *highlighted;
+  row_keys row;
+
+  highlighted = highlightedItem();
+
+  _rows.resize(0);
+  _row_index.clear();
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      row.build = &slackbuilds[i][j];
+      setLocalKeys(row);
+      _row_index[row.build] = _rows.size();
+      _rows.push_back(row);
+    }
+  }
+
+  nrows = _rows.size();
+  #pragma omp parallel for schedule(dynamic, 64)
+  for ( k = 0; k < nrows; k++ ) { setRepoKeys(_rows[k]); }
+
+  _order.resize(nrows);
+  for ( k = 0; k < nrows; k++ ) { _order[k] = k; }
+  applyOrder();
+
+  _highlight = 0;
+  _prevhighlight = 0;
+  _firstprint = 0;
+  for ( k = 0; k < nrows; k++ )
+  {
+    if (_items[k] == highlighted)
+    {
+      setHighlight(k);
+      break;
+    }
+  }
+}
+
+/*******************************************************************************
+
+Computes sort keys again for SlackBuilds that have changed, then sorts again
+
+*******************************************************************************/
+void BuildTableBox::updateBuilds(const std::vector<BuildListItem *> & changed)
+{
+  unsigned int i, nchanged;
+  std::unordered_map<BuildListItem *, unsigned int>::const_iterator it;
+
+  nchanged = changed.size();
+  if (nchanged == 0) { return; }
+  for ( i = 0; i < nchanged; i++ )
+  {
+    it = _row_index.find(changed[i]);
+    if (it == _row_index.end()) { continue; }
+    setLocalKeys(_rows[it->second]);
+    setRepoKeys(_rows[it->second]);
+  }
+  reorder();
+}
+
+/*******************************************************************************
+
+Sorts by a column. Sorting by the same column again reverses the order.
+
+*******************************************************************************/
+void BuildTableBox::sortBy(column col)
+{
+  if (col == _sort_column) { _descending = ! _descending; }
+  else
+  {
+    _sort_column = col;
+    _descending = false;
+  }
+  reorder();
+}
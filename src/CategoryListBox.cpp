@@ -4,6 +4,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "BuildListItem.h"
 #include "BuildListBox.h"
 #include "CategoryListBox.h"
@@ -66,7 +67,7 @@ void CategoryListBox::redrawFrame()
   // Draw header
 
   wmove(_win, 1, 1);
-  colors.turnOn(_win, "header", "bg_normal");
+  colors.turnOn(_win, color::header, color::bg_normal);
   printToEol("Name");
   colors.turnOff(_win);
   wmove(_win, 2, 1);
@@ -86,44 +87,39 @@ screen or not.
 *******************************************************************************/
 void CategoryListBox::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
+  chtype attr, fallback;
+  int cols;
 
-  // Go to item location, optionally highlight, and print item
+  cols = getmaxx(_win);
 
-  wmove(_win, idx-_firstprint+_header_rows, 1);
-
-  // Turn on highlight color
+  // Attributes for item: tagged items are bold if colors are not available
 
+  fallback = A_NORMAL;
+  if (_items[idx]->getBoolProp("tagged")) { fallback = A_BOLD; }
   if (int(idx) == _highlight)
   {
     if (_activated) 
     { 
-      if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-      else { fg = "fg_highlight_active"; }
-      bg = "bg_highlight_active"; 
+      if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+      else { fg = color::fg_highlight_active; }
+      bg = color::bg_highlight_active; 
+      fallback |= A_REVERSE;
     }
     else
     {
-      if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-      else { fg = "fg_highlight_inactive"; }
-      bg = "bg_highlight_inactive"; 
-    }
-    if (colors.turnOn(_win, fg, bg) != 0)
-    { 
-      if (_activated) { wattron(_win, A_REVERSE); }
-      if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); }
+      if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+      else { fg = color::fg_highlight_inactive; }
+      bg = color::bg_highlight_inactive; 
     }
   } 
   else
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_normal"; }
-    bg = "bg_normal";
-    if (colors.turnOn(_win, fg, bg) != 0)
-    {
-      if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); }
-    }
+    if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+    else { fg = color::fg_normal; }
+    bg = color::bg_normal;
   }
+  attr = colorAttributes(fg, bg, fallback);
 
   // Save highlight idx for redrawing later.
   // Note: prevents this method from being const.
@@ -132,15 +128,8 @@ void CategoryListBox::redrawSingleItem(unsigned int idx)
 
   // Print item
 
-  printToEol(_items[idx]->name());
-
-  // Turn off highlight color
-
-  if (colors.turnOff(_win) != 0)
-  {
-    if ( (int(idx) == _highlight) && _activated ) { wattroff(_win, A_REVERSE); }
-    if (_items[idx]->getBoolProp("tagged")) { wattroff(_win, A_BOLD); }
-  }
+  printRow(idx, idx-_firstprint+_header_rows, 1, cols-2, _items[idx]->name(),
+           -1, attr, attr);
 }
 
 /*******************************************************************************
@@ -184,10 +173,10 @@ as the one for BuildListBox, except that tagging doesn't highlight the next
 entry.
 
 *******************************************************************************/
-std::string CategoryListBox::exec(MouseEvent * mevent)
+Signal CategoryListBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -203,7 +192,7 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
@@ -211,97 +200,80 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
     case '\r':
     case KEY_ENTER:
       retval = signals::keyEnter;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Left/right arrows
 
     case KEY_LEFT:
       retval = signals::keyLeft;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
     case KEY_RIGHT:
       retval = signals::keyRight;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
 
     case KEY_UP:
-      retval = signals::highlight;
-      check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_DOWN:
-      retval = signals::highlight;
-      check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_PPAGE:
-      retval = signals::highlight;
-      check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_NPAGE:
       retval = signals::highlight;
-      check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      _redraw_type = moveHighlight(ch);
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // t or T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // F9 key: activates menubar
 
     case KEY_F(9):
       retval = signals::keyF9;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Mouse
@@ -310,7 +282,7 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
         retval = signals::mouseEvent;
       }
       else
@@ -319,7 +291,7 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
       break;
   }
   return retval;
@@ -55,19 +55,15 @@ int Color::ncursesColor(const std::string & basename) const
 Constructor
 
 *******************************************************************************/
-Color::Color()
-{ 
-  _colors.resize(0); 
-  _active_pair = -1;
-}
+Color::Color() { clear(); }
 
 /*******************************************************************************
 
 Create color pair by foreground & background colors
 
 *******************************************************************************/
-void Color::addPair(const std::string & fg_label, const std::string & fg_name,
-                    const std::string & bg_label, const std::string & bg_name)
+void Color::addPair(color::label fg_label, const std::string & fg_name,
+                    color::label bg_label, const std::string & bg_name)
 {
   color_entry fg_entry, bg_entry;
   color_pair pair;
@@ -115,6 +111,7 @@ void Color::addPair(const std::string & fg_label, const std::string & fg_name,
     else { bg_color += 8; }
   }
   _colors.push_back(pair);
+  _table[fg_label][bg_label] = npairs-1;
 
   init_pair(pair.idx, fg_color, bg_color);
 }
@@ -125,22 +122,14 @@ Get color pair from foreground and background labels. Returns index in the
 _colors vector or -1 if not found.
 
 *******************************************************************************/
-int Color::getPair(const std::string & fg_label,
-                   const std::string & bg_label) const
+int Color::getPair(color::label fg_label, color::label bg_label) const
 {
-  int i, npairs, vec_idx;
+  int vec_idx;
 
-  npairs = _colors.size();
-  vec_idx = -1;
-  for ( i = 0; i < npairs; i++ )
-  {
-    if ( (_colors[i].fg.label == fg_label) &&
-         (_colors[i].bg.label == bg_label) ) 
-    { 
-      vec_idx = i;
-      break;
-    }
-  }
+  if ( (fg_label < 0) || (fg_label >= color::nlabels) ||
+       (bg_label < 0) || (bg_label >= color::nlabels) ) { return -1; }
+  vec_idx = _table[fg_label][bg_label];
+  if (vec_idx >= int(_colors.size())) { return -1; }
 
   return vec_idx;
 }
@@ -176,11 +165,29 @@ bool Color::pairBlinks(int vec_idx) const
 
 /*******************************************************************************
 
+Gets the attributes (color pair, bold, and blink) that turning on a pair would
+set, for drawing characters with their attributes built in. Returns 0 on
+success or 1 for an invalid pair.
+
+*******************************************************************************/
+int Color::getAttributes(int vec_idx, chtype & attr) const
+{
+  if ( (vec_idx == -1) || (vec_idx >= int(_colors.size())) ) { return 1; }
+
+  attr = COLOR_PAIR(_colors[vec_idx].idx);
+  if (_colors[vec_idx].use_bold) { attr |= A_BOLD; }
+  if (_colors[vec_idx].use_blink) { attr |= A_BLINK; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
 Turn color on or off
 
 *******************************************************************************/
-int Color::turnOn(WINDOW *win, const std::string & fg_label,
-                  const std::string & bg_label)
+int Color::turnOn(WINDOW *win, color::label fg_label,
+                  color::label bg_label)
 {
   color_pair mypair;
 
@@ -234,8 +241,8 @@ int Color::turnOff(WINDOW *win)
   return 0;
 }
 
-int Color::setBackground(WINDOW *win, const std::string & fg_label,
-                         const std::string & bg_label) const
+int Color::setBackground(WINDOW *win, color::label fg_label,
+                         color::label bg_label) const
 {
   color_pair mypair;
   int vec_idx;
@@ -276,6 +283,12 @@ Clears all colors
 *******************************************************************************/
 void Color::clear()
 {
+  int i, j;
+
   _colors.resize(0);
   _active_pair = -1;
+  for ( i = 0; i < color::nlabels; i++ )
+  {
+    for ( j = 0; j < color::nlabels; j++ ) { _table[i][j] = -1; }
+  }
 }
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <vector>
 #include <curses.h>
 #include <libconfig.h++>
 #include "Color.h"
@@ -7,6 +8,46 @@
 
 using namespace libconfig;
 
+/* Names of colors in theme files, in the order given by colorVars */
+
+static const char *color_names[] = {
+  "fg_normal", "bg_normal", "fg_title", "bg_title", "fg_info", "bg_info",
+  "fg_highlight_active", "bg_highlight_active", "fg_highlight_inactive",
+  "bg_highlight_inactive", "header", "header_popup", "tagged", "fg_popup",
+  "bg_popup", "fg_warning", "bg_warning", "hotkey", "fg_combobox",
+  "bg_combobox"
+};
+
+/*******************************************************************************
+
+Pointers to each color setting, in the same order as color_names
+
+*******************************************************************************/
+void ColorTheme::colorVars(std::vector<std::string *> & vars)
+{
+  vars.resize(0);
+  vars.push_back(&_fg_normal);
+  vars.push_back(&_bg_normal);
+  vars.push_back(&_fg_title);
+  vars.push_back(&_bg_title);
+  vars.push_back(&_fg_info);
+  vars.push_back(&_bg_info);
+  vars.push_back(&_fg_highlight_active);
+  vars.push_back(&_bg_highlight_active);
+  vars.push_back(&_fg_highlight_inactive);
+  vars.push_back(&_bg_highlight_inactive);
+  vars.push_back(&_header);
+  vars.push_back(&_header_popup);
+  vars.push_back(&_tagged);
+  vars.push_back(&_fg_popup);
+  vars.push_back(&_bg_popup);
+  vars.push_back(&_fg_warning);
+  vars.push_back(&_bg_warning);
+  vars.push_back(&_hotkey);
+  vars.push_back(&_fg_combobox);
+  vars.push_back(&_bg_combobox);
+}
+
 /*******************************************************************************
 
 Constructors
@@ -86,7 +127,6 @@ int ColorTheme::read(const std::string & color_theme_file)
   Config color_cfg;
   unsigned int i, nsettings;
   int retval;
-  std::vector<std::string> color_names;
   std::vector<std::string *> color_vars;
   const std::string missing_msg = " color not found.";
 
@@ -115,49 +155,9 @@ int ColorTheme::read(const std::string & color_theme_file)
     return 3;
   }
 
-  // Store settings in vectors so we can read them in a loop
-
-  color_vars.push_back(&_fg_normal);
-  color_vars.push_back(&_bg_normal);
-  color_vars.push_back(&_fg_title);
-  color_vars.push_back(&_bg_title);
-  color_vars.push_back(&_fg_info);
-  color_vars.push_back(&_bg_info);
-  color_vars.push_back(&_fg_highlight_active);
-  color_vars.push_back(&_bg_highlight_active);
-  color_vars.push_back(&_fg_highlight_inactive);
-  color_vars.push_back(&_bg_highlight_inactive);
-  color_vars.push_back(&_header);
-  color_vars.push_back(&_header_popup);
-  color_vars.push_back(&_tagged);
-  color_vars.push_back(&_fg_popup);
-  color_vars.push_back(&_bg_popup);
-  color_vars.push_back(&_fg_warning);
-  color_vars.push_back(&_bg_warning);
-  color_vars.push_back(&_hotkey);
-  color_vars.push_back(&_fg_combobox);
-  color_vars.push_back(&_bg_combobox);
-
-  color_names.push_back("fg_normal");
-  color_names.push_back("bg_normal");
-  color_names.push_back("fg_title");
-  color_names.push_back("bg_title");
-  color_names.push_back("fg_info");
-  color_names.push_back("bg_info");
-  color_names.push_back("fg_highlight_active");
-  color_names.push_back("bg_highlight_active");
-  color_names.push_back("fg_highlight_inactive");
-  color_names.push_back("bg_highlight_inactive");
-  color_names.push_back("header");
-  color_names.push_back("header_popup");
-  color_names.push_back("tagged");
-  color_names.push_back("fg_popup");
-  color_names.push_back("bg_popup");
-  color_names.push_back("fg_warning");
-  color_names.push_back("bg_warning");
-  color_names.push_back("hotkey");
-  color_names.push_back("fg_combobox");
-  color_names.push_back("bg_combobox");
+  // Settings are read in a loop
+
+  colorVars(color_vars);
 
   // Try to read inputs, but stop if there is a problem
 
@@ -167,7 +167,8 @@ int ColorTheme::read(const std::string & color_theme_file)
   {
     if (! color_cfg.lookupValue(color_names[i], *color_vars[i]))
     {
-      std::cerr << "Error: '" + color_names[i] + "'" + missing_msg << std::endl;
+      std::cerr << "Error: '" << color_names[i] << "'" << missing_msg
+                << std::endl;
       retval = 3;
       break;
     }
@@ -178,37 +179,79 @@ int ColorTheme::read(const std::string & color_theme_file)
 
 /*******************************************************************************
 
-Sets UI colors from theme
+Gets or sets all colors at once, in a fixed order. setColors returns 1 if the
+wrong number of colors is given or 0 on success.
+
+*******************************************************************************/
+void ColorTheme::getColors(std::vector<std::string> & colors) const
+{
+  std::vector<std::string *> vars;
+  unsigned int i, nvars;
+
+  // colorVars only gives pointers; nothing is changed here
+
+  const_cast<ColorTheme *>(this)->colorVars(vars);
+  nvars = vars.size();
+  colors.resize(nvars);
+  for ( i = 0; i < nvars; i++ ) { colors[i] = *vars[i]; }
+}
+
+int ColorTheme::setColors(const std::vector<std::string> & colors)
+{
+  std::vector<std::string *> vars;
+  unsigned int i, nvars;
+
+  colorVars(vars);
+  nvars = vars.size();
+  if (colors.size() != nvars) { return 1; }
+  for ( i = 0; i < nvars; i++ ) { *vars[i] = colors[i]; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Sets UI colors from theme. The color pairs and label table are built in a new
+Color object and then swapped in all at once, so nothing ever draws with a
+half-built table.
 
 *******************************************************************************/
 void ColorTheme::applyTheme(Color & colors) const
 {
+  Color newcolors;
+
   start_color();
-  colors.clear();
-  colors.addPair("fg_normal", _fg_normal, "bg_normal", _bg_normal);
-  colors.addPair("fg_title", _fg_title, "bg_title", _bg_title);
-  colors.addPair("fg_info", _fg_info, "bg_info", _bg_info);
-  colors.addPair("fg_highlight_active", _fg_highlight_active,
-                 "bg_highlight_active", _bg_highlight_active);
-  colors.addPair("fg_highlight_inactive", _fg_highlight_inactive,
-                 "bg_highlight_inactive", _bg_highlight_inactive);
-  colors.addPair("header", _header, "bg_normal", _bg_normal); 
-  colors.addPair("header_popup", _header_popup, "bg_popup", _bg_popup); 
-  colors.addPair("fg_popup", _fg_popup, "bg_popup", _bg_popup); 
-  colors.addPair("tagged", _tagged, "bg_normal", _bg_normal); 
-  colors.addPair("tagged", _tagged, "bg_highlight_active",_bg_highlight_active);
-  colors.addPair("tagged", _tagged,
-                 "bg_highlight_inactive",_bg_highlight_inactive); 
-  colors.addPair("tagged", _tagged, "bg_popup", _bg_popup); 
-  colors.addPair("fg_warning", _fg_warning, "bg_warning", _bg_warning);
-  colors.addPair("bg_warning", _bg_warning, "fg_warning", _fg_warning);
-  colors.addPair("hotkey", _hotkey, "bg_normal", _bg_normal); 
-  colors.addPair("hotkey", _hotkey, "bg_popup", _bg_popup); 
-  colors.addPair("hotkey", _hotkey, "bg_highlight_active",_bg_highlight_active);
-  colors.addPair("hotkey", _hotkey,
-                 "bg_highlight_inactive",_bg_highlight_inactive); 
-  colors.addPair("fg_combobox", _fg_combobox, "bg_combobox", _bg_combobox); 
-  colors.addPair("hotkey", _hotkey, "bg_combobox", _bg_combobox);
-  colors.addPair("hotkey", _hotkey, "bg_title", _bg_title);
-  colors.setBackground(stdscr, "fg_normal", "bg_normal");
+  newcolors.addPair(color::fg_normal, _fg_normal, color::bg_normal, _bg_normal);
+  newcolors.addPair(color::fg_title, _fg_title, color::bg_title, _bg_title);
+  newcolors.addPair(color::fg_info, _fg_info, color::bg_info, _bg_info);
+  newcolors.addPair(color::fg_highlight_active, _fg_highlight_active,
+                    color::bg_highlight_active, _bg_highlight_active);
+  newcolors.addPair(color::fg_highlight_inactive, _fg_highlight_inactive,
+                    color::bg_highlight_inactive, _bg_highlight_inactive);
+  newcolors.addPair(color::header, _header, color::bg_normal, _bg_normal);
+  newcolors.addPair(color::header_popup, _header_popup,
+                    color::bg_popup, _bg_popup);
+  newcolors.addPair(color::fg_popup, _fg_popup, color::bg_popup, _bg_popup);
+  newcolors.addPair(color::tagged, _tagged, color::bg_normal, _bg_normal);
+  newcolors.addPair(color::tagged, _tagged,
+                    color::bg_highlight_active, _bg_highlight_active);
+  newcolors.addPair(color::tagged, _tagged,
+                    color::bg_highlight_inactive, _bg_highlight_inactive);
+  newcolors.addPair(color::tagged, _tagged, color::bg_popup, _bg_popup);
+  newcolors.addPair(color::fg_warning, _fg_warning,
+                    color::bg_warning, _bg_warning);
+  newcolors.addPair(color::bg_warning, _bg_warning,
+                    color::fg_warning, _fg_warning);
+  newcolors.addPair(color::hotkey, _hotkey, color::bg_normal, _bg_normal);
+  newcolors.addPair(color::hotkey, _hotkey, color::bg_popup, _bg_popup);
+  newcolors.addPair(color::hotkey, _hotkey,
+                    color::bg_highlight_active, _bg_highlight_active);
+  newcolors.addPair(color::hotkey, _hotkey,
+                    color::bg_highlight_inactive, _bg_highlight_inactive);
+  newcolors.addPair(color::fg_combobox, _fg_combobox,
+                    color::bg_combobox, _bg_combobox);
+  newcolors.addPair(color::hotkey, _hotkey, color::bg_combobox, _bg_combobox);
+  newcolors.addPair(color::hotkey, _hotkey, color::bg_title, _bg_title);
+  colors = newcolors;
+  colors.setBackground(stdscr, color::fg_normal, color::bg_normal);
 }
@@ -4,6 +4,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "ListItem.h"
 #include "InputItem.h"
 #include "InputBox.h"
@@ -47,10 +48,10 @@ void ComboBox::placeListBox(int y_offset)
 User interaction with list
 
 *******************************************************************************/
-std::string ComboBox::execList(int y_offset, MouseEvent * mevent)
+Signal ComboBox::execList(int y_offset, MouseEvent * mevent)
 {
   int rows, cols, left, top;
-  std::string retval;
+  Signal retval;
 
   placeListBox(y_offset);
   retval = _list.exec(mevent);
@@ -60,7 +61,7 @@ std::string ComboBox::execList(int y_offset, MouseEvent * mevent)
   top = std::floor(double(rows)/2.);
   mvwin(_listwin, top, left);
   wresize(_listwin, 0, 0);
-  wrefresh(_listwin);
+  wnoutrefresh(_listwin);
   _parent->draw(true);
 
   return retval;
@@ -74,7 +75,7 @@ Constructor and destructor
 ComboBox::ComboBox()
 { 
   _parent = NULL;
-  _redraw_type = "box"; _item_type = "ComboBox";
+  _redraw_type = redraw::box; _item_type = "ComboBox";
   _selectable = true;
   _listwin = newwin(1, 1, 0, 0); 
   _list.setWindow(_listwin);
@@ -83,7 +84,7 @@ ComboBox::ComboBox()
 ComboBox::ComboBox(InputBox *parent)
 { 
   _parent = parent;
-  _redraw_type = "box"; _item_type = "ComboBox";
+  _redraw_type = redraw::box; _item_type = "ComboBox";
   _selectable = true;
   _listwin = newwin(1, 1, 0, 0); 
   _list.setWindow(_listwin);
@@ -126,7 +127,7 @@ void ComboBox::setChoice(const std::string & choice)
 Handles mouse event
 
 *******************************************************************************/
-std::string ComboBox::handleMouseEvent(MouseEvent * mevent, int y_offset)
+Signal ComboBox::handleMouseEvent(MouseEvent * mevent, int y_offset)
 {
   int begy, begx, ycurs, xcurs;
 
@@ -164,10 +165,11 @@ void ComboBox::draw(int y_offset, bool force, bool highlight)
 
   if (highlight)
   {
-    if (colors.turnOn(_win, "fg_highlight_active", "bg_highlight_active") != 0)
+    if (colors.turnOn(_win, color::fg_highlight_active,
+                       color::bg_highlight_active) != 0)
       wattron(_win, A_REVERSE);
   }
-  else { colors.turnOn(_win, "fg_combobox", "bg_combobox"); }
+  else { colors.turnOn(_win, color::fg_combobox, color::bg_combobox); }
 
   // Print selection and indicator
 
@@ -181,7 +183,7 @@ void ComboBox::draw(int y_offset, bool force, bool highlight)
   {
     if (highlight) { wattroff(_win, A_REVERSE); }
   }
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -189,11 +191,11 @@ void ComboBox::draw(int y_offset, bool force, bool highlight)
 User interaction: returns key stroke
 
 *******************************************************************************/
-std::string ComboBox::exec(int y_offset, MouseEvent * mevent)
+Signal ComboBox::exec(int y_offset, MouseEvent * mevent)
 {
   int ch;
   bool getting_input;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -209,7 +211,7 @@ std::string ComboBox::exec(int y_offset, MouseEvent * mevent)
     
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
 
       // Enter key: return Enter signal
 
@@ -25,7 +25,7 @@ screen or not.
 *******************************************************************************/
 void ComboBoxList::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
   int rows, cols, rowsavail, lastrow;
 
   getmaxyx(_win, rows, cols);
@@ -42,20 +42,20 @@ void ComboBoxList::redrawSingleItem(unsigned int idx)
   {
     if (_activated) 
     { 
-      fg = "fg_highlight_active"; 
-      bg = "bg_highlight_active"; 
+      fg = color::fg_highlight_active; 
+      bg = color::bg_highlight_active; 
     }
     else
     {
-      fg = "fg_highlight_inactive"; 
-      bg = "bg_highlight_inactive"; 
+      fg = color::fg_highlight_inactive; 
+      bg = color::bg_highlight_inactive; 
     }
     if (colors.turnOn(_win, fg, bg) != 0)
     { 
       if (_activated) { wattron(_win, A_REVERSE); }
     }
   } 
-  else { colors.turnOn(_win, "fg_combobox", "bg_combobox"); }
+  else { colors.turnOn(_win, color::fg_combobox, color::bg_combobox); }
 
   // Save highlight idx for redrawing later.
   // Note: prevents this method from being const.
@@ -117,7 +117,7 @@ void ComboBoxList::clearList()
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 /*******************************************************************************
@@ -154,20 +154,19 @@ Draws box (frame, items, etc.) as needed
 *******************************************************************************/
 void ComboBoxList::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
   // Draw list elements
 
-  if (_redraw_type == "all")
+  if (_redraw_type == redraw::all)
   {
     clearWindow();
-    colors.setBackground(_win, "fg_combobox", "bg_combobox");
+    colors.setBackground(_win, color::fg_combobox, color::bg_combobox);
   }
-  if (_redraw_type != "none") { redrawFrame(); }
-  if ( (_redraw_type == "all") || (_redraw_type == "items") ) {
-                                                            redrawAllItems(); }
-  else if (_redraw_type == "changed") { redrawChangedItems(); }
-  wrefresh(_win);
+  if (_redraw_type != redraw::none) { redrawFrame(); }
+  if (_redraw_type & redraw::items) { redrawAllItems(); }
+  else if (_redraw_type == redraw::changed) { redrawChangedItems(); }
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -175,9 +174,9 @@ void ComboBoxList::draw(bool force)
 Handles mouse event
 
 *******************************************************************************/
-std::string ComboBoxList::handleMouseEvent(MouseEvent * mevent)
+Signal ComboBoxList::handleMouseEvent(MouseEvent * mevent)
 {
-  std::string retval;
+  Signal retval;
 
   // Use method from ListBox, but return keyEnter when item is selected
 
@@ -186,8 +185,9 @@ std::string ComboBoxList::handleMouseEvent(MouseEvent * mevent)
   {
     // Redraw and pause for .1 seconds to make button selection visible
 
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     draw();
+    doupdate();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     retval = signals::keyEnter;
   }
@@ -167,12 +167,12 @@ CursesWidget::CursesWidget()
   _button_left.resize(0);
   _button_right.resize(0);
   _button_signals.resize(0);
-  _button_bg = "bg_highlight_active";
-  _button_fg = "fg_highlight_active";
-  _fg_color = "fg_normal";
-  _bg_color = "bg_normal";
+  _button_bg = color::bg_highlight_active;
+  _button_fg = color::fg_highlight_active;
+  _fg_color = color::fg_normal;
+  _bg_color = color::bg_normal;
   _highlighted_button = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 /*******************************************************************************
@@ -183,7 +183,7 @@ Set attributes
 void CursesWidget::setWindow(WINDOW *win) { _win = win; }
 
 void CursesWidget::addButton(const std::string & button,
-                             const std::string & signal)
+                             const Signal & signal)
 {
   _buttons.push_back(button);
   _button_signals.push_back(signal);
@@ -204,7 +204,7 @@ void CursesWidget::clearButtons()
 }
 
 void CursesWidget::setButtons(const std::vector<std::string> & buttons,
-                              const std::vector<std::string> & button_signals)
+                              const std::vector<Signal> & button_signals)
 {
   clearButtons();
   _buttons = buttons;
@@ -214,15 +214,14 @@ void CursesWidget::setButtons(const std::vector<std::string> & buttons,
   _highlighted_button = 0;
 }
 
-void CursesWidget::setButtonColor(const std::string & button_fg,
-                                  const std::string & button_bg)
+void CursesWidget::setButtonColor(color::label button_fg,
+                                  color::label button_bg)
 {
   _button_fg = button_fg;
   _button_bg = button_bg;
 }
 
-void CursesWidget::setColor(const std::string & fg_color,
-                            const std::string & bg_color)
+void CursesWidget::setColor(color::label fg_color, color::label bg_color)
 {
   _fg_color = fg_color;
   _bg_color = bg_color;
@@ -274,8 +273,8 @@ void CursesWidget::placePopup(CursesWidget *popup, WINDOW *win) const
 
 int CursesWidget::highlightedButton() const { return _highlighted_button; }
 
-const std::string & CursesWidget::fgColor() const { return _fg_color; }
-const std::string & CursesWidget::bgColor() const { return _bg_color; }
+color::label CursesWidget::fgColor() const { return _fg_color; }
+color::label CursesWidget::bgColor() const { return _bg_color; }
 
 /*******************************************************************************
 
@@ -4,6 +4,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "DirListing.h"
 #include "ListItem.h"
 #include "SelectionBox.h"
@@ -18,7 +19,7 @@ screen or not.
 *******************************************************************************/
 void DirListBox::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
 
   // Go to item location, optionally highlight, and print item
 
@@ -30,13 +31,13 @@ void DirListBox::redrawSingleItem(unsigned int idx)
   {
     if (_activated) 
     { 
-      fg = "fg_highlight_active"; 
-      bg = "bg_highlight_active"; 
+      fg = color::fg_highlight_active; 
+      bg = color::bg_highlight_active; 
     }
     else
     {
-      fg = "fg_highlight_inactive"; 
-      bg = "bg_highlight_inactive"; 
+      fg = color::fg_highlight_inactive; 
+      bg = color::bg_highlight_inactive; 
     }
     if (colors.turnOn(_win, fg, bg) != 0)
     { 
@@ -111,7 +112,8 @@ Constructors and destructor
 *******************************************************************************/
 DirListBox::DirListBox()
 {
-  std::vector<std::string> buttons(2), button_signals(2);
+  std::vector<std::string> buttons(2);
+  std::vector<Signal> button_signals(2);
 
   _reserved_rows = 6;
   _header_rows = 3;
@@ -127,7 +129,8 @@ DirListBox::DirListBox()
 
 DirListBox::DirListBox(WINDOW *win, const std::string & name)
 {
-  std::vector<std::string> buttons(2), button_signals(2);
+  std::vector<std::string> buttons(2);
+  std::vector<Signal> button_signals(2);
 
   _win = win;
   _name = name;
@@ -217,10 +220,10 @@ const std::string & DirListBox::directory() const { return _currentdir; }
 User interaction: display list of files that user can view
 
 *******************************************************************************/
-std::string DirListBox::exec(MouseEvent * mevent)
+Signal DirListBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   bool getting_input;
   MEVENT event;
 
@@ -240,7 +243,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
     // Get user input
   
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
   
       // Enter key: accept selection
   
@@ -249,7 +252,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
       case KEY_ENTER:
         if (_highlighted_button == 0)
         {
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           if (_items[_highlight]->getProp("type") == "dir")
           {
             if (_items[_highlight]->name() == "..") { navigateUp(); }
@@ -264,7 +267,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
         else
         {
           retval = signals::quit;
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           getting_input = false;
         }
         break;
@@ -273,53 +276,53 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
       case KEY_UP:
         check_redraw = highlightPrevious();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_DOWN:
         check_redraw = highlightNext();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_PPAGE:
         check_redraw = highlightPreviousPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_NPAGE:
         check_redraw = highlightNextPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_HOME:
         check_redraw = highlightFirst();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_END:
         check_redraw = highlightLast();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
 
       // Right/Left: change higlighted button
 
       case KEY_RIGHT:
         check_redraw = highlightNextButton();
-        if (check_redraw == 1) { _redraw_type = "buttons"; }
-        else { _redraw_type = "none"; }
+        if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+        else { _redraw_type = redraw::none; }
         break;
       case KEY_LEFT:
         check_redraw = highlightPreviousButton();
-        if (check_redraw == 1) { _redraw_type = "buttons"; }
-        else { _redraw_type = "none"; }
+        if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+        else { _redraw_type = redraw::none; }
         break;
   
       // Resize signal
   
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
   
@@ -327,7 +330,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -340,7 +343,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
           retval = handleMouseEvent(mevent);
           if (retval == signals::keyEnter)
           {
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
             if (_items[_highlight]->getProp("type") == "dir")
             {
               if (_items[_highlight]->name() == "..") { navigateUp(); }
@@ -354,14 +357,14 @@ std::string DirListBox::exec(MouseEvent * mevent)
           }
           else if (retval == signals::quit)
           {
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
             getting_input = false;
           }
         }
         break;
 
       default:
-        _redraw_type = "none";
+        _redraw_type = redraw::none;
         break;
     }
   }
@@ -65,7 +65,7 @@ void HelpWindow::redrawFrame()
   // Draw header
 
   wmove(_win, 1, 1);
-  colors.turnOn(_win, "header", "bg_normal");
+  colors.turnOn(_win, color::header, color::bg_normal);
   wprintw(_win, "%s", _leftlabel.c_str());
   colors.turnOff(_win);
 
@@ -73,7 +73,7 @@ void HelpWindow::redrawFrame()
   nspaces = vlineloc - _leftlabel.size();
   for ( i = 0; i < nspaces; i++ ) { waddch(_win, ' '); }
 
-  colors.turnOn(_win, "header", "bg_normal");
+  colors.turnOn(_win, color::header, color::bg_normal);
   printToEol(" " + _rightlabel);
   wmove(_win, 2, 1);
   colors.turnOff(_win);
@@ -304,7 +304,7 @@ void InputBox::redrawFrame()
   left = std::floor(mid - double(msglen)/2.0) + 1;
   wmove(_win, 1, 1);
   wclrtoeol(_win);
-  if (colors.turnOn(_win, "fg_title", "bg_title") != 0)
+  if (colors.turnOn(_win, color::fg_title, color::bg_title) != 0)
     wattron(_win, A_BOLD);
   printSpaces(left-1);
   printToEol(_msg);
@@ -475,7 +475,7 @@ InputBox::InputBox()
   _msg = "";
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
   _highlight = 0;
   _prevhighlight = 0;
   _reserved_rows = 6;
@@ -493,7 +493,7 @@ InputBox::InputBox(WINDOW *win, const std::string & msg)
   _msg = msg;
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
   _highlight = 0;
   _prevhighlight = 0;
   _reserved_rows = 6;
@@ -633,7 +633,7 @@ unsigned int InputBox::numItems() const { return _items.size(); }
 Handles mouse events
 
 *******************************************************************************/
-std::string InputBox::handleMouseEvent(MouseEvent * mevent)
+Signal InputBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs, xcurs, rowsavail, y_offset, ybox;
   int check_redraw;
@@ -664,8 +664,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           draw();
+          doupdate();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -689,9 +690,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
           return signals::highlight;
         }
         else
@@ -703,9 +704,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
           return signals::highlight;
         }
         else
@@ -717,9 +718,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = highlightFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
         else
-          _redraw_type = "changed";
+          _redraw_type = redraw::changed;
         return signals::highlight;
       }
     }
@@ -741,7 +742,7 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
           {
             _prevhighlight = _highlight;
             _highlight = i;
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
             draw();
             return _items[_highlight]->handleMouseEvent(mevent, y_offset);
           }
@@ -757,18 +758,18 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = highlightPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
     return signals::highlight;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = highlightNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
     return signals::highlight;
   }
   else
@@ -782,13 +783,13 @@ Redraws box and all input items
 *******************************************************************************/
 void InputBox::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
-  if (_redraw_type == "all") 
+  if (_redraw_type == redraw::all) 
   { 
     clearWindow();
     if (_color_idx == -1)
-      colors.setBackground(_win, "fg_popup", "bg_popup");
+      colors.setBackground(_win, color::fg_popup, color::bg_popup);
     else { colors.setBackground(_win, _color_idx); }
     redrawFrame();
     if (_has_scroll_indicator) { redrawScrollIndicator(); }
@@ -796,14 +797,14 @@ void InputBox::draw(bool force)
   }
   else
   {
-    if (_redraw_type == "buttons") { redrawButtons(); }
+    if (_redraw_type == redraw::buttons) { redrawButtons(); }
     else
     {
       redrawChangedItems(force);
       if (_has_scroll_indicator) { redrawScrollIndicator(); }
     }
   }
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -812,16 +813,16 @@ Handles response from InputItem. Broken out here so that it is easier to modify
 in derived classes.
 
 *******************************************************************************/
-std::string InputBox::handleInput(std::string & selection, bool & getting_input,
-                                  bool & needs_selection, MouseEvent * mevent)
+Signal InputBox::handleInput(Signal & selection, bool & getting_input,
+                             bool & needs_selection, MouseEvent * mevent)
 {
-  std::string retval;
+  Signal retval;
   int check_redraw;
 
   retval = selection;
   if (selection == signals::resize)
   {
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     getting_input = false;
   }
   else if (selection == signals::keyEnter)
@@ -830,50 +831,50 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
       retval = _button_signals[_highlighted_button];
     else
       retval = signals::keyEnter;
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     getting_input = false;
   }
   else if ( (selection == signals::quit) ||
             (selection == signals::keySpace) )
   {
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     getting_input = false;
   }
   else if (selection == signals::highlightFirst)
   { 
-    if (highlightFirst() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightFirst() == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::highlightLast) 
   { 
-    if (highlightLast() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightLast() == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::highlightPrevPage)
   {
-    if (highlightPreviousPage() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightPreviousPage() == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::highlightNextPage)
   {
-    if (highlightNextPage() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightNextPage() == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::highlightPrev)
   { 
     if (_highlight == _first_selectable)
       check_redraw = highlightFirst();
     else { check_redraw = highlightPrevious(); }
-    if (check_redraw == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (check_redraw == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::highlightNext)
   {
     if (_highlight == _last_selectable)
       check_redraw = highlightLast();
     else { check_redraw = highlightNext(); }
-    if (check_redraw == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (check_redraw == 1) { _redraw_type = redraw::all; }
+    else { _redraw_type = redraw::changed; }
   }
   else if (selection == signals::mouseEvent)
   {
@@ -889,23 +890,23 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
       needs_selection = false;
       getting_input = true;
     }
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
   }
   else if (selection == signals::keyRight)
   {
     check_redraw = highlightNextButton();
-    if (check_redraw == 1) { _redraw_type = "buttons"; }
-    else { _redraw_type = "none"; }
+    if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+    else { _redraw_type = redraw::none; }
   }
   else if (selection == signals::keyLeft)
   {
     check_redraw = highlightPreviousButton();
-    if (check_redraw == 1) { _redraw_type = "buttons"; }
-    else { _redraw_type = "none"; }
+    if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+    else { _redraw_type = redraw::none; }
   }
   else
   {
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     getting_input = false;
   }
 
@@ -917,11 +918,11 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
 User interaction with input items in the box
 
 *******************************************************************************/
-std::string InputBox::exec(MouseEvent * mevent)
+Signal InputBox::exec(MouseEvent * mevent)
 {
   bool getting_input, needs_selection;
   int y_offset;
-  std::string selection, retval;
+  Signal selection, retval;
 
   getting_input = true;
   needs_selection = true;
@@ -930,7 +931,7 @@ std::string InputBox::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _redraw_type = redraw::changed;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
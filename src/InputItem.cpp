@@ -55,7 +55,7 @@ InputItem::InputItem()
   _posy = 0;
   _width = 0;
   _name = "";
-  _redraw_type = "none";
+  _redraw_type = redraw::none;
   _item_type = "none";
   _selectable = true;
   _auto_position = true;
@@ -102,7 +102,7 @@ non-selectable InputItems (e.g., labels) don't have to implement it. Selectable
 classes should reimplement this.
 
 *******************************************************************************/
-std::string InputItem::exec(int y_offset, MouseEvent * mevent) { return ""; }
+Signal InputItem::exec(int y_offset, MouseEvent * mevent) { return ""; }
 
 /*******************************************************************************
 
@@ -8,6 +8,7 @@
 #include "settings.h"
 #include "string_util.h"
 #include "signals.h"
+#include "input.h"
 #include "requirements.h"
 #include "backend.h"
 #include "BuildListItem.h"
@@ -34,7 +35,7 @@ void InstallBox::redrawFrame()
   left = std::floor(mid - double(namelen)/2.0);
   right = left + namelen;
   wmove(_win, 0, left);
-  if (colors.turnOn(_win, "fg_title", "bg_title") != 0)
+  if (colors.turnOn(_win, color::fg_title, color::bg_title) != 0)
     wattron(_win, A_BOLD);
   wprintw(_win, "%s", _name.c_str());
   if (colors.turnOff(_win) != 0)
@@ -75,7 +76,7 @@ void InstallBox::redrawFrame()
   // Draw header
 
   wmove(_win, 1, 1);
-  colors.turnOn(_win, "header_popup", "bg_popup");
+  colors.turnOn(_win, color::header_popup, color::bg_popup);
   wprintw(_win, "Name");
 
   nitems = _items.size();
@@ -123,7 +124,7 @@ screen or not.
 *******************************************************************************/
 void InstallBox::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
   int nspaces, actionlen, action_cols, vlineloc, printlen, rows, cols, i;
   unsigned int j, nitems;
 
@@ -150,9 +151,9 @@ void InstallBox::redrawSingleItem(unsigned int idx)
 
   if (int(idx) == _highlight)
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_highlight_active"; }
-    bg = "bg_highlight_active"; 
+    if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+    else { fg = color::fg_highlight_active; }
+    bg = color::bg_highlight_active; 
 
     if (colors.turnOn(_win, fg, bg) != 0)
     { 
@@ -162,9 +163,9 @@ void InstallBox::redrawSingleItem(unsigned int idx)
   } 
   else
   {
-    if (_items[idx]->getBoolProp("tagged")) { fg = "tagged"; }
-    else { fg = "fg_popup"; }
-    bg = "bg_popup";
+    if (_items[idx]->getBoolProp("tagged")) { fg = color::tagged; }
+    else { fg = color::fg_popup; }
+    bg = color::bg_popup;
     if (colors.turnOn(_win, fg, bg) != 0)
     {
       if (_items[idx]->getBoolProp("tagged")) { wattron(_win, A_BOLD); } 
@@ -212,7 +213,8 @@ Constructors
 *******************************************************************************/
 InstallBox::InstallBox()
 { 
-  std::vector<std::string> buttons(3), button_signals(3);
+  std::vector<std::string> buttons(3);
+  std::vector<Signal> button_signals(3);
 
   buttons[0] = "   Ok   ";
   buttons[1] = " Cancel ";
@@ -222,13 +224,15 @@ InstallBox::InstallBox()
   button_signals[2] = "a";
   setButtons(buttons, button_signals);
   _builds.resize(0);
+  _requested.resize(0);
   _ndeps = 0;
   _ninvdeps = 0;
 }
 
 InstallBox::InstallBox(WINDOW *win, const std::string & name)
 {
-  std::vector<std::string> buttons(3), button_signals(3);
+  std::vector<std::string> buttons(3);
+  std::vector<Signal> button_signals(3);
 
   buttons[0] = "   Ok   ";
   buttons[1] = " Cancel ";
@@ -238,6 +242,7 @@ InstallBox::InstallBox(WINDOW *win, const std::string & name)
   button_signals[2] = "a";
   setButtons(buttons, button_signals);
   _builds.resize(0);
+  _requested.resize(0);
   _ndeps = 0;
   _ninvdeps = 0;
   _win = win;
@@ -311,10 +316,12 @@ int InstallBox::numInvDeps() const { return _ninvdeps; }
 
 bool InstallBox::installingAllDeps() const
 {
-  int i;
+  unsigned int i, nbuilds;
 
-  for ( i = 0; i < _ndeps; i++ )
+  nbuilds = _builds.size() - _ninvdeps;
+  for ( i = 0; i < nbuilds; i++ )
   {
+    if (_requested[i]) { continue; }
     if ( ((_items[i]->getProp("action") != "Remove") &&
           (_items[i]->getProp("action") != "Reinstall")) &&
          (! _items[i]->getBoolProp("marked")) ) { return false; }
@@ -325,76 +332,106 @@ bool InstallBox::installingAllDeps() const
 
 bool InstallBox::installingRequested() const
 {
-  if ( (_items[_ndeps]->getProp("action") != "Remove") &&
-       (_items[_ndeps]->getBoolProp("marked")) ) { return true; }
-  else { return false; }
+  unsigned int i, nbuilds;
+
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if ( _requested[i] && (_items[i]->getProp("action") != "Remove") &&
+         (_items[i]->getBoolProp("marked")) ) { return true; }
+  }
+
+  return false;
+}
+
+/*******************************************************************************
+
+Adds marked changes to a queue of background jobs, in build order. Returns the
+number of jobs queued.
+
+*******************************************************************************/
+int InstallBox::queueChanges(JobQueue & jobs) const
+{
+  unsigned int nbuilds, i, batch;
+  int nqueued;
+
+  batch = jobs.newBatch();
+  nqueued = 0;
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (_builds[i]->getBoolProp("marked"))
+    {
+      if (jobs.add(_builds[i], _builds[i]->getProp("action"), batch) == 0)
+        nqueued++;
+    }
+  }
+
+  return nqueued;
+}
+
+/*******************************************************************************
+
+Predicts time to apply the marked changes from the build history. See
+BuildHistory::predict for the meaning of each time.
+
+*******************************************************************************/
+void InstallBox::predictTimes(unsigned int njobs, double & total,
+                              double & critical, double & parallel) const
+{
+  build_history.predict(_builds, njobs, total, critical, parallel);
 }
 
 /*******************************************************************************
 
-Creates list based on SlackBuild selected. Returns 0 if dependency resolution
-succeeded or 1 if some could not be found in the repository.
+Creates list based on the SlackBuilds selected. All requested SlackBuilds and
+their dependencies are merged into one build order, with each SlackBuild
+appearing once. Returns 0 if dependency resolution succeeded, 1 if some could
+not be found in the repository, or 2 if a .info file is missing.
 
 *******************************************************************************/
-int InstallBox::create(BuildListItem & build,
+int InstallBox::create(const std::vector<BuildListItem *> & builds,
                        std::vector<std::vector<BuildListItem> > & slackbuilds,
                        const std::string & action, bool resolve_deps,
-                       bool batch, bool rebuild_inv_deps) 
+                       bool rebuild_inv_deps) 
 {
   int check; 
-  unsigned int i, nbuilds;
-  bool mark;
+  unsigned int i, j, k, nreqs, nrequested, nbuilds, ninvreqs;
+  bool mark, requested, present;
   std::string action_applied;
-  std::string installed_version, available_version;
-  std::vector<BuildListItem *> reqlist;
-  std::vector<std::string> buttons, button_signals;
+  std::vector<BuildListItem *> reqlist, invreqlist;
+  std::vector<std::string> missing_info;
 
-  // Get list of reqs and/or add requested SlackBuild to list
+  // Get build order for requested SlackBuilds and their reqs
 
   check = 0;
-  _ndeps = 0;
-  reqlist.resize(0);
   if (resolve_deps)
-    check = compute_reqs_order(build, reqlist, slackbuilds);
-
-  _ndeps = reqlist.size();
-  reqlist.push_back(&build);
-
-  if (batch)
-  { 
-    buttons.resize(4);
-    button_signals.resize(4);
-    buttons[0] = "   Ok   ";
-    buttons[1] = "  Skip  ";
-    buttons[2] = " Cancel ";
-    buttons[3] = " Actions ";
-    button_signals[0] = signals::keyEnter;
-    button_signals[1] = signals::quit;
-    button_signals[2] = "c";
-    button_signals[3] = "a";
-  }
+    check = compute_reqs_order(builds, reqlist, slackbuilds);
   else
-  {
-    buttons.resize(3);
-    button_signals.resize(3);
-    buttons[0] = "   Ok   ";
-    buttons[1] = " Cancel ";
-    buttons[2] = " Actions ";
-    button_signals[0] = signals::keyEnter;
-    button_signals[1] = signals::quit;
-    button_signals[2] = "a";
-  }
-  setButtons(buttons, button_signals);
+    reqlist = builds;
+  ensure_repo_props(reqlist, missing_info);
 
   // Copy reqlist to _builds list and determine action for each
 
+  nrequested = builds.size();
+  nreqs = reqlist.size();
   nbuilds = 0;
-  for ( i = 0; int(i) <= _ndeps; i++ )
+  _ndeps = 0;
+  for ( i = 0; i < nreqs; i++ )
   {
+    requested = false;
+    for ( j = 0; j < nrequested; j++ )
+    {
+      if (reqlist[i] == builds[j])
+      {
+        requested = true;
+        break;
+      }
+    }
+
     mark = false;
     if (action != "Remove")
     {
-      _builds.push_back(reqlist[i]);
       if (! reqlist[i]->getBoolProp("installed"))
       {
         mark = true;
@@ -411,56 +448,61 @@ int InstallBox::create(BuildListItem & build,
         {
           // By default, do not reinstall dependencies
 
-          if ( (action == "Reinstall") && (int(i) == _ndeps) ) { mark = true; }
+          if ( (action == "Reinstall") && requested ) { mark = true; }
           else { mark = false; }
           action_applied = "Reinstall";
         }
       }
-      _builds[nbuilds]->setBoolProp("marked", mark);
-      _builds[nbuilds]->setProp("action", action_applied);
-      nbuilds++;
     }
     else
     {
-      if (reqlist[i]->getBoolProp("installed"))
-      {
-        _builds.push_back(reqlist[i]);
-        
-        // By default, do not remove dependencies
-
-        if (int(i) == _ndeps) { mark = true; }
-        else { mark = false; }
-        action_applied = "Remove";
-        _builds[nbuilds]->setBoolProp("marked", mark);
-        _builds[nbuilds]->setProp("action", action_applied);
-        nbuilds++;
-      }
+      // When removing, we only consider installed dependencies, and by
+      // default they are not removed
+
+      if (! reqlist[i]->getBoolProp("installed")) { continue; }
+      mark = requested;
+      action_applied = "Remove";
     }
+    _builds.push_back(reqlist[i]);
+    _requested.push_back(requested);
+    _builds[nbuilds]->setBoolProp("marked", mark);
+    _builds[nbuilds]->setProp("action", action_applied);
+    if (! requested) { _ndeps++; }
+    nbuilds++;
   }
 
-  // When removing, we only consider installed dependencies, so reset _ndeps
-  // appropriately
-
-  if (action == "Remove")
-    _ndeps = nbuilds - 1;
-
   // Rebuild inverse deps if requested and in upgrade mode
 
+  _ninvdeps = 0;
   if ((action == "Upgrade") && rebuild_inv_deps)
   {
-    reqlist.resize(0);
-    compute_inv_reqs(build, reqlist, slackbuilds);
-    _ninvdeps = reqlist.size();
-    
-    for ( i = 0; int(i) < _ninvdeps; i++ )
+    for ( j = 0; j < nrequested; j++ )
     {
-      _builds.push_back(reqlist[i]);
-      _builds[nbuilds]->setBoolProp("marked", true);
-      if (_builds[nbuilds]->getBoolProp("upgradable"))
-        _builds[nbuilds]->setProp("action", "Upgrade");
-      else
-        _builds[nbuilds]->setProp("action", "Reinstall");
-      nbuilds++;
+      compute_inv_reqs(*builds[j], invreqlist, slackbuilds);
+      ninvreqs = invreqlist.size();
+      for ( i = 0; i < ninvreqs; i++ )
+      {
+        present = false;
+        for ( k = 0; k < nbuilds; k++ )
+        {
+          if (_builds[k] == invreqlist[i])
+          {
+            present = true;
+            break;
+          }
+        }
+        if (present) { continue; }
+
+        _builds.push_back(invreqlist[i]);
+        _requested.push_back(false);
+        _builds[nbuilds]->setBoolProp("marked", true);
+        if (_builds[nbuilds]->getBoolProp("upgradable"))
+          _builds[nbuilds]->setProp("action", "Upgrade");
+        else
+          _builds[nbuilds]->setProp("action", "Reinstall");
+        _ninvdeps++;
+        nbuilds++;
+      }
     }
   }
 
@@ -482,26 +524,25 @@ int InstallBox::create(BuildListItem & build,
 
   // Set window title
 
+  if (nrequested == 1) { setName(builds[0]->name()); }
+  else { setName(int_to_string(nrequested) + " SlackBuilds"); }
   if (! resolve_deps)
-    setName(build.name() + " (deps ignored)");
+    setName(_name + " (deps ignored)");
   else
   {
     if (_ndeps == 1)
     {
       if (action == "Remove")
-        setName(build.name() + " (1 installed dep)");
+        setName(_name + " (1 installed dep)");
       else
-        setName(build.name() + " (1 dep)");
+        setName(_name + " (1 dep)");
     }
     else
     {
       if (action == "Remove")
-      {
-        setName(build.name() + 
-                " (" + int_to_string(_ndeps) + " installed deps)");
-      }
+        setName(_name + " (" + int_to_string(_ndeps) + " installed deps)");
       else
-        setName(build.name() + " (" + int_to_string(_ndeps) + " deps)");
+        setName(_name + " (" + int_to_string(_ndeps) + " deps)");
     }
   }
 
@@ -510,13 +551,77 @@ int InstallBox::create(BuildListItem & build,
 
 /*******************************************************************************
 
+Creates list from steps left over in the journal by an interrupted batch. Steps
+that turn out to have been completed already are left out. Returns the number
+of steps whose SlackBuilds could not be found in the repository.
+
+*******************************************************************************/
+int InstallBox::createFromSteps(const std::vector<journal_step> & steps,
+                        std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, nsteps, nbuilds;
+  int idx0, idx1, nmissing;
+  BuildListItem *build;
+  std::vector<std::string> buttons(2);
+  std::vector<Signal> button_signals(2);
+
+  buttons[0] = "   Ok   ";
+  buttons[1] = " Cancel ";
+  button_signals[0] = signals::keyEnter;
+  button_signals[1] = signals::quit;
+  setButtons(buttons, button_signals);
+
+  nmissing = 0;
+  nbuilds = 0;
+  nsteps = steps.size();
+  for ( i = 0; i < nsteps; i++ )
+  {
+    if (find_slackbuild(steps[i].name, slackbuilds, idx0, idx1) != 0)
+    {
+      nmissing++;
+      continue;
+    }
+    build = &slackbuilds[idx0][idx1];
+
+    // The step may have finished just before the interruption, without
+    // having been marked as done
+
+    if (steps[i].action == "Remove")
+    {
+      if (! build->getBoolProp("installed")) { continue; }
+    }
+    else if ( (steps[i].action == "Install") ||
+              (steps[i].action == "Upgrade") )
+    {
+      build->ensureRepoProps();
+      if ( build->getBoolProp("installed") &&
+           (! build->getBoolProp("upgradable")) ) { continue; }
+    }
+
+    build->setBoolProp("marked", true);
+    build->setProp("action", steps[i].action);
+    _builds.push_back(build);
+    _requested.push_back(true);
+    addItem(build);
+    nbuilds++;
+  }
+
+  _ndeps = 0;
+  _ninvdeps = 0;
+  setName("Resume interrupted changes");
+
+  return nmissing;
+}
+
+/*******************************************************************************
+
 Handles mouse event
 
 *******************************************************************************/
-std::string InstallBox::handleMouseEvent(MouseEvent * mevent)
+Signal InstallBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs, xcurs;
-  std::string retval;
+  Signal retval;
 
   getmaxyx(_win, rows, cols);
   getbegyx(_win, begy, begx);
@@ -542,7 +647,7 @@ std::string InstallBox::handleMouseEvent(MouseEvent * mevent)
     {
       _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
     }
   }
 
@@ -554,10 +659,10 @@ std::string InstallBox::handleMouseEvent(MouseEvent * mevent)
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
-std::string InstallBox::exec(MouseEvent * mevent)
+Signal InstallBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -574,14 +679,14 @@ std::string InstallBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
     case '\n':
     case '\r':
     case KEY_ENTER:
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       if (int(_button_signals.size()) >= _highlighted_button+1)
         retval = _button_signals[_highlighted_button];
       else
@@ -593,38 +698,38 @@ std::string InstallBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Right/Left: change highlighted button
@@ -632,29 +737,29 @@ std::string InstallBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "changed"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::changed; }
+      else { _redraw_type = redraw::none; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "changed"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::changed; }
+      else { _redraw_type = redraw::none; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Space: toggle item
@@ -665,21 +770,21 @@ std::string InstallBox::exec(MouseEvent * mevent)
       {
         _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
       }
-      else { _redraw_type = "none"; }
+      else { _redraw_type = redraw::none; }
       break;
 
     // t and T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Mouse
@@ -688,17 +793,17 @@ std::string InstallBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
         retval = handleMouseEvent(mevent);
         if ( (retval == signals::keyEnter) || (retval == signals::quit) ||
              (retval == "c") || (retval == "a") )
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
       }
       break;
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
       break;
   }
   curs_set(0);
@@ -749,9 +854,17 @@ int InstallBox::applyChanges(int & ninstalled, int & nupgraded,
   int retval;
   std::string action, response, msg;
 
-  // Install/upgrade/reinstall/remove selected SlackBuilds
+  // Record the planned steps in the journal before changing anything
 
   nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (_builds[i]->getBoolProp("marked"))
+      journal.plan(_builds[i]->getProp("action"), _builds[i]->name());
+  }
+
+  // Install/upgrade/reinstall/remove selected SlackBuilds
+
   retval = 0;
   for ( i = 0; i < nbuilds; i++ )
   {
@@ -789,6 +902,7 @@ int InstallBox::applyChanges(int & ninstalled, int & nupgraded,
       }
       else
       {
+        journal.complete(_builds[i]->name());
         if (_builds[i]->getProp("action") == "Install")
           ninstalled++;
         else if (_builds[i]->getProp("action") == "Upgrade")
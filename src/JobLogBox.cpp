@@ -0,0 +1,127 @@
+#include <vector>
+#include <string>
+#include <curses.h>
+#include "signals.h"
+#include "string_util.h"
+#include "ListItem.h"
+#include "ScrollBox.h"
+#include "JobQueue.h"
+#include "JobLogBox.h"
+
+/*******************************************************************************
+
+Redraws a single item. Job headers are printed in bold.
+
+*******************************************************************************/
+void JobLogBox::redrawSingleItem(unsigned int idx)
+{
+  bool header;
+
+  header = _items[idx]->getBoolProp("header");
+  wmove(_win, idx-_firstprint+_header_rows, 1);
+  if (header) { wattron(_win, A_BOLD); }
+  printToEol(_items[idx]->name());
+  if (header) { wattroff(_win, A_BOLD); }
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+JobLogBox::JobLogBox()
+{
+  _name = "Background jobs (c: stop all jobs)";
+  _reserved_rows = 4;
+  _header_rows = 3;
+  _generation = 0;
+  _initialized = false;
+  addButton("  Back to main  ", signals::quit);
+}
+
+/*******************************************************************************
+
+Sizes and places window
+
+*******************************************************************************/
+void JobLogBox::placeWindow() const
+{
+  int rows, cols;
+
+  getmaxyx(stdscr, rows, cols);
+  mvwin(_win, 0, 0);
+  wresize(_win, rows, cols);
+}
+
+/*******************************************************************************
+
+Updates list from job queue. If the view was at the end of the output, it
+stays there. Returns true if anything changed.
+
+*******************************************************************************/
+bool JobLogBox::update(const JobQueue & jobs)
+{
+  unsigned int i, j, njobs, nlines;
+  int rows, cols;
+  bool following;
+  std::string header;
+  ListItem item;
+
+  if ( _initialized && (jobs.generation() == _generation) ) { return false; }
+
+  getmaxyx(_win, rows, cols);
+  following = (! _initialized) ||
+              (int(_items.size()) <= _firstprint + rows - int(_reserved_rows));
+  _initialized = true;
+  _generation = jobs.generation();
+
+  // Rebuild list of lines, then point items to them (the vector must not
+  // change size after that)
+
+  _lines.resize(0);
+  njobs = jobs.jobs().size();
+  for ( i = 0; i < njobs; i++ )
+  {
+    const job & curjob = jobs.jobs()[i];
+
+    header = "==> " + curjob.action + " " + curjob.name + ": "
+           + curjob.status;
+    if ( (curjob.status == "Done") || (curjob.status == "Failed") )
+    {
+      header += " (" + duration_to_string(curjob.seconds) + ", CPU "
+              + duration_to_string(curjob.cpu_seconds);
+      if (curjob.max_rss > 0)
+        header += ", " + int_to_string(int(curjob.max_rss/1024)) + " MB";
+      header += ")";
+    }
+    else if (curjob.status == "Running")
+      header += " (pid " + int_to_string(int(curjob.pid)) + ")";
+    item.setName(header);
+    item.addBoolProp("header", true);
+    _lines.push_back(item);
+
+    nlines = curjob.log.size();
+    for ( j = 0; j < nlines; j++ )
+    {
+      item.setName(curjob.log[j]);
+      item.addBoolProp("header", false);
+      _lines.push_back(item);
+    }
+  }
+  if (njobs == 0)
+  {
+    item.setName("No background jobs have been run.");
+    item.addBoolProp("header", false);
+    _lines.push_back(item);
+  }
+
+  _items.resize(0);
+  nlines = _lines.size();
+  for ( i = 0; i < nlines; i++ ) { _items.push_back(&_lines[i]); }
+
+  if (following) { scrollLast(); }
+  else if (_firstprint >= int(nlines)) { scrollLast(); }
+  _redraw_type = redraw::all;
+
+  return true;
+}
@@ -0,0 +1,355 @@
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>   // max
+#include "BuildListItem.h"
+#include "Process.h"
+#include "string_util.h"
+#include "backend.h"
+#include "JobQueue.h"
+
+/* Number of output lines kept per job */
+
+static const unsigned int max_log_lines = 5000;
+
+/*******************************************************************************
+
+Adds output from the running job to its log. A carriage return starts the line
+over, as it would on a terminal (used for progress bars), and other control
+characters are dropped.
+
+*******************************************************************************/
+void JobQueue::appendOutput(const std::string & text)
+{
+  unsigned int i, len;
+  std::vector<std::string> & log = _jobs[_current].log;
+
+  len = text.size();
+  for ( i = 0; i < len; i++ )
+  {
+    if (text[i] == '\n')
+    {
+      log.push_back(_partial);
+      _partial = "";
+    }
+    else if (text[i] == '\r') { _partial = ""; }
+    else if (text[i] == '\t') { _partial += "        "; }
+    else if ( (unsigned char)(text[i]) >= 32 ) { _partial += text[i]; }
+  }
+
+  if (log.size() > max_log_lines)
+    log.erase(log.begin(), log.begin() + (log.size() - max_log_lines));
+  _generation++;
+}
+
+/*******************************************************************************
+
+Starts the process for a job's current phase. Returns 0 on success or 1 if it
+could not be started.
+
+*******************************************************************************/
+int JobQueue::startPhase(job & current)
+{
+  command_line cmd;
+
+  if ( (action_command(*current.build, current.phase, cmd) != 0) ||
+       (_process.start(cmd) != 0) ) { return 1; }
+  current.pid = _process.pid();
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Starts the next queued job, if any
+
+*******************************************************************************/
+void JobQueue::startNext()
+{
+  unsigned int i, njobs;
+
+  njobs = _jobs.size();
+  for ( i = 0; i < njobs; i++ )
+  {
+    if (_jobs[i].status != "Queued") { continue; }
+
+    _current = i;
+    _partial = "";
+    _jobs[i].phase = _jobs[i].action;
+    _jobs[i].status = "Running";
+    _start = std::chrono::steady_clock::now();
+    _generation++;
+
+    if (startPhase(_jobs[i]) != 0)
+    {
+      _jobs[i].log.push_back("Error: unable to run " + _jobs[i].phase +
+                             " command for " + _jobs[i].name + ".");
+      finishCurrent(-1);
+      continue;
+    }
+    return;
+  }
+
+  _current = njobs;
+}
+
+/*******************************************************************************
+
+Handles the end of the running job's process, given its exit status
+
+*******************************************************************************/
+void JobQueue::finishCurrent(int status)
+{
+  unsigned int i, njobs;
+  int check;
+  std::chrono::duration<double> elapsed;
+  job & current = _jobs[_current];
+
+  if (_partial != "")
+  {
+    current.log.push_back(_partial);
+    _partial = "";
+  }
+
+  if (status >= 0)
+  {
+    current.cpu_seconds += _process.usage().user_seconds
+                         + _process.usage().system_seconds;
+    current.max_rss = std::max(current.max_rss, _process.usage().max_rss);
+  }
+
+  if (status == 0)
+  {
+    check = check_action(*current.build, current.phase);
+
+    // If upgrade didn't work (maybe package manager doesn't think it's
+    // upgradable), reinstall instead
+
+    if ( (check == 0) && (current.phase == "Upgrade") &&
+         current.build->getBoolProp("upgradable") )
+    {
+      current.phase = "Reinstall";
+      if (startPhase(current) == 0) { return; }
+      check = 1;
+    }
+  }
+  else { check = 1; }
+  _changed = true;
+  _generation++;
+
+  elapsed = std::chrono::steady_clock::now() - _start;
+  current.seconds = elapsed.count();
+  if (check == 0)
+  {
+    current.status = "Done";
+    journal.complete(current.name);
+    if (current.action != "Remove")
+      build_history.record(*current.build, current.seconds,
+                           current.cpu_seconds, current.max_rss);
+  }
+  else
+  {
+    current.status = "Failed";
+    current.log.push_back("Error: " + current.phase + " of " +
+                          current.name + " failed.");
+
+    // Later jobs in the same batch probably depend on this one
+
+    njobs = _jobs.size();
+    for ( i = _current+1; i < njobs; i++ )
+    {
+      if ( (_jobs[i].batch == current.batch) &&
+           (_jobs[i].status == "Queued") )
+        _jobs[i].status = "Cancelled";
+    }
+  }
+  _current = _jobs.size();
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+JobQueue::JobQueue()
+{
+  _jobs.resize(0);
+  _current = 0;
+  _round_start = 0;
+  _nbatches = 0;
+  _generation = 0;
+  _changed = false;
+}
+
+/*******************************************************************************
+
+Adds a job
+
+*******************************************************************************/
+unsigned int JobQueue::newBatch() { return ++_nbatches; }
+
+int JobQueue::add(BuildListItem *build, const std::string & action,
+                  unsigned int batch)
+{
+  unsigned int i, njobs;
+  job newjob;
+
+  njobs = _jobs.size();
+  for ( i = _round_start; i < njobs; i++ )
+  {
+    if ( (_jobs[i].build == build) && (_jobs[i].action == action) &&
+         ((_jobs[i].status == "Queued") || (_jobs[i].status == "Running")) )
+      return 1;
+  }
+
+  // A new round starts when the queue was idle. The journal tracks what is
+  // left to do in the round.
+
+  if (! busy())
+  {
+    _round_start = njobs;
+    _current = njobs;
+    journal.begin();
+  }
+
+  newjob.build = build;
+  newjob.name = build->name();
+  newjob.action = action;
+  newjob.phase = action;
+  newjob.status = "Queued";
+  newjob.batch = batch;
+  newjob.pid = -1;
+  newjob.seconds = 0.;
+  newjob.cpu_seconds = 0.;
+  newjob.max_rss = 0;
+  _jobs.push_back(newjob);
+  journal.plan(action, build->name());
+  _generation++;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Collects output, finishes, and starts jobs. Returns true while any jobs are
+queued or running.
+
+*******************************************************************************/
+bool JobQueue::poll()
+{
+  std::string output;
+  bool was_busy;
+
+  was_busy = busy();
+  if (_current < _jobs.size())
+  {
+    _process.readOutput(output);
+    if (! _process.running())
+    {
+      _process.readOutput(output);
+      if (output.size() > 0) { appendOutput(output); }
+      finishCurrent(_process.exitStatus());
+    }
+    else if (output.size() > 0) { appendOutput(output); }
+  }
+  if (_current >= _jobs.size()) { startNext(); }
+
+  if (was_busy && (! busy())) { journal.finish(); }
+
+  return busy();
+}
+
+/*******************************************************************************
+
+Stops the running job and cancels queued ones. The journal is left in place, so
+that the remaining steps are offered again the next time sboui starts.
+
+*******************************************************************************/
+void JobQueue::cancel()
+{
+  unsigned int i, njobs;
+
+  _process.terminate();
+  njobs = _jobs.size();
+  for ( i = _round_start; i < njobs; i++ )
+  {
+    if ( (_jobs[i].status == "Queued") || (_jobs[i].status == "Running") )
+      _jobs[i].status = "Cancelled";
+  }
+  _current = njobs;
+  _generation++;
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+bool JobQueue::busy() const
+{
+  unsigned int i, njobs;
+
+  njobs = _jobs.size();
+  for ( i = _round_start; i < njobs; i++ )
+  {
+    if ( (_jobs[i].status == "Queued") || (_jobs[i].status == "Running") )
+      return true;
+  }
+
+  return false;
+}
+
+const std::vector<job> & JobQueue::jobs() const { return _jobs; }
+unsigned int JobQueue::generation() const { return _generation; }
+
+/*******************************************************************************
+
+Returns a one-line description of progress in the current round of jobs, or an
+empty string if no jobs have been run
+
+*******************************************************************************/
+std::string JobQueue::statusText() const
+{
+  unsigned int i, njobs, ndone, nfailed, nround;
+  std::chrono::duration<double> elapsed;
+
+  njobs = _jobs.size();
+  if (njobs == 0) { return ""; }
+
+  ndone = 0;
+  nfailed = 0;
+  for ( i = _round_start; i < njobs; i++ )
+  {
+    if (_jobs[i].status == "Done") { ndone++; }
+    else if ( (_jobs[i].status == "Failed") ||
+              (_jobs[i].status == "Cancelled") ) { nfailed++; }
+  }
+  nround = njobs - _round_start;
+
+  if (_current < njobs)
+  {
+    elapsed = std::chrono::steady_clock::now() - _start;
+    return "Job " + int_to_string(_current - _round_start + 1) + " of "
+         + int_to_string(nround) + ": " + _jobs[_current].phase + " "
+         + _jobs[_current].name + " ("
+         + duration_to_string(elapsed.count()) + "). Press j to view.";
+  }
+  else
+    return "Background jobs finished: " + int_to_string(ndone) + " done, "
+         + int_to_string(nfailed) + " failed or cancelled.";
+}
+
+/*******************************************************************************
+
+Returns true (once) if any SlackBuild was changed since the last call
+
+*******************************************************************************/
+bool JobQueue::takeChanged()
+{
+  bool changed;
+
+  changed = _changed;
+  _changed = false;
+
+  return changed;
+}
@@ -0,0 +1,176 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <fcntl.h>    // open
+#include <unistd.h>   // write, fsync, close, unlink, access
+#include "DirListing.h"
+#include "string_util.h"
+#include "Journal.h"
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+Journal::Journal()
+{
+  _path = "/var/lib/sboui/journal";
+  _active = false;
+}
+
+/*******************************************************************************
+
+Appends a line to the journal file and syncs it to disk, so that the record
+survives if sboui or the system goes down right afterwards
+
+*******************************************************************************/
+int Journal::append(const std::string & line) const
+{
+  int fd, check;
+  std::string buffer;
+
+  fd = open(_path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd < 0) { return 1; }
+
+  buffer = line + "\n";
+  check = 0;
+  if (write(fd, buffer.c_str(), buffer.size()) != ssize_t(buffer.size()))
+    check = 1;
+  if (fsync(fd) != 0) { check = 1; }
+  close(fd);
+
+  return check;
+}
+
+/*******************************************************************************
+
+Set/get location of journal file
+
+*******************************************************************************/
+void Journal::setPath(const std::string & path) { _path = path; }
+const std::string & Journal::path() const { return _path; }
+
+/*******************************************************************************
+
+Starts a new batch, discarding any previous journal. Returns 0 on success or 1
+if the journal could not be created (e.g., not running as root), in which case
+the batch proceeds without journaling.
+
+*******************************************************************************/
+int Journal::begin()
+{
+  DirListing listing;
+  std::string::size_type pos;
+  int fd;
+
+  _active = false;
+
+  pos = _path.rfind('/');
+  if ( (pos != std::string::npos) && (pos > 0) )
+  {
+    if (listing.createFromPath(_path.substr(0, pos)) != 0) { return 1; }
+  }
+
+  fd = open(_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 0644);
+  if (fd < 0) { return 1; }
+  fsync(fd);
+  close(fd);
+
+  _active = true;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Records a planned step and its completion
+
+*******************************************************************************/
+int Journal::plan(const std::string & action, const std::string & name)
+{
+  if (! _active) { return 1; }
+  return append("plan " + action + " " + name);
+}
+
+int Journal::complete(const std::string & name)
+{
+  if (! _active) { return 1; }
+  return append("done " + name);
+}
+
+/*******************************************************************************
+
+Ends the batch and removes the journal. Also used to discard a journal left
+over from a previous run.
+
+*******************************************************************************/
+int Journal::finish()
+{
+  _active = false;
+  if (unlink(_path.c_str()) != 0) { return 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads steps that were planned but not completed in a previous run. A last line
+without a newline was cut short while being appended and is skipped. Returns 0
+if the journal was read (steps may still be empty) or 1 if there is none.
+
+*******************************************************************************/
+int Journal::pending(std::vector<journal_step> & steps) const
+{
+  std::ifstream file;
+  std::string line;
+  std::vector<std::string> fields;
+  std::vector<journal_step> allsteps;
+  journal_step step;
+  unsigned int i, nsteps;
+
+  // Users who cannot apply changes are not offered to resume them
+
+  steps.resize(0);
+  if (access(_path.c_str(), W_OK) != 0) { return 1; }
+
+  file.open(_path.c_str());
+  if (not file.is_open()) { return 1; }
+
+  while (std::getline(file, line))
+  {
+    // Every record ends with a newline, so a last line without one was cut
+    // short by a crash and is skipped. getline only stops at the end of the
+    // file instead of a newline for such a line.
+
+    if (file.eof()) { break; }
+    fields = split(line, ' ');
+    if ( (fields.size() == 3) && (fields[0] == "plan") )
+    {
+      step.action = fields[1];
+      step.name = fields[2];
+      step.done = false;
+      allsteps.push_back(step);
+    }
+    else if ( (fields.size() == 2) && (fields[0] == "done") )
+    {
+      nsteps = allsteps.size();
+      for ( i = 0; i < nsteps; i++ )
+      {
+        if ( (allsteps[i].name == fields[1]) && (! allsteps[i].done) )
+        {
+          allsteps[i].done = true;
+          break;
+        }
+      }
+    }
+  }
+  file.close();
+
+  nsteps = allsteps.size();
+  for ( i = 0; i < nsteps; i++ )
+  {
+    if (! allsteps[i].done) { steps.push_back(allsteps[i]); }
+  }
+
+  return 0;
+}
@@ -30,6 +30,8 @@ void KeyHelpWindow::createList()
   addItem(new HelpItem("Sync / Update repository", "s"));
   addItem(new HelpItem("Toggle vertical/horizontal layout", "l"));
   addItem(new HelpItem("Upgrade all", "Ctrl-u"));
+  addItem(new HelpItem("View all SlackBuilds in a table", "a"));
+  addItem(new HelpItem("View background jobs", "j"));
   addItem(new HelpItem("View command line output", "c"));
 
   addItem(new HelpItem("space1", "", false, true));
@@ -3,6 +3,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "InputItem.h"
 #include "Label.h"
 #include "MouseEvent.h"
@@ -14,7 +15,7 @@ Constructors and destructor
 *******************************************************************************/
 Label::Label()
 {
-  _redraw_type = "label";
+  _redraw_type = redraw::label;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = false;
@@ -24,7 +25,7 @@ Label::Label()
 
 Label::Label(bool selectable)
 {
-  _redraw_type = "label";
+  _redraw_type = redraw::label;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = selectable;
@@ -34,7 +35,7 @@ Label::Label(bool selectable)
 
 Label::Label(bool selectable, bool hline)
 {
-  _redraw_type = "label";
+  _redraw_type = redraw::label;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = selectable;
@@ -57,7 +58,7 @@ void Label::setBold(bool bold) { _bold = bold; }
 Handles mouse event
 
 *******************************************************************************/
-std::string Label::handleMouseEvent(MouseEvent * mevent, int y_offset)
+Signal Label::handleMouseEvent(MouseEvent * mevent, int y_offset)
 {
   int begy, begx, ycurs, xcurs;
 
@@ -91,11 +92,12 @@ void Label::draw(int y_offset, bool force, bool highlight)
 
   wmove(_win, _posy-y_offset, _posx);
 
-  if (_redraw_type != "label") { return; }
+  if (_redraw_type != redraw::label) { return; }
 
   if (highlight && _selectable)
   {
-    if (colors.turnOn(_win, "fg_highlight_active", "bg_highlight_active") != 0)
+    if (colors.turnOn(_win, color::fg_highlight_active,
+                       color::bg_highlight_active) != 0)
       wattron(_win, A_REVERSE);
   }
   else { colors.turnOn(_win, _color_idx); }
@@ -116,7 +118,7 @@ void Label::draw(int y_offset, bool force, bool highlight)
   if ( (_bold) && (! colors.pairIsBold(_color_idx)) )
     wattroff(_win, A_BOLD);
 
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -124,10 +126,10 @@ void Label::draw(int y_offset, bool force, bool highlight)
 User interaction: returns key stroke
 
 *******************************************************************************/
-std::string Label::exec(int y_offset, MouseEvent * mevent)
+Signal Label::exec(int y_offset, MouseEvent * mevent)
 {
   int ch;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -140,7 +142,7 @@ std::string Label::exec(int y_offset, MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: return Enter signal
 
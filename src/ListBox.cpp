@@ -7,6 +7,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "backend.h"  // find_name_in_list
 #include "ListItem.h"
 #include "AbstractListBox.h"
@@ -23,7 +24,7 @@ int ListBox::highlightFirst()
 {
   unsigned int retval;
 
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   _prevhighlight = _highlight;
   _highlight = 0;
@@ -42,10 +43,10 @@ changed, 1 if it has.
 *******************************************************************************/
 int ListBox::highlightLast()
 {
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   _prevhighlight = _highlight;
-  _highlight = std::max(int(_items.size()) - 1, 0);
+  _highlight = std::max(int(numItems()) - 1, 0);
   return determineFirstPrint();
 }
 
@@ -57,7 +58,7 @@ changed, 1 if it has.
 *******************************************************************************/
 int ListBox::highlightPrevious()
 {
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   if (_highlight == 0) { return 0; }
   else
@@ -76,9 +77,9 @@ changed, 1 if it has.
 *******************************************************************************/
 int ListBox::highlightNext()
 {
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
-  if (_highlight == int(_items.size())-1) { return 0; }
+  if (_highlight == int(numItems())-1) { return 0; }
   else
   {
     _prevhighlight = _highlight;
@@ -97,7 +98,7 @@ int ListBox::highlightNextPage()
 {
   int rows, cols, rowsavail, nitems, buffer_rows;
 
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   getmaxyx(_win, rows, cols);
   rowsavail = rows-_reserved_rows;
@@ -108,7 +109,7 @@ int ListBox::highlightNextPage()
 
   // Determine how far to page and which item to highlight
 
-  nitems = _items.size();
+  nitems = numItems();
   if (_highlight + rowsavail - buffer_rows >= nitems-1)
     return highlightLast();
   if (_firstprint + rowsavail - buffer_rows >= nitems-1)
@@ -137,7 +138,7 @@ int ListBox::highlightPreviousPage()
 {
   int rows, cols, rowsavail, buffer_rows;
 
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   getmaxyx(_win, rows, cols);
   rowsavail = rows-_reserved_rows;
@@ -165,21 +166,52 @@ int ListBox::highlightPreviousPage()
 
 /*******************************************************************************
 
+Moves highlight for KEY_UP, KEY_DOWN, KEY_PPAGE, or KEY_NPAGE. When the key is
+held down, the repeats waiting in the input queue are applied all at once, so
+that the list is drawn once at the final position instead of falling behind the
+keyboard. Returns redraw::all if the list scrolled, otherwise redraw::changed.
+
+*******************************************************************************/
+unsigned int ListBox::moveHighlight(int key)
+{
+  int i, count, start, check_redraw;
+
+  start = _highlight;
+  count = 1 + drain_repeats(key);
+  check_redraw = 0;
+  for ( i = 0; i < count; i++ )
+  {
+    if (key == KEY_UP) { check_redraw |= highlightPrevious(); }
+    else if (key == KEY_DOWN) { check_redraw |= highlightNext(); }
+    else if (key == KEY_PPAGE) { check_redraw |= highlightPreviousPage(); }
+    else if (key == KEY_NPAGE) { check_redraw |= highlightNextPage(); }
+  }
+
+  // Only the starting and final items need redrawing if nothing scrolled
+
+  if (_highlight != start) { _prevhighlight = start; }
+
+  if (check_redraw == 1) { return redraw::all; }
+  else { return redraw::changed; }
+}
+
+/*******************************************************************************
+
 Scrolls to a page based on a fractional value of all items in the list. Return
 value of 0 means that _firstprint hasn't changed; 1 means it has.
 
 *******************************************************************************/
 int ListBox::highlightFractional(const double & frac)
 {
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
   if (frac < 0.) { return 0; }
   else if (frac > 1.) { return 0; }
 
   _prevhighlight = _highlight;
   if (frac < 0.5)
-    _highlight = std::ceil(frac*double(_items.size()-1));
+    _highlight = std::ceil(frac*double(numItems()-1));
   else
-    _highlight = std::floor(frac*double(_items.size()-1));
+    _highlight = std::floor(frac*double(numItems()-1));
   return determineFirstPrint();
 }
 
@@ -193,7 +225,7 @@ int ListBox::determineFirstPrint()
 {
   int rows, cols, rowsavail, firstprintstore;
 
-  if (_items.size() == 0) { return 0; }
+  if (numItems() == 0) { return 0; }
 
   getmaxyx(_win, rows, cols);
   firstprintstore = _firstprint;
@@ -208,46 +240,144 @@ int ListBox::determineFirstPrint()
 }
 
 /*******************************************************************************
- 
+
+Returns attributes for a color pair given by labels, or fallback if colors are
+not available
+
+*******************************************************************************/
+chtype ListBox::colorAttributes(color::label fg, color::label bg,
+                                chtype fallback) const
+{
+  chtype attr;
+
+  if (colors.getAttributes(colors.getPair(fg, bg), attr) != 0)
+    return fallback;
+
+  return attr;
+}
+
+/*******************************************************************************
+
+Prints a row of width columns for item idx at y, x in a single call. The row is
+text, padded with spaces or truncated, drawn with attr, except for the hotkey
+character (drawn with hotattr) and an optional divider column (a vertical line
+in the window's own colors). The composed row is cached in a slot chosen by
+item index and reused as long as none of the inputs have changed. Text that is
+not plain ASCII can't be put in a chtype string and is printed normally
+instead.
+
+*******************************************************************************/
+void ListBox::printRow(unsigned int idx, int y, int x, int width,
+                       const std::string & text, int hotkey, chtype attr,
+                       chtype hotattr, int divider)
+{
+  int i, len;
+  chtype bkgdcolor;
+  bool ascii;
+
+  if (width <= 0) { return; }
+
+  len = text.size();
+  ascii = true;
+  for ( i = 0; i < len; i++ )
+  {
+    if ( (unsigned char)(text[i]) >= 128 )
+    {
+      ascii = false;
+      break;
+    }
+  }
+
+  if (! ascii)
+  {
+    wmove(_win, y, x);
+    wattrset(_win, attr);
+    for ( i = 0; i < len; i++ )
+    {
+      if (i == hotkey) { wattrset(_win, hotattr); }
+      waddch(_win, (unsigned char)(text[i]));
+      if (i == hotkey) { wattrset(_win, attr); }
+    }
+    printToEol("", x+width-getcurx(_win));
+    wattrset(_win, A_NORMAL);
+    if ( (divider >= 0) && (divider < width) )
+      mvwaddch(_win, y, x+divider, ACS_VLINE);
+    return;
+  }
+
+  // One cached row per line of the window. An item keeps the same slot while
+  // the list scrolls, so rows still on screen are not composed again.
+
+  if (int(_rowcache.size()) != getmaxy(_win))
+    _rowcache.resize(std::max(getmaxy(_win), 1));
+  cached_row & row = _rowcache[idx % _rowcache.size()];
+
+  if ( (row.width != width) || (row.attr != attr) ||
+       (row.hotattr != hotattr) || (row.hotkey != hotkey) ||
+       (row.divider != divider) || (row.text != text) ||
+       (int(row.line.size()) != width) )
+  {
+    // Characters without a color take the window's background color, as they
+    // would if printed with waddch
+
+    bkgdcolor = getbkgd(_win) & A_COLOR;
+    if ((attr & A_COLOR) == 0) { attr |= bkgdcolor; }
+    if ((hotattr & A_COLOR) == 0) { hotattr |= bkgdcolor; }
+
+    row.text = text;
+    row.hotkey = hotkey;
+    row.width = width;
+    row.divider = divider;
+    row.attr = attr;
+    row.hotattr = hotattr;
+    row.line.assign(width, ' ' | attr);
+    for ( i = 0; (i < len) && (i < width); i++ )
+    {
+      if (i == hotkey) { row.line[i] = (unsigned char)(text[i]) | hotattr; }
+      else { row.line[i] = (unsigned char)(text[i]) | attr; }
+    }
+    if ( (divider >= 0) && (divider < width) )
+      row.line[divider] = ACS_VLINE | bkgdcolor;
+  }
+
+  mvwaddchnstr(_win, y, x, &row.line[0], width);
+}
+
+/*******************************************************************************
+
 Redraws a single item. Note: doesn't check if the item is actually on the
 screen or not.
 
 *******************************************************************************/
 void ListBox::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
-  int color_pair1, color_pair2, len, i, hidx;
-
-  // Go to item location, optionally highlight, and print item
+  color::label bg;
+  chtype attr, hotattr;
+  int cols;
 
-  wmove(_win, idx-_firstprint+_header_rows, 1);
+  cols = getmaxx(_win);
 
-  // Turn on highlight color
+  // Attributes for item and hotkey
 
   if (int(idx) == _highlight)
   {
     if (_activated) 
     { 
-      fg = "fg_highlight_active"; 
-      bg = "bg_highlight_active"; 
+      bg = color::bg_highlight_active; 
+      attr = colorAttributes(color::fg_highlight_active, bg, A_REVERSE);
     }
     else
     {
-      fg = "fg_highlight_inactive"; 
-      bg = "bg_highlight_inactive"; 
-    }
-    color_pair1 = colors.getPair(fg, bg);
-    color_pair2 = colors.getPair("hotkey", bg);
-    if (colors.turnOn(_win, color_pair1) != 0)
-    { 
-      if (_activated) { wattron(_win, A_REVERSE); }
+      bg = color::bg_highlight_inactive; 
+      attr = colorAttributes(color::fg_highlight_inactive, bg, A_NORMAL);
     }
   } 
   else
   {
-    color_pair1 = colors.getPair(_fg_color, _bg_color);
-    color_pair2 = colors.getPair("hotkey", _bg_color);
+    bg = _bg_color;
+    attr = colorAttributes(_fg_color, bg, A_NORMAL);
   }
+  hotattr = colorAttributes(color::hotkey, bg, attr | A_BOLD);
 
   // Save highlight idx for redrawing later.
   // Note: prevents this method from being const.
@@ -256,28 +386,8 @@ void ListBox::redrawSingleItem(unsigned int idx)
 
   // Print item
 
-  len = _items[idx]->name().size();
-  hidx = _items[idx]->hotKey();
-  for ( i = 0; i < len; i++ )
-  {
-    if ( i == hidx )
-    { 
-      colors.turnOff(_win);
-      if (colors.turnOn(_win, color_pair2) != 0) { wattron(_win, A_BOLD); }
-      wprintw(_win, "%s", _items[idx]->name().substr(i,1).c_str());
-      if (colors.turnOff(_win) != 0) { wattroff(_win, A_BOLD); } 
-      colors.turnOn(_win, color_pair1);
-    }
-    else { wprintw(_win, "%s", _items[idx]->name().substr(i,1).c_str()); }
-  }
-  printToEol(std::string(""));
-
-  // Turn off highlight color
-
-  if (colors.turnOff(_win) != 0)
-  { 
-    if ( (int(idx) == _highlight) && _activated ) { wattroff(_win, A_REVERSE); }
-  }
+  printRow(idx, idx-_firstprint+_header_rows, 1, cols-2, item(idx)->name(),
+           item(idx)->hotKey(), attr, hotattr);
 }
 
 /*******************************************************************************
@@ -299,7 +409,7 @@ void ListBox::redrawScrollIndicator() const
   need_up = false;
   need_dn = false;
   if (_highlight != 0) { need_up = true; }
-  if (_highlight < int(_items.size())-1) { need_dn = true; }
+  if (_highlight < int(numItems())-1) { need_dn = true; }
 
   // Draw right border
 
@@ -315,9 +425,9 @@ void ListBox::redrawScrollIndicator() const
 
   // Draw position indicator
 
-  if ( (_items.size() > 0) && ((need_up) || (need_dn)) )
+  if ( (numItems() > 0) && ((need_up) || (need_dn)) )
   {
-    frac = double(_highlight)/double(_items.size()-1);
+    frac = double(_highlight)/double(numItems()-1);
 
     // Make sure we don't indicate the top or bottom before we're really there
 
@@ -347,10 +457,10 @@ void ListBox::redrawChangedItems()
   if ( (_prevhighlight >= _firstprint) &&
        (_prevhighlight < _firstprint+rowsavail) )
   {
-    if (_prevhighlight < int(_items.size())) 
+    if (_prevhighlight < int(numItems())) 
       redrawSingleItem(_prevhighlight); 
   }
-  if (_highlight < int(_items.size())) 
+  if (_highlight < int(numItems())) 
     redrawSingleItem(_highlight); 
 }
 
@@ -381,25 +491,49 @@ ListBox::ListBox(WINDOW *win, const std::string & name)
 
 /*******************************************************************************
 
-Edit list items
+Edit list items. Inserting or removing an item keeps the same item highlighted
+(or the next one, if the highlighted item is removed) and only scrolls if it
+would otherwise go out of view.
 
 *******************************************************************************/
+void ListBox::insertItem(unsigned int idx, ListItem *item)
+{
+  detachSource();
+  if (idx > numItems()) { idx = numItems(); }
+  _items.insert(_items.begin()+idx, item);
+  if (numItems() > 1)
+  {
+    if (int(idx) < _firstprint) { _firstprint++; }
+    if (int(idx) <= _highlight) { _highlight++; }
+  }
+  _prevhighlight = _highlight;
+  determineFirstPrint();
+  _redraw_type = redraw::all;
+}
+
 void ListBox::removeItem(unsigned int idx)
 {
-  if (idx <= _items.size()) { _items.erase(_items.begin()+idx); }
-  _highlight = 0;
-  _firstprint = 0;
-  _prevhighlight = 0;
-  _redraw_type = "all";
+  detachSource();
+  if (idx >= numItems()) { return; }
+  _items.erase(_items.begin()+idx);
+  if (int(idx) < _firstprint) { _firstprint--; }
+  if (int(idx) < _highlight) { _highlight--; }
+  if (_highlight >= int(numItems()))
+    _highlight = std::max(int(numItems())-1, 0);
+  _prevhighlight = _highlight;
+  determineFirstPrint();
+  _redraw_type = redraw::all;
 }
 
 void ListBox::clearList()
 {
   _items.resize(0);
+  _source.reset();
+  _rowcache.resize(0);
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 /*******************************************************************************
@@ -410,14 +544,14 @@ Set attributes
 void ListBox::setActivated(bool activated) { _activated = activated; }
 int ListBox::setHighlight(int highlight)
 {
-  if ( (highlight >= 0) && (highlight < int(_items.size())) )
+  if ( (highlight >= 0) && (highlight < int(numItems())) )
   {
     _prevhighlight = _highlight;
     _highlight = highlight;
     determineFirstPrint();
     return 0;
   }
-  else if (highlight >= int(_items.size()))
+  else if (highlight >= int(numItems()))
   {
     highlightLast();
     return 1;
@@ -430,10 +564,10 @@ int ListBox::setHighlight(const std::string & name)
   int i, nitems, retval;
 
   retval = 1;
-  nitems = _items.size();
+  nitems = numItems();
   for ( i = 0; i < nitems; i++ )
   {
-    if (_items[i]->name() == name) { retval = setHighlight(i); }
+    if (item(i)->name() == name) { retval = setHighlight(i); }
   }
   return retval;
 }
@@ -446,7 +580,7 @@ Get attributes
 unsigned int ListBox::highlight() const { return _highlight; }
 const std::string & ListBox::highlightedName() const
 { 
-  return _items[_highlight]->name();
+  return item(_highlight)->name();
 }
 
 /*******************************************************************************
@@ -462,7 +596,10 @@ int ListBox::highlightSearch(const std::string & pattern)
 
   lbound = 0;
   rbound = numItems()-1;
-  check = find_name_in_list(pattern, _items, idx, lbound, rbound, false);
+  if (_source)
+    check = find_name_in_list(pattern, *_source, idx, lbound, rbound, false);
+  else
+    check = find_name_in_list(pattern, _items, idx, lbound, rbound, false);
   if (check == 0)
   {
     _highlight = idx;
@@ -480,8 +617,8 @@ Returns pointer to item
 *******************************************************************************/
 ListItem * ListBox::highlightedItem()
 {
-  if (_items.size() == 0) { return NULL; }
-  else { return _items[_highlight]; }
+  if (numItems() == 0) { return NULL; }
+  else { return item(_highlight); }
 }
 
 /*******************************************************************************
@@ -489,7 +626,7 @@ ListItem * ListBox::highlightedItem()
 Handles mouse events
 
 *******************************************************************************/
-std::string ListBox::handleMouseEvent(MouseEvent * mevent)
+Signal ListBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs, xcurs, rowsavail, check_redraw;
   unsigned int i, nbuttons;
@@ -516,8 +653,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           draw();
+          doupdate();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -541,9 +679,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
           return signals::highlight;
         }
         else
@@ -551,13 +689,13 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
       }
       else if (ycurs == int(_header_rows)+rowsavail-1)
       {
-        if (int(_items.size())-1 > _highlight)
+        if (int(numItems())-1 > _highlight)
         {
           check_redraw = highlightNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
           return signals::highlight;
         }
         else
@@ -569,16 +707,16 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = highlightFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
         else
-          _redraw_type = "changed";
+          _redraw_type = redraw::changed;
         return signals::highlight;
       }
     }
 
     // Clicked on empty space in the list box
 
-    else if (_firstprint + (ycurs - _header_rows) >= _items.size())
+    else if (_firstprint + (ycurs - _header_rows) >= numItems())
       return signals::nullEvent;
 
     // Clicked in the box -> change highlighted item
@@ -588,9 +726,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
       _prevhighlight = _highlight;
       _highlight = _firstprint + (ycurs - _header_rows);
       if (determineFirstPrint() == 1)
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
       else
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
 
       if (mevent->button() == 3)
         return signals::tag;
@@ -610,18 +748,18 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = highlightPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
     return signals::highlight;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = highlightNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
     return signals::highlight;
   }
   else
@@ -635,25 +773,24 @@ Draws list box (frame, items, etc.) as needed
 *******************************************************************************/
 void ListBox::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
   // Draw list elements
 
-  if (_redraw_type == "all")
+  if (_redraw_type == redraw::all)
   { 
     clearWindow(); 
     colors.setBackground(_win, _fg_color, _bg_color);
   }
-  if (_redraw_type == "buttons") { redrawButtons(); }
-  else if (_redraw_type != "none") 
+  if (_redraw_type == redraw::buttons) { redrawButtons(); }
+  else if (_redraw_type != redraw::none) 
   {
     redrawFrame();
     redrawScrollIndicator();
   }
-  if ( (_redraw_type == "all") || (_redraw_type == "items")) { 
-                                                            redrawAllItems(); }
-  else if (_redraw_type == "changed") { redrawChangedItems(); }
-  wrefresh(_win);
+  if (_redraw_type & redraw::items) { redrawAllItems(); }
+  else if (_redraw_type == redraw::changed) { redrawChangedItems(); }
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -661,10 +798,10 @@ void ListBox::draw(bool force)
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
-std::string ListBox::exec(MouseEvent * mevent)
+Signal ListBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -680,7 +817,7 @@ std::string ListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
@@ -691,53 +828,36 @@ std::string ListBox::exec(MouseEvent * mevent)
         retval = _button_signals[_highlighted_button];
       else
         retval = signals::keyEnter;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
 
     case KEY_UP:
-      retval = signals::highlight;
-      check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_DOWN:
-      retval = signals::highlight;
-      check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_PPAGE:
-      retval = signals::highlight;
-      check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_NPAGE:
       retval = signals::highlight;
-      check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      _redraw_type = moveHighlight(ch);
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Right/Left: change highlighted button
@@ -745,29 +865,29 @@ std::string ListBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "buttons"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+      else { _redraw_type = redraw::none; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "buttons"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+      else { _redraw_type = redraw::none; }
       break;
 
     // Resize signal
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Mouse
@@ -776,7 +896,7 @@ std::string ListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
         retval = signals::mouseEvent;
       }
       else
@@ -785,7 +905,7 @@ std::string ListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
       break;
   }
   return retval;
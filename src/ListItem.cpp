@@ -1,5 +1,8 @@
 #include <string>
-#include <cmath>        // floor
+#include <string_view>
+#include <set>
+#include <mutex>
+#include <utility>      // move
 #include "ListItem.h"
 
 /*******************************************************************************
@@ -7,7 +10,7 @@
 Conversions
 
 *******************************************************************************/
-std::string ListItem::bool2String(bool value) const
+const char * ListItem::bool2String(bool value) const
 {
   if (value) { return "true"; }
   else { return "false"; }
@@ -21,72 +24,46 @@ bool ListItem::string2Bool(const std::string & value) const
 
 /*******************************************************************************
 
-Finds prop by name using bisection search
+Returns the shared copy of a property name. Names are kept in a set, whose
+elements never move, for the life of the program. Items may be created on
+worker threads, so the set is guarded by a mutex.
 
 *******************************************************************************/
-int ListItem::findPropByName(const std::string & propname, int & propidx,
-                             int & lbound, int & rbound) const
+const std::string * ListItem::internPropName(std::string_view propname)
 {
-  std::string left, right, mid;
-  int midbound;
+  static std::set<std::string, std::less<> > names;
+  static std::mutex names_mutex;
+  std::set<std::string, std::less<> >::const_iterator it;
 
-  left = _props[lbound].propname;
-  right = _props[rbound].propname;
+  std::lock_guard<std::mutex> lock(names_mutex);
+  it = names.find(propname);
+  if (it == names.end()) { it = names.emplace(propname).first; }
 
-  // Check if outside the bounds
-
-  if ( (propname < left) || (propname > right) )
-    return 1;
-
-  // Check bounds for match
-
-  if (propname == left)
-  {
-    propidx = lbound;
-    return 0;
-  }
-  else if (propname == right)
-  {
-    propidx = rbound;
-    return 0;
-  }
-
-  // Cut the list in half and try again
-
-  midbound = std::floor(double(lbound+rbound)/2.);
-  mid = _props[midbound].propname;
-
-  if (propname <= mid)
-    rbound = midbound;
-  else
-    lbound = midbound;
-
-  return findPropByName(propname, propidx, lbound, rbound);
+  return &(*it);
 }
 
 /*******************************************************************************
 
-Searches for a property in the list and returns its index. If it does not
-exist, returns -1.
+Searches for a property in the list using bisection and returns its index. If
+it does not exist, returns -1.
 
 *******************************************************************************/
-int ListItem::propIdxByName(const std::string & propname) const
+int ListItem::propIdxByName(std::string_view propname) const
 {
-  int nprops, propidx, lbound, rbound, check;
+  int lbound, rbound, midbound, check;
 
-  nprops = _props.size();
-  if (nprops == 0)
-    return -1;
-
-  propidx = -1;
   lbound = 0;
-  rbound = nprops-1;
-  check = findPropByName(propname, propidx, lbound, rbound);
+  rbound = int(_props.size())-1;
+  while (lbound <= rbound)
+  {
+    midbound = (lbound+rbound)/2;
+    check = propname.compare(*_props[midbound].propname);
+    if (check == 0) { return midbound; }
+    else if (check < 0) { rbound = midbound-1; }
+    else { lbound = midbound+1; }
+  }
 
-  if (check == 0)
-    return propidx;
-  else
-    return -1;
+  return -1;
 }
 
 /*******************************************************************************
@@ -94,38 +71,18 @@ int ListItem::propIdxByName(const std::string & propname) const
 Sets property by index. Warning: does not check for list bounds.
 
 *******************************************************************************/
-void ListItem::setPropByIdx(unsigned int idx, const std::string & value)
+void ListItem::setPropByIdx(unsigned int idx, std::string_view value)
 {
   _props[idx].value = value;
 }
 
 /*******************************************************************************
 
-Constructors
-
-*******************************************************************************/
-ListItem::ListItem() 
-{ 
-  _name = ""; 
-  _props.resize(0);
-  _hotkey = -1;
-}
-
-ListItem::ListItem(const std::string & name) 
-{ 
-  _name = name; 
-  _props.resize(0);
-  _hotkey = -1;
-}
-
-/*******************************************************************************
-
-Set properties. Methods with return value return 0 for success or 1 for failure.
+Adds a property, or sets it if it is already present, keeping props sorted by
+name
 
 *******************************************************************************/
-void ListItem::setName(const std::string & name) { _name = name; }
-void ListItem::setHotKey(int hotkey) { _hotkey = hotkey; }
-void ListItem::addProp(const std::string & propname, const std::string & value)
+void ListItem::insertProp(std::string_view propname, std::string_view value)
 {
   int propidx;
   unsigned int i, nprops, propinsert;
@@ -135,7 +92,7 @@ void ListItem::addProp(const std::string & propname, const std::string & value)
   if (propidx != -1) { setPropByIdx(propidx, value); }
   else
   {
-    prop.propname = propname;
+    prop.propname = internPropName(propname);
     prop.value = value;
     nprops = _props.size();
 
@@ -144,49 +101,55 @@ void ListItem::addProp(const std::string & propname, const std::string & value)
     propinsert = nprops;
     for ( i = 0; i < nprops; i++ )
     {
-      if (propname < _props[i].propname)
+      if (propname < *_props[i].propname)
       {
         propinsert = i;
         break;
       }
     }
-    _props.insert(_props.begin()+propinsert, prop);
+    _props.insert(_props.begin()+propinsert, std::move(prop));
   }
 }
 
-void ListItem::addBoolProp(const std::string & propname, bool value)
-{
-  int propidx;
-  unsigned int i, nprops, propinsert;
-  listprop prop;
+/*******************************************************************************
 
-  propidx = propIdxByName(propname);
-  if (propidx != -1) { setPropByIdx(propidx, bool2String(value)); }
-  else
-  {
-    prop.propname = propname;
-    prop.value = bool2String(value);
-    nprops = _props.size();
+Constructors
 
-    // Insert in sorted order
+*******************************************************************************/
+ListItem::ListItem() 
+{ 
+  _name = ""; 
+  _props.resize(0);
+  _hotkey = -1;
+}
 
-    propinsert = nprops;
-    for ( i = 0; i < nprops; i++ )
-    {
-      if (propname < _props[i].propname)
-      {
-        propinsert = i;
-        break;
-      }
-    }
-    _props.insert(_props.begin()+propinsert, prop);
-  }
+ListItem::ListItem(const std::string & name) 
+{ 
+  _name = name; 
+  _props.resize(0);
+  _hotkey = -1;
 }
 
-int ListItem::setProp(const std::string & propname, const std::string & value)
+/*******************************************************************************
+
+Set properties. Methods with return value return 0 for success or 1 for failure.
+
+*******************************************************************************/
+void ListItem::setName(const std::string & name) { _name = name; }
+void ListItem::setHotKey(int hotkey) { _hotkey = hotkey; }
+void ListItem::addProp(std::string_view propname, std::string_view value)
+{
+  insertProp(propname, value);
+}
+
+void ListItem::addBoolProp(std::string_view propname, bool value)
+{
+  insertProp(propname, bool2String(value));
+}
+
+int ListItem::setProp(std::string_view propname, std::string_view value)
 {
   int propidx;
-  listprop prop;
 
   propidx = propIdxByName(propname);
   if (propidx == -1) { return 1; }
@@ -197,10 +160,9 @@ int ListItem::setProp(const std::string & propname, const std::string & value)
   }
 }
 
-int ListItem::setBoolProp(const std::string & propname, bool value)
+int ListItem::setBoolProp(std::string_view propname, bool value)
 {
   int propidx;
-  listprop prop;
 
   propidx = propIdxByName(propname);
   if (propidx == -1) { return 1; }
@@ -221,14 +183,14 @@ checkProp.
 *******************************************************************************/
 const std::string & ListItem::name() const { return _name; }
 int ListItem::hotKey() const { return _hotkey; }
-bool ListItem::checkProp(const std::string & propname) const
+bool ListItem::checkProp(std::string_view propname) const
 {
   if ( (propname == "name") || (propIdxByName(propname) != -1) )
     return true;
   else { return false; }
 }
 
-const std::string & ListItem::getProp(const std::string & propname) const
+const std::string & ListItem::getProp(std::string_view propname) const
 {
   int propidx;
   
@@ -240,7 +202,7 @@ const std::string & ListItem::getProp(const std::string & propname) const
   }
 }
 
-bool ListItem::getBoolProp(const std::string & propname) const
+bool ListItem::getBoolProp(std::string_view propname) const
 {
   int propidx;
   
@@ -4,6 +4,7 @@
 #include <cmath>      // floor
 #include <curses.h>
 #include <stdlib.h>   // exit, EXIT_SUCCESS
+#include <thread>     // hardware_concurrency
 #include "Color.h"
 #include "settings.h"
 #include "string_util.h"
@@ -29,12 +30,21 @@
 #include "MouseHelpWindow.h"
 #include "QuickSearch.h"
 #include "PackageInfoBox.h"
+#include "PackageDetails.h"
+#include "JobLogBox.h"
+#include "RepoLoader.h"
+#include "input.h"
 #include "MainWindow.h"
 #include "MouseEvent.h"
 
+/* Added to the status line while installed packages are read at startup */
+
+static const std::string loading_suffix = " Reading installed packages ...";
+
 /*******************************************************************************
 
-Prints/clears status message
+Prints/clears status message. The status line is sent to the terminal right
+away, since it often announces work that is about to start.
 
 *******************************************************************************/
 void MainWindow::printStatus(const std::string & msg, bool bold)
@@ -48,7 +58,8 @@ void MainWindow::printStatus(const std::string & msg, bool bold)
   printToEol(msg, cols);
   if (bold) { attroff(A_BOLD); }
   _status = msg;
-  refresh();
+  wnoutrefresh(stdscr);
+  doupdate();
 }
 
 void MainWindow::clearStatus()
@@ -59,7 +70,8 @@ void MainWindow::clearStatus()
   move(rows-2, 0);
   clrtoeol();
   _status = "";
-  refresh();
+  wnoutrefresh(stdscr);
+  doupdate();
 }
 
 void MainWindow::refreshStatus() { printStatus(_status); }
@@ -93,12 +105,12 @@ void MainWindow::redrawHeaderFooter()
   left = std::floor(mid - double(namelen)/2.0) + 1;
   move(rows-1, 0);
   clrtoeol();
-  colors.turnOn(stdscr, "fg_info", "bg_info");
+  colors.turnOn(stdscr, color::fg_info, color::bg_info);
   printSpaces(left-1);
   printToEol(_info, cols-(left-1));
   colors.turnOff(stdscr);
 
-  refresh();
+  wnoutrefresh(stdscr);
 }
 
 /*******************************************************************************
@@ -206,6 +218,7 @@ Clears windows, data, etc.
 *******************************************************************************/
 void MainWindow::clearData()
 {
+  _loader.stop();
   if (_win1) { delwin(_win1); }
   if (_win2) { delwin(_win2); }
   _blistboxes.resize(0);
@@ -216,19 +229,65 @@ void MainWindow::clearData()
   _taglist.clearList();
   _category_idx = 0;
   _activated_listbox = 0;
+  build_changes.clear();
+}
+
+/*******************************************************************************
+
+Warns about invalid package names and installed SlackBuilds with missing .info
+files
+
+*******************************************************************************/
+void MainWindow::showLoadWarnings(const std::vector<std::string> & pkg_errors,
+                                  const std::vector<std::string> & missing_info,
+                                  bool interactive, MouseEvent * mevent)
+{
+  unsigned int i, npkgerr, nmissing;
+  std::string errmsg;
+
+  // Warning for invalid package names
+
+  npkgerr = pkg_errors.size();
+  if ( (npkgerr > 0) && (settings::warn_invalid_pkgnames) )
+  {
+    errmsg = "The following installed packages have invalid names "
+           + std::string("and were ignored:\n");
+    for ( i = 0; i < npkgerr; i++ ) { errmsg += "\n" + pkg_errors[i]; }
+    errmsg += "\n\nThis warning may be disabled by setting "
+           +  std::string("warn_invalid_pkgnames = false.");
+    if (interactive)
+      displayError(errmsg, true, "Warning", "Ok", mevent);
+    else
+      std::cout << "Error: " << errmsg << std::endl;
+  }
+
+  // Warning for missing info files
+
+  nmissing = missing_info.size();
+  if (nmissing > 0)
+  {
+    errmsg = "The following installed SlackBuilds are missing .info files:\n";
+    for ( i = 0; i < nmissing; i++ ) { errmsg += "\n" + missing_info[i]; }
+    errmsg += "\n\nYou should run the sync command to fix this problem.";
+    if (interactive)
+      displayError(errmsg, true, "Error", "Ok", mevent);
+    else
+      std::cout << "Error: " << errmsg << std::endl;
+  }
 }
 
 /*******************************************************************************
 
-Creates master list of SlackBuilds
+Creates master list of SlackBuilds. When interactive, installed packages and
+build options are read in the background afterwards, so that the lists can be
+shown right away.
 
 *******************************************************************************/
 int MainWindow::readLists(MouseEvent * mevent, bool interactive)
 {
   int check;
-  unsigned int i, ncategories, npkgerr, nmissing;
+  unsigned int i, ncategories;
   std::vector<std::string> pkg_errors, missing_info;
-  std::string errmsg;
 
   // Get list of SlackBuilds
 
@@ -250,6 +309,12 @@ int MainWindow::readLists(MouseEvent * mevent, bool interactive)
 
   resetDisplayedSlackBuilds();
 
+  if (interactive)
+  {
+    _loader.start(_slackbuilds, settings::save_buildopts);
+    return 0;
+  }
+
   // Determine which are installed and get other info
 
   determine_installed(_slackbuilds, pkg_errors, missing_info);
@@ -259,37 +324,64 @@ int MainWindow::readLists(MouseEvent * mevent, bool interactive)
   if (settings::save_buildopts)
     read_buildopts(_slackbuilds);
 
-  // Warning for invalid package names
+  showLoadWarnings(pkg_errors, missing_info, interactive, mevent);
 
-  npkgerr = pkg_errors.size();
-  if ( (npkgerr > 0) && (settings::warn_invalid_pkgnames) )
-  {
-    errmsg = "The following installed packages have invalid names "
-           + std::string("and were ignored:\n");
-    for ( i = 0; i < npkgerr; i++ ) { errmsg += "\n" + pkg_errors[i]; }
-    errmsg += "\n\nThis warning may be disabled by setting "
-           +  std::string("warn_invalid_pkgnames = false.");
-    if (interactive)
-      displayError(errmsg, true, "Warning", "Ok", mevent);
-    else
-      std::cout << "Error: " << errmsg << std::endl;
-  }
+  return 0;
+}
 
-  // Warning for missing info files
+/*******************************************************************************
 
-  nmissing = missing_info.size();
-  if (nmissing > 0)
+Copies installed package info from the background loader into the lists.
+Called while waiting for input. Returns true while loading.
+
+*******************************************************************************/
+bool MainWindow::pollLoading()
+{
+  if (! _loader.active()) { return false; }
+
+  // Redraw only when the lists are on top; otherwise, whatever is covering
+  // them redraws the main window when it goes away.
+
+  if ( (_loader.apply(_slackbuilds) > 0) && _browsing ) { draw(true); }
+
+  if (_loader.busy()) { return true; }
+  if (_browsing) { finishLoading(); }
+
+  return false;
+}
+
+/*******************************************************************************
+
+Finishes background loading: restores the status line and shows warnings
+
+*******************************************************************************/
+void MainWindow::finishLoading(MouseEvent * mevent)
+{
+  std::vector<std::string> pkg_errors, missing_info;
+
+  _loader.apply(_slackbuilds);
+  _loader.finish(pkg_errors);
+  blacklist.save();
+  if (_status == _loaded_status + loading_suffix)
+    printStatus(_loaded_status);
+  showLoadWarnings(pkg_errors, missing_info, true, mevent);
+}
+
+/*******************************************************************************
+
+Waits for background loading, for things that need to know what is installed
+
+*******************************************************************************/
+void MainWindow::waitForLoading(MouseEvent * mevent)
+{
+  if (! _loader.active()) { return; }
+
+  if (_loader.busy())
   {
-    errmsg = "The following installed SlackBuilds are missing .info files:\n";
-    for ( i = 0; i < nmissing; i++ ) { errmsg += "\n" + missing_info[i]; }
-    errmsg += "\n\nYou should run the sync command to fix this problem.";
-    if (interactive)
-      displayError(errmsg, true, "Error", "Ok", mevent);
-    else
-      std::cout << "Error: " << errmsg << std::endl;
+    printStatus("Waiting for installed packages to be read ...");
+    _loader.wait();
   }
-
-  return 0;
+  finishLoading(mevent);
 }
 
 /*******************************************************************************
@@ -310,6 +402,7 @@ void MainWindow::clearTags()
   {
     build = static_cast<BuildListItem *>(_taglist.taggedByIdx(k));
     build->setBoolProp("tagged", false);
+    build_changes.record(build);
   }
   _taglist.clearList();
 
@@ -324,19 +417,82 @@ void MainWindow::clearTags()
 
 /*******************************************************************************
 
-Rebuilds lists after applying changes
+Updates lists after applying changes. Only SlackBuilds that have changed since
+the lists were last updated are added to or removed from the current filter,
+and the highlighted category and SlackBuild stay where they are. Lists filtered
+by search are not searched again.
 
 *******************************************************************************/
 void MainWindow::rebuild(MouseEvent * mevent)
 {
-  unsigned int list_highlight, prev_activated;
-  std::vector<std::string> pkg_errors, missing_info;
-  std::string errmsg, category;
+  unsigned int generation, nfiltered;
+  std::vector<BuildListItem *> changed;
+  bool (*func)(const BuildListItem &);
+  ListItem *category;
 
   // Clear tags
 
   clearTags();
 
+  generation = build_changes.generation();
+  build_changes.since(_shown_generation, changed);
+
+  // Whether a SlackBuild is a non-dependency can change when others are
+  // installed or removed, so these are filtered again from scratch
+
+  if (_filter == "non-dependencies") { refilter(mevent); }
+  else
+  {
+    func = NULL;
+    if (_filter == "installed SlackBuilds") { func = &build_is_installed; }
+    else if (_filter == "upgradable SlackBuilds")
+      func = &build_is_upgradable;
+    else if (_filter == "tagged SlackBuilds") { func = &build_is_tagged; }
+    else if (_filter == "blacklisted SlackBuilds")
+      func = &build_is_blacklisted;
+    else if (_filter == "SlackBuilds with build options set")
+      func = &build_has_buildoptions;
+
+    category = _clistbox.highlightedItem();
+    if (func)
+    {
+      patch_filter(changed, _displayed_slackbuilds, func,
+                   _displayed_categories, _win2, _clistbox, _blistboxes,
+                   nfiltered, settings::cumulative_filters);
+      printFilterStatus(nfiltered);
+      setTagList();
+    }
+    else { update_category_tags(changed, _clistbox, _blistboxes); }
+
+    // If the highlighted category is gone, go back to the category list
+
+    _category_idx = _clistbox.highlight();
+    if ( (_clistbox.numItems() == 0) ||
+         (_clistbox.highlightedItem() != category) )
+    {
+      _clistbox.setActivated(true);
+      _blistboxes[_category_idx].setActivated(false);
+      _activated_listbox = 0;
+    }
+  }
+
+  _shown_generation = generation;
+  build_changes.discard(generation);
+
+  draw(true);
+}
+
+/*******************************************************************************
+
+Filters lists again from scratch, then highlights the same category and
+position in the SlackBuild list if possible
+
+*******************************************************************************/
+void MainWindow::refilter(MouseEvent * mevent)
+{
+  unsigned int list_highlight, prev_activated;
+  std::string category;
+
   // Save original highlight info
 
   category = _clistbox.highlightedName();
@@ -373,8 +529,20 @@ void MainWindow::rebuild(MouseEvent * mevent)
       _activated_listbox = 1;
     }
   }
+}
 
-  draw(true);
+/*******************************************************************************
+
+Checks whether categories should be tagged, only for those with SlackBuilds
+that changed after a generation of build_changes
+
+*******************************************************************************/
+void MainWindow::updateCategoryTags(unsigned int generation)
+{
+  std::vector<BuildListItem *> changed;
+
+  build_changes.since(generation, changed);
+  update_category_tags(changed, _clistbox, _blistboxes);
 }
 
 /*******************************************************************************
@@ -410,6 +578,19 @@ Exit sboui
 *******************************************************************************/
 void MainWindow::quit()
 {
+  Signal choice;
+
+  if (_jobs.busy())
+  {
+    choice = displayError("Background jobs are still running. Quit and stop " +
+                          std::string("them? Unfinished changes will be ") +
+                          std::string("offered again the next time sboui ") +
+                          std::string("starts."), true, "Warning", "Yes No");
+    if (choice != signals::keyEnter) { return; }
+    _jobs.cancel();
+  }
+  _loader.stop();
+  blacklist.save();
   endwin();
   exit(EXIT_SUCCESS);
 }
@@ -422,8 +603,7 @@ Displays all SlackBuilds
 void MainWindow::filterAll(MouseEvent * mevent)
 {
   unsigned int nbuilds;
-  std::string choice;
-  bool (*func)(const BuildListItem &);
+  Signal choice;
 
   _filter = "all SlackBuilds";
   printStatus("Filtering by all SlackBuilds ...");
@@ -432,9 +612,8 @@ void MainWindow::filterAll(MouseEvent * mevent)
   _category_idx = 0;
 
   resetDisplayedSlackBuilds();
-  func = &any_build;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, nbuilds, settings::cumulative_filters);
+  list_all(_slackbuilds, _displayed_categories, _win2, _clistbox, _blistboxes,
+           nbuilds);
 
   if (nbuilds == 0)
   {
@@ -461,8 +640,8 @@ void MainWindow::filterInstalled()
   unsigned int ninstalled;
   std::vector<std::string> pkg_errors, missing_info;
   bool (*func)(const BuildListItem &);
-  std::string msg;
 
+  waitForLoading();
   _filter = "installed SlackBuilds";
   printStatus("Filtering by installed SlackBuilds ...");
 
@@ -472,18 +651,7 @@ void MainWindow::filterInstalled()
   func = &build_is_installed;
   filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
                  _clistbox, _blistboxes, ninstalled, settings::cumulative_filters);
-
-  if (ninstalled == 0) 
-    msg = "No installed SlackBuilds";
-  else if (ninstalled == 1) 
-    msg = "1 installed SlackBuild";
-  else 
-    msg = int_to_string(ninstalled) + " installed SlackBuilds";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(ninstalled);
 
   setTagList();
 }
@@ -498,10 +666,11 @@ void MainWindow::filterUpgradable()
   unsigned int nupgradable;
   std::vector<std::string> pkg_errors, missing_info;
   bool (*func)(const BuildListItem &);
-  std::string msg;
 
+  waitForLoading();
   _filter = "upgradable SlackBuilds";
   printStatus("Filtering by upgradable SlackBuilds ...");
+  ensure_repo_props(list_installed(_slackbuilds), missing_info);
 
   _category_idx = 0;
   _activated_listbox = 0;
@@ -510,20 +679,10 @@ void MainWindow::filterUpgradable()
   func = &build_is_upgradable;
   filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
                  _clistbox, _blistboxes, nupgradable, settings::cumulative_filters);
-
-  if (nupgradable == 0) 
-    msg = "No upgradable SlackBuilds";
-  else if (nupgradable == 1) 
-    msg = "1 upgradable SlackBuild";
-  else 
-    msg = int_to_string(nupgradable) + " upgradable SlackBuilds";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(nupgradable);
 
   setTagList();
+  showLoadWarnings(pkg_errors, missing_info, true);
 }
 
 /*******************************************************************************
@@ -535,7 +694,6 @@ void MainWindow::filterTagged()
 {
   unsigned int ntagged;
   bool (*func)(const BuildListItem &);
-  std::string msg;
 
   _filter = "tagged SlackBuilds";
   printStatus("Filtering by tagged SlackBuilds ...");
@@ -547,18 +705,7 @@ void MainWindow::filterTagged()
   func = &build_is_tagged;
   filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
                  _clistbox, _blistboxes, ntagged, settings::cumulative_filters);
-
-  if (ntagged == 0) 
-    msg = "No tagged SlackBuilds";
-  else if (ntagged == 1) 
-    msg = "1 tagged SlackBuild";
-  else 
-    msg = int_to_string(ntagged) + " tagged SlackBuilds";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(ntagged);
 
   setTagList();
 }
@@ -572,8 +719,8 @@ void MainWindow::filterBlacklisted()
 {
   unsigned int nblacklisted;
   bool (*func)(const BuildListItem &);
-  std::string msg;
 
+  waitForLoading();
   _filter = "blacklisted SlackBuilds";
   printStatus("Filtering by blacklisted SlackBuilds ...");
 
@@ -584,18 +731,7 @@ void MainWindow::filterBlacklisted()
   func = &build_is_blacklisted;
   filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
                  _clistbox, _blistboxes, nblacklisted, settings::cumulative_filters);
-
-  if (nblacklisted == 0) 
-    msg = "No blacklisted SlackBuilds";
-  else if (nblacklisted == 1) 
-    msg = "1 blacklisted SlackBuild";
-  else 
-    msg = int_to_string(nblacklisted) + " blacklisted SlackBuilds";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(nblacklisted);
 
   setTagList();
 }
@@ -610,8 +746,8 @@ void MainWindow::filterNonDeps()
 {
   unsigned int nnondeps;
   std::vector<std::string> pkg_errors, missing_info;
-  std::string msg;
 
+  waitForLoading();
   _filter = "non-dependencies";
   printStatus("Filtering by non-dependencies ...");
 
@@ -621,18 +757,7 @@ void MainWindow::filterNonDeps()
 
   filter_nondeps(_slackbuilds, _displayed_slackbuilds, _displayed_categories,
                  _win2, _clistbox, _blistboxes, nnondeps, settings::cumulative_filters);
-
-  if (nnondeps == 0) 
-    msg = "No non-dependencies";
-  else if (nnondeps == 1) 
-    msg = "1 non-dependency";
-  else 
-    msg = int_to_string(nnondeps) + " non-dependencies";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(nnondeps);
 
   setTagList();
 }
@@ -646,8 +771,8 @@ void MainWindow::filterBuildOptions()
 {
   unsigned int nbuildsopts;
   bool (*func)(const BuildListItem &);
-  std::string msg;
 
+  waitForLoading();
   _filter = "SlackBuilds with build options set";
   printStatus("Filtering by SlackBuilds with build options set ...");
 
@@ -658,18 +783,7 @@ void MainWindow::filterBuildOptions()
   func = &build_has_buildoptions;
   filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
                  _clistbox, _blistboxes, nbuildsopts, settings::cumulative_filters);
-
-  if (nbuildsopts == 0) 
-    msg = "No SlackBuilds with build options set";
-  else if (nbuildsopts == 1) 
-    msg = "1 SlackBuild with build options set";
-  else 
-    msg = int_to_string(nbuildsopts) + " SlackBuilds with build options set";
-  if (settings::cumulative_filters)
-    msg += " in current list.";
-  else
-    msg += ".";
-  printStatus(msg);
+  printFilterStatus(nbuildsopts);
 
   setTagList();
 }
@@ -717,18 +831,71 @@ void MainWindow::filterSearch(const std::string & searchterm,
 
 /*******************************************************************************
 
+Shows the number of SlackBuilds matching the current filter (other than all
+SlackBuilds or a search) in the status line
+
+*******************************************************************************/
+void MainWindow::printFilterStatus(unsigned int nfiltered)
+{
+  unsigned int ndowngrades, i, j, nlists, nitems;
+  std::string msg, singular;
+  BuildListItem *build;
+
+  if (_filter == "non-dependencies")
+    singular = "non-dependency";
+  else if (_filter == "SlackBuilds with build options set")
+    singular = "SlackBuild with build options set";
+  else
+    singular = _filter.substr(0, _filter.size()-1);
+
+  if (nfiltered == 0) 
+    msg = "No " + _filter;
+  else if (nfiltered == 1) 
+    msg = "1 " + singular;
+  else 
+    msg = int_to_string(nfiltered) + " " + _filter;
+  if (settings::cumulative_filters)
+    msg += " in current list";
+
+  // Point out upgradable SlackBuilds where the repository has an older version
+
+  if (_filter == "upgradable SlackBuilds")
+  {
+    ndowngrades = 0;
+    nlists = _blistboxes.size();
+    for ( i = 0; i < nlists; i++ )
+    {
+      nitems = _blistboxes[i].numItems();
+      for ( j = 0; j < nitems; j++ )
+      {
+        build = static_cast<BuildListItem *>(_blistboxes[i].itemByIdx(j));
+        if (build->versionChange() < 0) { ndowngrades++; }
+      }
+    }
+    if (ndowngrades == 1)
+      msg += " (1 is a downgrade)";
+    else if (ndowngrades > 1)
+      msg += " (" + int_to_string(ndowngrades) + " are downgrades)";
+  }
+  msg += ".";
+  printStatus(msg);
+}
+
+/*******************************************************************************
+
 Shows options window
 
 *******************************************************************************/
 int MainWindow::showOptions(MouseEvent * mevent)
 {
   WINDOW *optionswin;
-  std::string selection, errmsg, old_repo_dir, msg;
+  std::string errmsg, old_repo_dir, msg;
+  Signal selection;
   bool getting_input;
   int check_color, check_write;
 
-  clear();
-  refresh();
+  erase();
+  wnoutrefresh(stdscr);
 
   optionswin = newwin(1, 1, 0, 0);
   _options.setWindow(optionswin);
@@ -745,8 +912,8 @@ int MainWindow::showOptions(MouseEvent * mevent)
     if (selection == signals::quit) { getting_input = false; }
     else if (selection == signals::resize) 
     { 
-      clear();
-      refresh();
+      erase();
+      wnoutrefresh(stdscr);
       _options.placeWindow();
     }
     else if (selection == "q") { return 1; }
@@ -817,12 +984,12 @@ Shows help window
 int MainWindow::showHelp(MouseEvent * mevent, bool mouse_help)
 {
   WINDOW *helpwin;
-  std::string selection;
+  Signal selection;
   bool getting_input;
   HelpWindow *help;
 
-  clear();
-  refresh();
+  erase();
+  wnoutrefresh(stdscr);
 
   helpwin = newwin(1, 1, 0, 0);
   if (mouse_help)
@@ -842,8 +1009,8 @@ int MainWindow::showHelp(MouseEvent * mevent, bool mouse_help)
       getting_input = false;
     else if (selection == signals::resize) 
     { 
-      clear();
-      refresh();
+      erase();
+      wnoutrefresh(stdscr);
       help->placeWindow();
     }
     else if (selection == "q") { return 1; }
@@ -878,35 +1045,40 @@ void MainWindow::setTagList()
 
 /*******************************************************************************
 
-Installs/upgrades/reinstalls/removes SlackBuild and dependencies. Returns true
-if anything was changed, false otherwise.
+Installs/upgrades/reinstalls/removes SlackBuilds and dependencies. Multiple
+SlackBuilds (e.g. tagged ones) are merged into a single plan and confirmed
+together. Returns true if anything was changed, false otherwise.
 
 *******************************************************************************/
-bool MainWindow::modifyPackage(BuildListItem & build,
+bool MainWindow::modifyPackage(const std::vector<BuildListItem *> & builds,
                                const std::string & action, int & ninstalled,
                                int & nupgraded, int & nreinstalled,
-                               int & nremoved, bool & cancel_all, bool batch,
-                               MouseEvent * mevent)
+                               int & nremoved, bool batch, MouseEvent * mevent)
 {
   WINDOW *installerwin;
   int check, nchanged_orig, nchanged_new, response, ndeps;
-  std::string selection, msg, choice, deptxt, invdeptxt;
+  std::string msg, deptxt, invdeptxt, buildtxt;
+  Signal choice;
+  Signal selection;
   bool getting_input, needs_rebuild;
   unsigned int i, ninvdeps, nforeign;
   std::vector<const BuildListItem *> foreign;
   InstallBox installer;
   BuildListItem *subbuild;
 
+  if (builds.size() == 1) { buildtxt = builds[0]->name(); }
+  else { buildtxt = int_to_string(builds.size()) + " SlackBuilds"; }
+
   if (settings::resolve_deps)
-    printStatus("Computing dependencies for " + build.name() + " ...");
-  check = installer.create(build, _slackbuilds, action, settings::resolve_deps,
-                           batch, settings::rebuild_inv_deps);
+    printStatus("Computing dependencies for " + buildtxt + " ...");
+  check = installer.create(builds, _slackbuilds, action,
+                           settings::resolve_deps, settings::rebuild_inv_deps);
   installer.setTagList(&_taglist);
 
   if (check == 1) 
   { 
     clearStatus();
-    displayError("Unable to find one or more dependencies of " + build.name() +
+    displayError("Unable to find one or more dependencies of " + buildtxt +
                  std::string(" in repository. Build order may be incomplete."),
                  true, "Warning", "Ok", mevent);
   }
@@ -919,20 +1091,21 @@ bool MainWindow::modifyPackage(BuildListItem & build,
     return false;
   }
 
+  /* The list can possibly be empty when removing tagged SlackBuilds.
+     In this case, there's nothing left to do. */
+
+  if (installer.numItems() == 0)
+  {
+    clearStatus();
+    return false;
+  }
+
   ndeps = installer.numDeps();
   ninvdeps = installer.numInvDeps();
   deptxt = "";
   invdeptxt = "";
   if (settings::resolve_deps)
   {
-    /* The list can possibly be empty when removing tagged SlackBuilds.
-       In this case, there's nothing left to do. */
-    if (ndeps < 0)
-    {
-      clearStatus();
-      return false;
-    }
-
     if (ndeps == 1)
     { 
       if (action == "Remove")
@@ -952,19 +1125,20 @@ bool MainWindow::modifyPackage(BuildListItem & build,
     else if (ninvdeps > 1)
       invdeptxt = " and " + int_to_string(ninvdeps) + " inverse dependencies";
 
-    printStatus(deptxt + invdeptxt + " for " + build.name() + ".");
+    deptxt += invdeptxt + " for " + buildtxt + ". ";
+    printStatus(deptxt);
   }
 
   // Show list of changes to apply and/or apply changes
 
   needs_rebuild = false;
   response = 0;
-  cancel_all = false;
   if (settings::confirm_changes)
   {
     installerwin = newwin(1, 1, 0, 0);
     installer.setWindow(installerwin);
     placePopup(&installer, installerwin);
+    printStatus(deptxt + predictedTimeText(installer));
 
     getting_input = true;
     while (getting_input)
@@ -1004,11 +1178,6 @@ bool MainWindow::modifyPackage(BuildListItem & build,
         }
       }
       else if (selection == signals::quit) { getting_input = false; }
-      else if ( (selection == "c") && (batch) )
-      {
-        getting_input = false;
-        cancel_all = true;
-      }
       else if (selection == "a")
       {
         hideWindow(installerwin);
@@ -1024,12 +1193,24 @@ bool MainWindow::modifyPackage(BuildListItem & build,
         draw(true);
       }
       else if (selection == signals::tag)
+      {
         installer.tagHighlightedSlackBuild();
+        printStatus(deptxt + predictedTimeText(installer));
+      }
     }
     delwin(installerwin);
   }
   else { response = 1; }
 
+  // Queue changes to run in the background
+
+  if ( (response == 1) && settings::background_jobs )
+  {
+    installer.queueChanges(_jobs);
+    pollJobs();
+    return false;
+  }
+
   // Apply changes
 
   if (response == 1)
@@ -1037,8 +1218,10 @@ bool MainWindow::modifyPackage(BuildListItem & build,
     def_prog_mode();
     endwin();
     nchanged_orig = ninstalled + nupgraded + nreinstalled + nremoved;
+    journal.begin();
     check = installer.applyChanges(ninstalled, nupgraded, nreinstalled,
                                    nremoved);
+    journal.finish();
     nchanged_new = ninstalled + nupgraded + nreinstalled + nremoved;
     if (nchanged_new > nchanged_orig) { needs_rebuild = true; }
     reset_prog_mode();
@@ -1062,13 +1245,39 @@ bool MainWindow::modifyPackage(BuildListItem & build,
 
 /*******************************************************************************
 
+Returns text describing predicted time to apply changes in an InstallBox
+
+*******************************************************************************/
+std::string MainWindow::predictedTimeText(const InstallBox & installer) const
+{
+  unsigned int njobs;
+  double total, critical, parallel;
+  std::string text;
+
+  njobs = std::thread::hardware_concurrency();
+  if (njobs < 1) { njobs = 1; }
+  installer.predictTimes(njobs, total, critical, parallel);
+
+  text = "Predicted time: " + duration_to_string(total) + " ("
+       + duration_to_string(critical) + " critical path";
+  if (njobs > 1)
+    text += ", " + duration_to_string(parallel) + " with "
+          + int_to_string(njobs) + " jobs";
+  text += ")";
+
+  return text;
+}
+
+/*******************************************************************************
+
 Allows user to set build options for SlackBuild
 
 *******************************************************************************/
 void MainWindow::setBuildOptions(BuildListItem & build, MouseEvent * mevent)
 {
   WINDOW *buildoptionswin;
-  std::string selection, msg;
+  std::string msg;
+  Signal selection;
   bool getting_input;
   BuildOptionsBox buildoptions;
   int check;
@@ -1088,13 +1297,15 @@ void MainWindow::setBuildOptions(BuildListItem & build, MouseEvent * mevent)
     {
       getting_input = false;
       build.setProp("build_options", buildoptions.entries());
+      build_changes.record(&build);
       if (settings::save_buildopts)
       {
         check = buildoptions.write(build);
         if (check != 0)
         {
           msg = "Unable to save build options: "
-              + std::string("cannot write to /var/lib/sboui/buildopts. ")
+              + std::string("cannot write to ") + buildopts_store.path()
+              + std::string(". ")
               + std::string("Please check permissions.");
           displayError(msg, true, "Warning", "Ok", mevent);
         }
@@ -1123,7 +1334,7 @@ void MainWindow::showBuildOrder(BuildListItem & build, const std::string & mode,
 {
   WINDOW *buildorderwin;
   int check;
-  std::string selection;
+  Signal selection;
   bool getting_input, need_selection;
   unsigned int nbuildorder;
   BuildOrderBox buildorder;
@@ -1223,14 +1434,17 @@ Shows package information about selected SlackBuild
 *******************************************************************************/
 void MainWindow::showPackageInfo(BuildListItem & build, MouseEvent * mevent)
 {
-  std::string selection, msg;
+  std::string msg;
+  Signal selection;
   bool getting_selection;
   PackageInfoBox pkginfo;
+  PackageDetails details;
   WINDOW *pkginfowin;
+  unsigned int hook, shown;
 
   // Make sure repo info is available
 
-  if (! build.getBoolProp("installed")) { build.readPropsFromRepo(); }
+  build.ensureRepoProps();
 
   // Set up message
 
@@ -1248,16 +1462,37 @@ void MainWindow::showPackageInfo(BuildListItem & build, MouseEvent * mevent)
   {
     msg += "Package name: " + build.getProp("package_name") + "\n";
   } 
-  if (build.getBoolProp("blacklisted")) { msg += "Blacklisted: yes"; }
-  else { msg += "Blacklisted: no"; }
+  if (build.getBoolProp("blacklisted")) { msg += "Blacklisted: yes\n"; }
+  else { msg += "Blacklisted: no\n"; }
 
   // Place message box
 
+  details.start(build, _slackbuilds);
+  shown = details.generation();
   pkginfowin = newwin(1, 1, 0, 0);
   pkginfo.setWindow(pkginfowin);
-  pkginfo.setMessage(msg);
+  pkginfo.setMessage(msg + details.text());
   placePopup(&pkginfo, pkginfowin);
 
+  // Extended details are filled in while waiting for input
+
+  hook = add_idle_hook([&]()
+  {
+    bool busy = details.busy();
+
+    details.apply(_slackbuilds);
+    if (details.generation() != shown)
+    {
+      shown = details.generation();
+      pkginfo.setMessage(msg + details.text());
+      placePopup(&pkginfo, pkginfowin);
+      draw(true);
+      pkginfo.draw(true);
+    }
+
+    return busy;
+  });
+
   // Get user input
 
   getting_selection = true;
@@ -1275,6 +1510,9 @@ void MainWindow::showPackageInfo(BuildListItem & build, MouseEvent * mevent)
 
   // Get rid of window
 
+  remove_idle_hook(hook);
+  details.stop();
+  details.apply(_slackbuilds);
   delwin(pkginfowin);
   draw(true);
 }
@@ -1287,7 +1525,8 @@ Displays a file browser in the directory of a given SlackBuild
 void MainWindow::browseFiles(const BuildListItem & build, MouseEvent * mevent)
 {
   WINDOW *browserwin;
-  std::string selection, builddir, type, fname;
+  std::string builddir, type, fname;
+  Signal selection;
   int check;
   bool getting_input;
   DirListBox browser;
@@ -1348,6 +1587,19 @@ Syncs/updates SlackBuilds repository
 int MainWindow::syncRepo(MouseEvent * mevent)
 {
   int check;
+  Signal choice;
+
+  // Syncing reads the lists again, and jobs point into them
+
+  if (_jobs.busy())
+  {
+    choice = displayError("Background jobs are still running. Stop them " +
+                          std::string("and sync? Unfinished changes will be ") +
+                          std::string("offered again after syncing."), true,
+                          "Warning", "Yes No", mevent);
+    if (choice != signals::keyEnter) { return 1; }
+    _jobs.cancel();
+  }
 
   def_prog_mode();
   endwin();
@@ -1374,13 +1626,14 @@ Applies action to tagged SlackBuilds
 void MainWindow::applyTags(const std::string & action, MouseEvent * mevent)
 {
   WINDOW *tagwin;
-  unsigned int ndisplay, i, j, ncategories;
+  unsigned int ndisplay, i, generation;
   int ninstalled, nupgraded, nreinstalled, nremoved;
-  bool getting_input, cancel_all, apply_changes, any_modified, needs_rebuild;
-  std::string selection;
-  std::vector<bool> marked_list;
+  bool getting_input, apply_changes, needs_rebuild;
+  Signal selection;
+  std::vector<BuildListItem *> builds;
   BuildListItem *build;
 
+  waitForLoading(mevent);
   ndisplay = _taglist.getDisplayList(action);
   if (ndisplay == 0)
   {
@@ -1426,51 +1679,33 @@ void MainWindow::applyTags(const std::string & action, MouseEvent * mevent)
   delwin(tagwin);
   draw(true);
 
-  // Store a list of user selections, because in some cases modifyPackage
-  // may change the "marked" property of a build prior to its turn in the
-  // Apply changes loop below
+  // Collect user selections, then resolve and apply them as a single plan
 
-  marked_list.resize(ndisplay);
   for ( i = 0; i < ndisplay; i++ )
   {
     build = static_cast<BuildListItem *>(_taglist.itemByIdx(i));
-    marked_list[i] = build->getBoolProp("marked");
+    if (build->getBoolProp("marked")) { builds.push_back(build); }
   }
 
   // Apply changes
 
   needs_rebuild = false;
-  if (apply_changes)
+  if ( apply_changes && (builds.size() > 0) )
   {
     ninstalled = 0;
     nupgraded = 0;
     nreinstalled = 0;
     nremoved = 0;
-    for ( i = 0; i < ndisplay; i++ ) 
-    {
-      build = static_cast<BuildListItem *>(_taglist.itemByIdx(i));
-      build->setBoolProp("marked", marked_list[i]);
-      if (marked_list[i])
-      { 
-        any_modified = modifyPackage(*build, action, ninstalled, nupgraded,
-                                     nreinstalled, nremoved, cancel_all, true,
-                                     mevent);
-        if (! needs_rebuild) { needs_rebuild = any_modified; }
+    generation = build_changes.generation();
+    needs_rebuild = modifyPackage(builds, action, ninstalled, nupgraded,
+                                  nreinstalled, nremoved, true, mevent);
 
-        // Because tags could have changed, determine if categories should be
-        // tagged
+    // Because tags could have changed, determine if categories of changed
+    // SlackBuilds should be tagged
+
+    updateCategoryTags(generation);
+    draw(true);
 
-        ncategories = _clistbox.numItems();
-        for ( j = 0; j < ncategories; j++ )
-        {
-          if (_blistboxes[j].allTagged())
-            _clistbox.itemByIdx(j)->setBoolProp("tagged", true);
-          else { _clistbox.itemByIdx(j)->setBoolProp("tagged", false); }
-        }
-        draw(true);
-      }
-      if (cancel_all) { break; }
-    }
     if (needs_rebuild)
       displayMessage("Summary of applied changes:\n\n"
            + std::string("Installed: ") + int_to_string(ninstalled) + "\n"
@@ -1487,6 +1722,288 @@ void MainWindow::applyTags(const std::string & action, MouseEvent * mevent)
 
 /*******************************************************************************
 
+Offers to resume changes left unfinished by an interrupted batch, as recorded
+in the journal. The journal is discarded if the user declines.
+
+*******************************************************************************/
+void MainWindow::resumeJournal(MouseEvent * mevent)
+{
+  WINDOW *installerwin;
+  std::vector<journal_step> steps;
+  unsigned int i, nsteps;
+  int nmissing, ninstalled, nupgraded, nreinstalled, nremoved, check;
+  std::string msg;
+  Signal selection;
+  bool getting_input, apply_changes;
+  InstallBox installer;
+
+  if (journal.pending(steps) != 0) { return; }
+  nsteps = steps.size();
+  if (nsteps == 0)
+  {
+    journal.finish();
+    return;
+  }
+  waitForLoading(mevent);
+
+  msg = "A previous batch of changes was interrupted before finishing. "
+      + std::string("Remaining steps:\n\n");
+  for ( i = 0; i < nsteps; i++ )
+  {
+    msg += steps[i].action + " " + steps[i].name + "\n";
+  }
+  msg += "\nResume now? Choosing No discards these steps.";
+  selection = displayMessage(msg, true, "Resume changes", "Yes No", mevent);
+  if (selection != signals::keyEnter)
+  {
+    journal.finish();
+    return;
+  }
+
+  nmissing = installer.createFromSteps(steps, _slackbuilds);
+  installer.setTagList(&_taglist);
+  if (nmissing > 0)
+    displayError("One or more SlackBuilds in the journal could not be found " +
+                 std::string("in the repository and will be skipped."), true,
+                 "Warning", "Ok", mevent);
+  if (installer.numItems() == 0)
+  {
+    journal.finish();
+    displayMessage("All remaining steps had already been completed.", true,
+                   "Information", "Ok", mevent);
+    return;
+  }
+
+  // Show list of changes to apply
+
+  apply_changes = true;
+  if (settings::confirm_changes)
+  {
+    installerwin = newwin(1, 1, 0, 0);
+    installer.setWindow(installerwin);
+    placePopup(&installer, installerwin);
+
+    getting_input = true;
+    while (getting_input)
+    {
+      selection = installer.exec(mevent);
+      if (selection == signals::keyEnter) { getting_input = false; }
+      else if (selection == signals::quit)
+      {
+        getting_input = false;
+        apply_changes = false;
+      }
+      else if (selection == signals::resize)
+      {
+        placePopup(&installer, installerwin);
+        draw(true);
+      }
+      else if (selection == signals::tag)
+        installer.tagHighlightedSlackBuild();
+    }
+    delwin(installerwin);
+    draw(true);
+  }
+  if (! apply_changes) { return; }
+
+  // Apply changes
+
+  ninstalled = 0;
+  nupgraded = 0;
+  nreinstalled = 0;
+  nremoved = 0;
+  def_prog_mode();
+  endwin();
+  journal.begin();
+  check = installer.applyChanges(ninstalled, nupgraded, nreinstalled,
+                                 nremoved);
+  journal.finish();
+  reset_prog_mode();
+  draw(true);
+  if (check != 0)
+    displayError("One or more requested changes was not applied.", true,
+                 "Warning", "Ok", mevent);
+  else
+    displayMessage("All changes were successfully applied. Summary:\n\n"
+         + std::string("Installed: ") + int_to_string(ninstalled) + "\n"
+         + std::string("Upgraded: ") + int_to_string(nupgraded) + "\n"
+         + std::string("Reinstalled: ") + int_to_string(nreinstalled) + "\n"
+         + std::string("Removed: ") + int_to_string(nremoved), false,
+         "Information", "Ok", mevent);
+  if (ninstalled + nupgraded + nreinstalled + nremoved > 0)
+    rebuild(mevent);
+}
+
+/*******************************************************************************
+
+Runs background jobs and shows their progress. Called while waiting for input.
+Returns true while jobs are queued or running.
+
+*******************************************************************************/
+bool MainWindow::pollJobs()
+{
+  bool busy;
+  std::string text;
+
+  busy = _jobs.poll();
+  if (_joblog != NULL)
+  {
+    if (_joblog->update(_jobs)) { _joblog->draw(); }
+  }
+  else
+  {
+    text = _jobs.statusText();
+    if (text != _jobstatus)
+    {
+      _jobstatus = text;
+      printStatus(text);
+    }
+  }
+
+  return busy;
+}
+
+/*******************************************************************************
+
+Shows background jobs and their output
+
+*******************************************************************************/
+void MainWindow::showJobs(MouseEvent * mevent)
+{
+  WINDOW *jobwin;
+  Signal choice;
+  Signal selection;
+  bool getting_input;
+  JobLogBox joblog;
+
+  jobwin = newwin(1, 1, 0, 0);
+  joblog.setWindow(jobwin);
+  joblog.placeWindow();
+  joblog.update(_jobs);
+  _joblog = &joblog;
+
+  getting_input = true;
+  while (getting_input)
+  {
+    selection = joblog.exec(mevent);
+    if ( (selection == signals::quit) ||
+         (selection == signals::keyEnter) )
+      getting_input = false;
+    else if (selection == signals::resize)
+    {
+      joblog.placeWindow();
+      joblog.draw(true);
+    }
+    else if (selection == "c")
+    {
+      if (_jobs.busy())
+      {
+        _joblog = NULL;
+        choice = displayError("Stop all background jobs?", true, "Warning",
+                              "Yes No", mevent);
+        if (choice == signals::keyEnter) { _jobs.cancel(); }
+        _joblog = &joblog;
+        joblog.update(_jobs);
+        joblog.draw(true);
+      }
+    }
+    else if (selection == signals::mouseEvent)
+    {
+      selection = joblog.handleMouseEvent(mevent);
+      if (selection == signals::quit) { getting_input = false; }
+    }
+  }
+
+  _joblog = NULL;
+  _jobstatus = "";
+  delwin(jobwin);
+  draw(true);
+  if (_jobs.takeChanged()) { rebuild(mevent); }
+}
+
+/*******************************************************************************
+
+Shows all SlackBuilds in a single table that can be sorted by any column.
+Number keys choose the sort column; pressing the same one again reverses the
+order.
+
+*******************************************************************************/
+void MainWindow::showBuildTable(MouseEvent * mevent)
+{
+  WINDOW *tablewin;
+  Signal selection;
+  bool getting_input;
+  BuildTableBox table;
+  BuildListItem *build;
+  unsigned int generation, table_generation;
+  std::vector<BuildListItem *> changed;
+
+  // Installed versions must be read before they are listed. Changes made
+  // from the table are held so that they can still be read after the main
+  // lists catch up to them.
+
+  waitForLoading(mevent);
+  generation = build_changes.generation();
+  table_generation = generation;
+  build_changes.hold(generation);
+  tablewin = newwin(1, 1, 0, 0);
+  table.setWindow(tablewin);
+  table.setTagList(&_taglist);
+  table.placeWindow();
+  printStatus("Listing all SlackBuilds ...");
+  table.setBuilds(_slackbuilds);
+  clearStatus();
+
+  getting_input = true;
+  while (getting_input)
+  {
+    selection = table.exec(mevent);
+    build = static_cast<BuildListItem *>(table.highlightedItem());
+
+    if ( (selection == signals::quit) || (selection == "q") )
+      getting_input = false;
+    else if (selection == signals::resize)
+    {
+      draw(true);
+      table.placeWindow();
+      table.draw(true);
+    }
+    else if ( (selection.type() == Signal::Key) &&
+              (selection.key() >= '1') &&
+              (selection.key() < '1' + BuildTableBox::ncolumns) )
+      table.sortBy(BuildTableBox::column(selection.key() - '1'));
+    else if (selection == signals::highlight)
+    {
+      if (build) { printPackageVersion(*build); }
+    }
+    else if (selection == signals::tag)
+      table.tagHighlightedSlackBuild();
+    else if ( (selection == signals::keyEnter) && build )
+    {
+      showBuildActions(*build, false, mevent);
+
+      // Versions may have changed and tags may have been cleared. Only rows
+      // for SlackBuilds that changed need new sort keys.
+
+      build_changes.since(table_generation, changed);
+      table_generation = build_changes.generation();
+      table.updateBuilds(changed);
+      table.placeWindow();
+      table.draw(true);
+    }
+  }
+
+  // Determine if categories of SlackBuilds changed or tagged from the table
+  // should be tagged
+
+  updateCategoryTags(generation);
+  build_changes.release();
+  delwin(tablewin);
+  draw(true);
+}
+
+/*******************************************************************************
+
 Drops to command line to view output
 
 *******************************************************************************/
@@ -1507,17 +2024,18 @@ Displays an error message. Returns response from message box. buttons can
 either be "Ok" (the default), "Ok Cancel", or "Yes No".
 
 *******************************************************************************/
-std::string MainWindow::displayError(const std::string & msg, bool centered,
-                                     const std::string & name,
-                                     const std::string & buttonnames,
-                                     MouseEvent * mevent) 
+Signal MainWindow::displayError(const std::string & msg, bool centered,
+                                const std::string & name,
+                                const std::string & buttonnames,
+                                MouseEvent * mevent) 
 
 {
-  std::string selection;
+  Signal selection;
   bool getting_selection;
   MessageBox errbox(false, centered);
   WINDOW *errwin;
-  std::vector<std::string> buttons, button_signals;
+  std::vector<std::string> buttons;
+  std::vector<Signal> button_signals;
   
   // Set up buttons
 
@@ -1586,16 +2104,17 @@ Displays an info message. Returns response from message box. Buttons can be
 "Ok" (the default), "Ok Cancel", or "Yes No".
 
 *******************************************************************************/
-std::string MainWindow::displayMessage(const std::string & msg, bool centered,
-                                       const std::string & name,
-                                       const std::string & buttonnames,
-                                       MouseEvent * mevent)
+Signal MainWindow::displayMessage(const std::string & msg, bool centered,
+                                  const std::string & name,
+                                  const std::string & buttonnames,
+                                  MouseEvent * mevent)
 {
-  std::string selection;
+  Signal selection;
   bool getting_selection;
   MessageBox msgbox(true, centered);
   WINDOW *msgwin;
-  std::vector<std::string> buttons, button_signals;
+  std::vector<std::string> buttons;
+  std::vector<Signal> button_signals;
 
   // Set up buttons
 
@@ -1632,8 +2151,9 @@ std::string MainWindow::displayMessage(const std::string & msg, bool centered,
   msgbox.setWindow(msgwin);
   msgbox.setName(name);
   msgbox.setMessage(msg);
-  msgbox.setColor("fg_popup", "bg_popup");
-  msgbox.setButtonColor("fg_highlight_active", "bg_highlight_active");
+  msgbox.setColor(color::fg_popup, color::bg_popup);
+  msgbox.setButtonColor(color::fg_highlight_active,
+                        color::bg_highlight_active);
   placePopup(&msgbox, msgwin);
   draw(true);
 
@@ -1665,12 +2185,13 @@ std::string MainWindow::displayMessage(const std::string & msg, bool centered,
 Prints package version information as status for installed SlackBuild.
 
 *******************************************************************************/
-void MainWindow::printPackageVersion(const BuildListItem & build)
+void MainWindow::printPackageVersion(BuildListItem & build)
 {
   std::string statusmsg;
 
   if (build.getBoolProp("installed"))
   {
+    build.ensureRepoProps();
     if (build.getBoolProp("blacklisted"))
       statusmsg = "Installed: " + build.getProp("installed_version") +
         " (build " + build.getProp("installed_buildnum") + ") " +
@@ -1682,6 +2203,7 @@ void MainWindow::printPackageVersion(const BuildListItem & build)
         " (build " + build.getProp("installed_buildnum") + ") " +
         "-> Available: " + build.getProp("available_version") +
         " (build " + build.getProp("available_buildnum") + ") ";
+    if (build.versionChange() < 0) { statusmsg += "(downgrade)"; }
     printStatus(statusmsg);
   }
   else
@@ -1764,6 +2286,8 @@ void MainWindow::menubarActions(MouseEvent * mevent)
       upgradeAll(mevent);
     else if (entry == "Search")
       search(mevent);
+    else if (entry == "Background jobs")
+      showJobs(mevent);
   }
   else if (list == "Filter")
   {
@@ -1909,22 +2433,18 @@ void MainWindow::tagSelectedSlackBuild()
 void MainWindow::showSelectedBuildActions(bool limited_actions,
                                           MouseEvent * mevent)
 {
-  unsigned int i, ncategories;
+  unsigned int generation;
   BuildListItem *build;
 
   build = static_cast<BuildListItem *>(
                             _blistboxes[_category_idx].highlightedItem());
+  generation = build_changes.generation();
   showBuildActions(*build, limited_actions, mevent);
 
-  // Determine if categories should be tagged and redraw
+  // Determine if categories of changed SlackBuilds should be tagged and
+  // redraw
 
-  ncategories = _clistbox.numItems();
-  for ( i = 0; i < ncategories; i++ )
-  {
-    if (_blistboxes[i].allTagged())
-      _clistbox.itemByIdx(i)->setBoolProp("tagged", true);
-    else { _clistbox.itemByIdx(i)->setBoolProp("tagged", false); }
-  }
+  updateCategoryTags(generation);
   draw(true);
 }
 
@@ -1946,10 +2466,20 @@ MainWindow::MainWindow(const std::string & version)
   _info = "s: Sync | f: Filter | /: Search | o: Options | F9: Menu";
   _status = "";
   _conf_file = "";
+  _jobstatus = "";
+  _joblog = NULL;
+  _loaded_status = "";
+  _browsing = false;
   _category_idx = 0;
   _activated_listbox = 0;
+  _shown_generation = 0;
   setWindow(stdscr);
 
+  // Background jobs and loading make progress while waiting for input
+
+  add_idle_hook([this]() { return pollJobs(); });
+  add_idle_hook([this]() { return pollLoading(); });
+
   // Set up menubar
 
   _menubar.setWindow(stdscr);
@@ -1965,6 +2495,7 @@ MainWindow::MainWindow(const std::string & version)
   _menubar.addListItem("Actions", "Sync", "s", 0);
   _menubar.addListItem("Actions", "Upgrade all", "Ctrl-u", 0);
   _menubar.addListItem("Actions", "Search", "/", 1);
+  _menubar.addListItem("Actions", "Background jobs", "j", 0);
 
   _menubar.addList("Filter", 2);
   _menubar.addListItem("Filter", "All", "", 0);
@@ -2034,6 +2565,12 @@ int MainWindow::initialize(MouseEvent * mevent)
     else if (_filter == "SlackBuilds with build options set")
       filterBuildOptions();
     else { filterAll(mevent); }
+
+    if (_loader.active())
+    {
+      _loaded_status = _status;
+      printStatus(_status + loading_suffix);
+    }
   }
   else
   { 
@@ -2049,6 +2586,10 @@ int MainWindow::initialize(MouseEvent * mevent)
   }
   draw(true);
 
+  // Offer to finish a batch of changes that was interrupted last time
+
+  if (retval == 0) { resumeJournal(mevent); }
+
   return retval;
 }
 
@@ -2070,7 +2611,8 @@ Filter dialog
 void MainWindow::selectFilter(MouseEvent * mevent)
 {
   WINDOW *filterwin;
-  std::string selection, selected;
+  std::string selected;
+  Signal selection;
   bool getting_selection;
 
   // Set up window
@@ -2142,7 +2684,7 @@ Search dialog
 void MainWindow::search(MouseEvent * mevent)
 {
   WINDOW *searchwin;
-  std::string selection;
+  Signal selection;
   bool getting_input;
 
   // Set up window and search box
@@ -2195,11 +2737,15 @@ void MainWindow::showBuildActions(BuildListItem & build, bool limited_actions,
                                   MouseEvent * mevent)
 {
   WINDOW *actionwin;
-  std::string selection, selected, action;
+  std::string selected, action;
+  Signal selection;
   int ninstalled, nupgraded, nreinstalled, nremoved;
-  bool getting_selection, cancel_all, check_rebuild, needs_rebuild;
+  bool getting_selection, check_rebuild, needs_rebuild;
   BuildActionBox actionbox;
 
+  waitForLoading(mevent);
+  build.ensureRepoProps();
+
   // Set up windows and dialog
 
   actionwin = newwin(1, 1, 0, 0);
@@ -2298,9 +2844,9 @@ void MainWindow::showBuildActions(BuildListItem & build, bool limited_actions,
         nupgraded = 0;
         nreinstalled = 0;
         nremoved = 0;
-        check_rebuild = modifyPackage(build, action, ninstalled, nupgraded,
-                                      nreinstalled, nremoved, cancel_all, false,
-                                      mevent);
+        check_rebuild = modifyPackage(std::vector<BuildListItem *>(1, &build),
+                                      action, ninstalled, nupgraded,
+                                      nreinstalled, nremoved, false, mevent);
         if (! needs_rebuild) { needs_rebuild = check_rebuild; }
 
         // If any changes were made, actions might need to change too
@@ -2339,7 +2885,8 @@ void MainWindow::quickSearch()
   int rows, cols, check;
   QuickSearch qsearch;
   bool searching;
-  std::string selection, entry;
+  std::string entry;
+  Signal selection;
   BuildListItem *build;
 
   getmaxyx(stdscr, rows, cols);
@@ -2364,7 +2911,7 @@ void MainWindow::quickSearch()
     }
     else if ( (selection == signals::keyEnter) || (selection == signals::quit) )
       searching = false;
-    else if (selection != "ignore")
+    else if (selection != signals::ignore)
     {
       entry = qsearch.text();
       if (_activated_listbox == 0)
@@ -2503,12 +3050,12 @@ void MainWindow::preferredSize(int & height, int & width) const {}
 Handles mouse events
 
 *******************************************************************************/
-std::string MainWindow::handleMouseEvent(MouseEvent * mevent)
+Signal MainWindow::handleMouseEvent(MouseEvent * mevent)
 {
   int ymin1, xmin1, ymax1, xmax1;
   int ymin2, xmin2, ymax2, xmax2;
   int xmin3, xmax3;
-  std::string action;
+  Signal action;
 
   // Determine what was clicked
 
@@ -2584,7 +3131,11 @@ Redraws window
 *******************************************************************************/
 void MainWindow::draw(bool force)
 {
-  clear();
+  // Erase rather than clear, so that the terminal isn't blanked: the screen is
+  // repainted off-screen and only cells that changed are sent on the next
+  // update
+
+  erase();
 
   // Draw stuff
 
@@ -2598,9 +3149,10 @@ void MainWindow::draw(bool force)
 Displays the main window
 
 *******************************************************************************/
-std::string MainWindow::exec(MouseEvent * mevent)
+Signal MainWindow::exec(MouseEvent * mevent)
 {
-  std::string selection, action;
+  Signal action;
+  Signal selection;
   bool getting_input;
   int check_quit;
 
@@ -2615,7 +3167,9 @@ std::string MainWindow::exec(MouseEvent * mevent)
 
     if (_activated_listbox == 0)
     {
+      _browsing = true;
       selection = _clistbox.exec(mevent);
+      _browsing = false;
 
       // Highlighted item changed
 
@@ -2643,7 +3197,9 @@ std::string MainWindow::exec(MouseEvent * mevent)
 
     else if (_activated_listbox == 1)
     {
+      _browsing = true;
       selection = _blistboxes[_category_idx].exec(mevent);
+      _browsing = false;
 
       // Highlighted item changed
 
@@ -2691,11 +3247,13 @@ std::string MainWindow::exec(MouseEvent * mevent)
     }
     else if (selection == "l") { toggleLayout(); }
     else if (selection == "c") { viewCommandLine(); }
+    else if (selection == "j") { showJobs(mevent); }
+    else if (selection == "a") { showBuildTable(mevent); }
     else if (selection == "i") { applyTags("Install", mevent); }
     else if (selection == "u") { applyTags("Upgrade", mevent); }
     else if (selection == "r") { applyTags("Remove", mevent); }
     else if (selection == "e") { applyTags("Reinstall", mevent); }
-    else if ( (selection.size() == 1) && (selection[0] == 0x13) )  // Ctrl-s
+    else if ( selection == Signal(char(0x13)) )  // Ctrl-s
       quickSearch(); 
     else if (selection == signals::keyF9)
     {
@@ -2707,8 +3265,12 @@ std::string MainWindow::exec(MouseEvent * mevent)
       else if (action == signals::mouseEvent)
         handleMouseEvent(mevent);
     }
-    else if ( (selection.size() == 1) && (selection[0] == 0x15) )  // Ctrl-u
+    else if ( selection == Signal(char(0x15)) )  // Ctrl-u
       upgradeAll(mevent);
+
+    // Background jobs may have installed or removed something
+
+    if (_jobs.takeChanged()) { rebuild(mevent); }
   }
 
   return signals::quit;
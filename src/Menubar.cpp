@@ -148,13 +148,14 @@ void Menubar::redrawSingleItem(unsigned int idx)
   pos = menuColumn(idx);
   if ( (int(idx) == _highlight) && (_activated) )
   {
-    color_pair1 = colors.getPair("fg_highlight_active", "bg_highlight_active");
-    color_pair2 = colors.getPair("hotkey", "bg_highlight_active");
+    color_pair1 = colors.getPair(color::fg_highlight_active,
+                                 color::bg_highlight_active);
+    color_pair2 = colors.getPair(color::hotkey, color::bg_highlight_active);
   }
   else
   {
     color_pair1 = colors.getPair(_fg_color, _bg_color);
-    color_pair2 = colors.getPair("hotkey", _bg_color);
+    color_pair2 = colors.getPair(color::hotkey, _bg_color);
   }
 
   // Save highlight idx for redrawing later.
@@ -232,15 +233,15 @@ void Menubar::redrawAllItems()
 User interaction with highlighted list
 
 *******************************************************************************/
-std::string Menubar::execList(MouseEvent * mevent)
+Signal Menubar::execList(MouseEvent * mevent)
 {
-  std::string retval;
+  Signal retval;
 
   placeListBox();
   retval = _lists[_highlight].exec(mevent);
 
   wresize(_listwins[_highlight], 0, 0);
-  wrefresh(_listwins[_highlight]);
+  wnoutrefresh(_listwins[_highlight]);
 
   if (_parent)
     _parent->draw(true);
@@ -261,9 +262,9 @@ Menubar::Menubar()
   _activated = false;
   _lists.resize(0);
   _listwins.resize(0);
-  _fg_color = "fg_title";
-  _bg_color = "bg_title";
-  _redraw_type = "all";
+  _fg_color = color::fg_title;
+  _bg_color = color::bg_title;
+  _redraw_type = redraw::all;
   _pad = 0;
   _outerpad = 0;
   _innerpad = 0;
@@ -277,9 +278,9 @@ Menubar::Menubar(WINDOW *win)
   _activated = false;
   _lists.resize(0);
   _listwins.resize(0);
-  _fg_color = "fg_title";
-  _bg_color = "bg_title";
-  _redraw_type = "all";
+  _fg_color = color::fg_title;
+  _bg_color = color::bg_title;
+  _redraw_type = redraw::all;
   _pad = 0;
   _outerpad = 0;
   _innerpad = 0;
@@ -454,7 +455,7 @@ void Menubar::bounds(int & xmin, int & xmax) const
 Handles mouse event
 
 *******************************************************************************/
-std::string Menubar::handleMouseEvent(MouseEvent * mevent)
+Signal Menubar::handleMouseEvent(MouseEvent * mevent)
 {
   int xmin, xmax, begy, begx, ycurs, xcurs;
   unsigned int i, nlists;
@@ -497,9 +498,9 @@ Draws menubar
 *******************************************************************************/
 void Menubar::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
-  if (_redraw_type == "all")
+  if (_redraw_type == redraw::all)
   {
     int rows, cols;
 
@@ -512,7 +513,7 @@ void Menubar::draw(bool force)
   }
   else
     redrawChangedItems();
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -520,10 +521,10 @@ void Menubar::draw(bool force)
 User interaction
 
 *******************************************************************************/
-std::string Menubar::exec(MouseEvent * mevent)
+Signal Menubar::exec(MouseEvent * mevent)
 {
   int hotkey;
-  std::string retval;
+  Signal retval;
   bool getting_input, needs_selection;
   unsigned int i, nlists;
   char hotcharN, hotcharL;
@@ -553,7 +554,7 @@ std::string Menubar::exec(MouseEvent * mevent)
     // Draw list elements
 
     draw();
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
 
     // Get user input
 
@@ -574,13 +575,13 @@ std::string Menubar::exec(MouseEvent * mevent)
 
     else if (retval == signals::keyRight)
     {
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       highlightNext();
     }
 
     else if (retval == signals::keyLeft)
     {
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       highlightPrevious();
     }
 
@@ -596,7 +597,7 @@ std::string Menubar::exec(MouseEvent * mevent)
 
     // Check hotkeys
 
-    else if (retval.size() == 1)
+    else if (retval.type() == Signal::Key)
     {
       for ( i = 0; i < nlists; i++ )
       {
@@ -605,9 +606,9 @@ std::string Menubar::exec(MouseEvent * mevent)
         {
           hotcharN = _lists[i].name()[hotkey];
           hotcharL = std::tolower(_lists[i].name()[hotkey]);
-          if ( (retval[0] == hotcharN) || (retval[0] == hotcharL) )
+          if ( (retval.key() == hotcharN) || (retval.key() == hotcharL) )
           {
-            _redraw_type = "changed";
+            _redraw_type = redraw::changed;
             setHighlight(i);
           }
         }
@@ -43,7 +43,7 @@ screen or not.
 *******************************************************************************/
 void MenubarList::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
   int rows, cols, rowsavail, lastrow, nspaces, i, hidx, len;
   int color_pair1, color_pair2;
 
@@ -61,16 +61,16 @@ void MenubarList::redrawSingleItem(unsigned int idx)
   {
     if (_activated) 
     { 
-      fg = "fg_highlight_active"; 
-      bg = "bg_highlight_active"; 
+      fg = color::fg_highlight_active; 
+      bg = color::bg_highlight_active; 
     }
     else
     {
-      fg = "fg_highlight_inactive"; 
-      bg = "bg_highlight_inactive"; 
+      fg = color::fg_highlight_inactive; 
+      bg = color::bg_highlight_inactive; 
     }
     color_pair1 = colors.getPair(fg, bg);
-    color_pair2 = colors.getPair("hotkey", bg);
+    color_pair2 = colors.getPair(color::hotkey, bg);
     if (colors.turnOn(_win, color_pair1) != 0)
     { 
       if (_activated) { wattron(_win, A_REVERSE); }
@@ -78,8 +78,8 @@ void MenubarList::redrawSingleItem(unsigned int idx)
   } 
   else
   {
-    color_pair1 = colors.getPair("fg_combobox", "bg_combobox");
-    color_pair2 = colors.getPair("hotkey", "bg_combobox");
+    color_pair1 = colors.getPair(color::fg_combobox, color::bg_combobox);
+    color_pair2 = colors.getPair(color::hotkey, color::bg_combobox);
   }
 
   // Save highlight idx for redrawing later.
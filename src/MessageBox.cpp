@@ -8,6 +8,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "string_util.h"
 #include "MessageBox.h"
 #include "MouseEvent.h"
@@ -32,7 +33,7 @@ void MessageBox::redrawFrame()
   wmove(_win, 1, 1);
   wclrtoeol(_win);
   if ( (! _header_colorize) ||
-       (colors.turnOn(_win, "fg_title", "bg_title") != 0) )
+       (colors.turnOn(_win, color::fg_title, color::bg_title) != 0) )
     wattron(_win, A_BOLD);
   printSpaces(left-1);
   printToEol(_name);
@@ -138,8 +139,8 @@ MessageBox::MessageBox(bool header_colorize, bool centered)
   _margin_h = 0;
   _header_colorize = header_colorize;
   _centered = centered;
-  setColor("fg_warning", "bg_warning");
-  setButtonColor("bg_warning", "fg_warning");
+  setColor(color::fg_warning, color::bg_warning);
+  setButtonColor(color::bg_warning, color::fg_warning);
 }
 
 MessageBox::MessageBox(WINDOW *win, const std::string & name,
@@ -154,8 +155,8 @@ MessageBox::MessageBox(WINDOW *win, const std::string & name,
   _margin_h = 0;
   _header_colorize = header_colorize;
   _centered = centered;
-  setColor("fg_warning", "bg_warning");
-  setButtonColor("bg_warning", "fg_warning");
+  setColor(color::fg_warning, color::bg_warning);
+  setButtonColor(color::bg_warning, color::fg_warning);
 }
 
 /*******************************************************************************
@@ -251,7 +252,7 @@ void MessageBox::preferredSize(int & height, int & width) const
 Handles mouse events
 
 *******************************************************************************/
-std::string MessageBox::handleMouseEvent(MouseEvent * mevent)
+Signal MessageBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs, xcurs;
   unsigned int i, nbuttons;
@@ -277,6 +278,7 @@ std::string MessageBox::handleMouseEvent(MouseEvent * mevent)
           // Redraw and pause for .1 seconds to make button selection visible
 
           draw();
+          doupdate();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -298,7 +300,7 @@ called, there is no _redraw_type for it.
 *******************************************************************************/
 void MessageBox::draw(bool force)
 {
-  if (_redraw_type == "buttons")
+  if (_redraw_type == redraw::buttons)
     redrawButtons();
   else
   {
@@ -307,7 +309,7 @@ void MessageBox::draw(bool force)
     redrawFrame();
     redrawMessage();
   }
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -315,10 +317,10 @@ void MessageBox::draw(bool force)
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
-std::string MessageBox::exec(MouseEvent * mevent)
+Signal MessageBox::exec(MouseEvent * mevent)
 {
   int ch;
-  std::string retval;
+  Signal retval;
   bool getting_input;
   MEVENT event;
 
@@ -332,12 +334,12 @@ std::string MessageBox::exec(MouseEvent * mevent)
    
     // Draw message box
 
-    _redraw_type = "all";
+    _redraw_type = redraw::all;
     draw();
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
   
       // Enter key
 
@@ -369,13 +371,13 @@ std::string MessageBox::exec(MouseEvent * mevent)
 
       case KEY_RIGHT:
         retval = signals::keyRight;
-        _redraw_type = "buttons";
+        _redraw_type = redraw::buttons;
         highlightNextButton();
         break;
 
       case KEY_LEFT:
         retval = signals::keyLeft;
-        _redraw_type = "buttons";
+        _redraw_type = redraw::buttons;
         highlightPreviousButton();
         break;
 
@@ -87,20 +87,19 @@ Constructor and destructor
 OptionsWindow::OptionsWindow()
 {
   int count, line;
-  unsigned int i, nthemes;
 
   _reserved_rows = 4;
   _header_rows = 1;
   _firstprint = _header_rows;
   _msg = "Options";
-  _color_idx = colors.getPair("fg_normal", "bg_normal");
+  _color_idx = colors.getPair(color::fg_normal, color::bg_normal);
 
   count = 0;
   line = 1; 
 
   // UI settings
 
-  _ui_settings.setColor(colors.getPair("header", "bg_normal"));
+  _ui_settings.setColor(colors.getPair(color::header, color::bg_normal));
   _ui_settings.setBold(true);
   addItem(&_ui_settings);
   _items[count]->setName("User interface settings");
@@ -144,6 +143,13 @@ OptionsWindow::OptionsWindow()
   count++;
   line++;
 
+  addItem(&_bgjobs_toggle);
+  _items[count]->setName("Run package operations in background");
+  _items[count]->setPosition(line,1);
+  _items[count]->setWidth(_items[count]->name().size()+4);
+  count++;
+  line++;
+
   addItem(new Label());
   _items[count]->setName("List layout");
   _items[count]->setPosition(line,1);
@@ -161,7 +167,7 @@ OptionsWindow::OptionsWindow()
 
   // Color settings
 
-  _color_settings.setColor(colors.getPair("header", "bg_normal"));
+  _color_settings.setColor(colors.getPair(color::header, color::bg_normal));
   _color_settings.setBold(true);
   addItem(&_color_settings);  
   _items[count]->setName("Color settings");
@@ -184,12 +190,10 @@ OptionsWindow::OptionsWindow()
   count++;
   line += 0;
 
+  // Theme choices are added the first time settings are read
+
   _color_box.setParent(this);
-  nthemes = color_themes.size();
-  for ( i = 0; i < nthemes; i++ )
-  {
-    _color_box.addChoice(color_themes[i].name());
-  }
+  _themes_listed = false;
   addItem(& _color_box);
   _items[count]->setPosition(line,26);
   count++;
@@ -197,7 +201,7 @@ OptionsWindow::OptionsWindow()
 
   // Package manager settings
 
-  _pm_settings.setColor(colors.getPair("header", "bg_normal"));
+  _pm_settings.setColor(colors.getPair(color::header, color::bg_normal));
   _pm_settings.setBold(true);
   addItem(&_pm_settings);  
   _items[count]->setName("Package manager settings");
@@ -355,7 +359,7 @@ OptionsWindow::OptionsWindow()
 
   // Miscellaneous settings
 
-  _misc_settings.setColor(colors.getPair("header", "bg_normal"));
+  _misc_settings.setColor(colors.getPair(color::header, color::bg_normal));
   addItem(&_misc_settings);  
   _items[count]->setName("Miscellaneous settings");
   _items[count]->setPosition(line,1);
@@ -394,11 +398,27 @@ Read and apply settings
 *******************************************************************************/
 void OptionsWindow::readSettings()
 {
+  unsigned int i, nthemes;
+
+  // Theme files are only all read once the options window is shown
+
+  if (! _themes_listed)
+  {
+    get_color_themes();
+    nthemes = color_themes.size();
+    for ( i = 0; i < nthemes; i++ )
+    {
+      _color_box.addChoice(color_themes[i].name());
+    }
+    _themes_listed = true;
+  }
+
   _resolve_toggle.setEnabled(resolve_deps);
   _rebuild_toggle.setEnabled(rebuild_inv_deps);
   _confirm_toggle.setEnabled(confirm_changes);
   _buildopts_toggle.setEnabled(save_buildopts);
   _cumfilt_toggle.setEnabled(cumulative_filters);
+  _bgjobs_toggle.setEnabled(background_jobs);
   _layout_box.setChoice(layout);
 
   _color_toggle.setEnabled(enable_color);
@@ -430,6 +450,7 @@ void OptionsWindow::applySettings(int & check_color, int & check_write,
   confirm_changes = _confirm_toggle.enabled();
   save_buildopts = _buildopts_toggle.enabled();
   cumulative_filters = _cumfilt_toggle.enabled();
+  background_jobs = _bgjobs_toggle.enabled();
   layout = _layout_box.choice();
 
   color_theme = _color_box.choice();
@@ -482,11 +503,12 @@ void OptionsWindow::placeWindow()
 User interaction
 
 *******************************************************************************/
-std::string OptionsWindow::exec(MouseEvent * mevent)
+Signal OptionsWindow::exec(MouseEvent * mevent)
 {
   bool getting_input, needs_selection;
   int y_offset;
-  std::string selection, retval, prev_pkg_mgr;
+  std::string prev_pkg_mgr;
+  Signal selection, retval;
   
   prev_pkg_mgr = _pmgr_box.choice();
 
@@ -497,7 +519,7 @@ std::string OptionsWindow::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _redraw_type = redraw::changed;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
@@ -530,11 +552,13 @@ void OptionsWindow::askSetDefaults(const std::string & new_pkg_mgr,
                                    MouseEvent * mevent)
 {
   WINDOW *defwin;
-  std::string selection, msg;
+  std::string msg;
+  Signal selection;
   DefaultOptionsBox defbox; 
   MessageBox msgbox;
   bool getting_input;
-  std::vector<std::string> buttons(1), button_signals(1);
+  std::vector<std::string> buttons(1);
+  std::vector<Signal> button_signals(1);
 
   defwin = newwin(1, 1, 0, 0);
 
@@ -551,8 +575,9 @@ void OptionsWindow::askSetDefaults(const std::string & new_pkg_mgr,
     buttons[0] = "  Dismiss  ";
     button_signals[0] = signals::keyEnter;
     msgbox.setButtons(buttons, button_signals);
-    msgbox.setColor("fg_popup", "bg_popup");
-    msgbox.setButtonColor("fg_highlight_active", "bg_highlight_active");
+    msgbox.setColor(color::fg_popup, color::bg_popup);
+    msgbox.setButtonColor(color::fg_highlight_active,
+                          color::bg_highlight_active);
     placePopup(&msgbox, defwin);
     draw(true);
 
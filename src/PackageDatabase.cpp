@@ -0,0 +1,149 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>   // fstat
+#include "backend.h"    // split_pkg_name
+#include "PackageDatabase.h"
+
+#ifndef PACKAGE_DIR
+  #define PACKAGE_DIR "/var/lib/pkgtools/packages"
+#endif
+
+/*******************************************************************************
+
+Gets a field of a valid package
+
+*******************************************************************************/
+std::string_view PackageDatabase::getField(unsigned int idx, field fld) const
+{
+  const entry & pkg = _packages[idx];
+
+  if (! pkg.valid) { return std::string_view(); }
+
+  return std::string_view(_names).substr(pkg.pos + pkg.field_pos[fld],
+                                         pkg.field_len[fld]);
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+PackageDatabase::PackageDatabase() {}
+
+/*******************************************************************************
+
+Reads the package database, or another directory of packages. Hidden entries
+are skipped. The buffers are sized up front from the size of the directory
+itself, which is roughly the total length of the names in it, so they rarely
+need to grow.
+
+*******************************************************************************/
+int PackageDatabase::read() { return read(PACKAGE_DIR); }
+
+int PackageDatabase::read(const std::string & path)
+{
+  DIR *pdir;
+  struct dirent *pent;
+  struct stat st;
+  std::string_view fullname, fields[nfields];
+  entry pkg;
+  unsigned int i;
+
+  _names.resize(0);
+  _packages.resize(0);
+
+  pdir = opendir(path.c_str());
+  if (pdir == NULL) { return 1; }
+
+  if ( (fstat(dirfd(pdir), &st) == 0) && (st.st_size > 0) )
+  {
+    _names.reserve(st.st_size);
+    _packages.reserve(st.st_size/32);
+  }
+
+  while ((pent = readdir(pdir)))
+  {
+    if (pent->d_name[0] == '.') { continue; }
+
+    pkg.pos = _names.size();
+    _names += pent->d_name;
+    pkg.len = _names.size() - pkg.pos;
+
+    fullname = std::string_view(_names).substr(pkg.pos, pkg.len);
+    pkg.valid = (split_pkg_name(fullname, fields[Name], fields[Version],
+                                fields[Arch], fields[Build]) == 0);
+    for ( i = 0; i < nfields; i++ )
+    {
+      pkg.field_pos[i] = pkg.valid ? fields[i].data() - fullname.data() : 0;
+      pkg.field_len[i] = fields[i].size();
+    }
+    _packages.push_back(pkg);
+  }
+
+  closedir(pdir);
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Number of packages and whether a package name is well formed
+
+*******************************************************************************/
+unsigned int PackageDatabase::size() const { return _packages.size(); }
+
+bool PackageDatabase::valid(unsigned int idx) const
+{
+  return _packages[idx].valid;
+}
+
+/*******************************************************************************
+
+Full package name and its fields
+
+*******************************************************************************/
+std::string_view PackageDatabase::package(unsigned int idx) const
+{
+  return std::string_view(_names).substr(_packages[idx].pos,
+                                         _packages[idx].len);
+}
+
+std::string_view PackageDatabase::name(unsigned int idx) const
+{
+  return getField(idx, Name);
+}
+
+std::string_view PackageDatabase::version(unsigned int idx) const
+{
+  return getField(idx, Version);
+}
+
+std::string_view PackageDatabase::arch(unsigned int idx) const
+{
+  return getField(idx, Arch);
+}
+
+std::string_view PackageDatabase::build(unsigned int idx) const
+{
+  return getField(idx, Build);
+}
+
+/*******************************************************************************
+
+Index of the first well-formed package with a name, or -1 if none
+
+*******************************************************************************/
+int PackageDatabase::find(std::string_view name) const
+{
+  unsigned int i, npackages;
+
+  npackages = _packages.size();
+  for ( i = 0; i < npackages; i++ )
+  {
+    if (_packages[i].valid && (getField(i, Name) == name)) { return i; }
+  }
+
+  return -1;
+}
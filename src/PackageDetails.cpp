@@ -0,0 +1,501 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <algorithm>    // find
+#include <unordered_set>
+#include <unordered_map>
+#include <sys/stat.h>   // lstat
+#include "BuildListItem.h"
+#include "ShellReader.h"
+#include "string_util.h"
+#include "settings.h"   // repo_dir
+#include "backend.h"
+#include "PackageDetails.h"
+
+#ifndef PACKAGE_DIR
+  #define PACKAGE_DIR "/var/lib/pkgtools/packages"
+#endif
+
+/* Field labels and longest description shown */
+
+static const char *field_labels[PackageDetails::nfields] =
+  { "Description", "Homepage", "Sources", "Dependencies",
+    "Installed dependents", "Disk usage" };
+static const unsigned int max_description = 60;
+
+/*******************************************************************************
+
+Sets a field and lets the user interface know
+
+*******************************************************************************/
+void PackageDetails::set(field fld, const std::string & value)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _values[fld] = value;
+  _generation++;
+}
+
+/*******************************************************************************
+
+Gets requirements of a SlackBuild from its entry, or reads its repo info if
+they haven't been read yet and keeps that for apply(). Returns false if the
+SlackBuild is not in the lists.
+
+*******************************************************************************/
+bool PackageDetails::requirements(unsigned int name_id,
+                                  std::vector<unsigned int> & reqs)
+{
+  std::unordered_map<unsigned int, unsigned int>::const_iterator it;
+  BuildListItem build;
+  repo_info info;
+
+  it = _index.find(name_id);
+  if (it == _index.end()) { return false; }
+  build_entry & entry = _entries[it->second];
+
+  if (! entry.reqs_read)
+  {
+    build.setNameAndCategory(interned_names.str(entry.name_id),
+                             interned_names.str(entry.category_id));
+    info.category = entry.category;
+    info.build = entry.build;
+    info.name_id = entry.name_id;
+    info.check = get_repo_info(build, info.available_version, info.reqs,
+                               info.available_buildnum);
+    interned_names.internList(info.reqs, entry.reqs);
+    entry.reqs_read = true;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _read.push_back(info);
+  }
+  reqs = entry.reqs;
+
+  return true;
+}
+
+/*******************************************************************************
+
+Short description from the first line of slack-desc, or else the first line of
+the README
+
+*******************************************************************************/
+std::string PackageDetails::readDescription() const
+{
+  std::ifstream file;
+  std::string builddir, prefix, line, desc;
+
+  builddir = settings::repo_dir + "/" + _build.getProp("category") + "/" +
+             _build.name() + "/";
+  prefix = _build.name() + ":";
+  desc = "";
+
+  file.open((builddir + "slack-desc").c_str());
+  while (file.is_open() && std::getline(file, line))
+  {
+    if (line.compare(0, prefix.size(), prefix) != 0) { continue; }
+    desc = remove_leading_whitespace(trim(line.substr(prefix.size())));
+    if (desc != "") { break; }
+  }
+  file.close();
+
+  if (desc == "")
+  {
+    file.clear();
+    file.open((builddir + "README").c_str());
+    while (file.is_open() && std::getline(file, line))
+    {
+      desc = remove_leading_whitespace(trim(line));
+      if (desc != "") { break; }
+    }
+    file.close();
+  }
+
+  if (desc == "") { return "none"; }
+  if (desc.size() > max_description)
+    desc = desc.substr(0, max_description-3) + "...";
+
+  return desc;
+}
+
+/*******************************************************************************
+
+Homepage from the .info file
+
+*******************************************************************************/
+std::string PackageDetails::readHomepage() const
+{
+  ShellReader reader;
+  std::string info_file, homepage;
+
+  info_file = settings::repo_dir + "/" + _build.getProp("category") + "/" +
+              _build.name() + "/" + _build.name() + ".info";
+  homepage = "";
+  if (reader.open(info_file) == 0)
+  {
+    reader.read("HOMEPAGE", homepage);
+    reader.close();
+  }
+  if (homepage == "") { return "unknown"; }
+
+  return homepage;
+}
+
+/*******************************************************************************
+
+Number of source files from the .info file and the size of those already
+downloaded to the SlackBuild directory. Sizes of files not yet downloaded are
+not looked up, since that would take a network request.
+
+*******************************************************************************/
+std::string PackageDetails::readSources() const
+{
+  ShellReader reader;
+  std::string builddir, downloads, downloads64, fname;
+  std::vector<std::string> urls;
+  unsigned int i, nurls, nsources, ndownloaded;
+  long long size;
+  struct stat st;
+
+  builddir = settings::repo_dir + "/" + _build.getProp("category") + "/" +
+             _build.name() + "/";
+  if (reader.open(builddir + _build.name() + ".info") != 0)
+    return "unknown";
+  reader.read("DOWNLOAD", downloads);
+  reader.read("DOWNLOAD_x86_64", downloads64);
+  reader.close();
+#if defined(__x86_64__)
+  if ( (downloads64 != "") && (downloads64 != "UNSUPPORTED") &&
+       (downloads64 != "UNTESTED") ) { downloads = downloads64; }
+#endif
+  if (downloads == "UNSUPPORTED") { return "unsupported on this arch"; }
+
+  for ( i = 0; i < downloads.size(); i++ )
+  {
+    if ( (downloads[i] == '\n') || (downloads[i] == '\t') ||
+         (downloads[i] == '\\') ) { downloads[i] = ' '; }
+  }
+  urls = split(downloads);
+
+  nsources = 0;
+  ndownloaded = 0;
+  size = 0;
+  nurls = urls.size();
+  for ( i = 0; i < nurls; i++ )
+  {
+    if (urls[i] == "") { continue; }
+    nsources++;
+    fname = urls[i].substr(urls[i].find_last_of('/') + 1);
+    if ( (fname != "") && (stat((builddir + fname).c_str(), &st) == 0) )
+    {
+      ndownloaded++;
+      size += st.st_size;
+    }
+  }
+
+  if (nsources == 0) { return "none"; }
+  if (ndownloaded == 0)
+    return int_to_string(nsources) + " (not downloaded)";
+
+  return int_to_string(nsources) + " (" + int_to_string(ndownloaded)
+       + " downloaded, " + size_to_string(size) + ")";
+}
+
+/*******************************************************************************
+
+Direct and total requirements. Returns an empty string if stopped.
+
+*******************************************************************************/
+std::string PackageDetails::countDependencies()
+{
+  static const unsigned int readme = interned_names.intern("%README%");
+  std::string reqs;
+  std::vector<unsigned int> deplist, pending;
+  std::unordered_set<unsigned int> visited;
+  unsigned int i, ndeps, ndirect, ntotal, id;
+
+  get_reqs(_build, reqs);
+  interned_names.internList(reqs, deplist);
+  ndirect = 0;
+  ndeps = deplist.size();
+  for ( i = 0; i < ndeps; i++ )
+  {
+    if (deplist[i] != readme) { ndirect++; }
+  }
+  if (ndirect == 0) { return "none"; }
+
+  // Everything reachable through requirements, counting each SlackBuild once
+
+  visited.insert(_build.nameId());
+  visited.insert(readme);
+  pending = deplist;
+  ntotal = 0;
+  while (pending.size() > 0)
+  {
+    if (_stop) { return ""; }
+    id = pending.back();
+    pending.pop_back();
+    if (! visited.insert(id).second) { continue; }
+    if (! requirements(id, deplist)) { continue; }
+    ntotal++;
+    pending.insert(pending.end(), deplist.begin(), deplist.end());
+  }
+
+  return int_to_string(ndirect) + " direct, " + int_to_string(ntotal)
+       + " total";
+}
+
+/*******************************************************************************
+
+Installed SlackBuilds that require this one directly, and in total. Returns an
+empty string if stopped.
+
+*******************************************************************************/
+std::string PackageDetails::countDependents()
+{
+  std::vector<unsigned int> installed, pending;
+  std::vector<std::vector<unsigned int> > reqs;
+  std::unordered_set<unsigned int> dependents;
+  unsigned int i, k, nentries, ninstalled, ndirect, id;
+
+  // Requirements of all installed SlackBuilds
+
+  ninstalled = 0;
+  nentries = _entries.size();
+  for ( k = 0; k < nentries; k++ )
+  {
+    if (_entries[k].installed)
+    {
+      installed.push_back(_entries[k].name_id);
+      ninstalled++;
+    }
+  }
+  reqs.resize(ninstalled);
+  for ( i = 0; i < ninstalled; i++ )
+  {
+    if (_stop) { return ""; }
+    requirements(installed[i], reqs[i]);
+  }
+
+  // Installed SlackBuilds that require this one, or require one of those
+
+  ndirect = 0;
+  dependents.insert(_build.nameId());
+  pending.push_back(_build.nameId());
+  while (pending.size() > 0)
+  {
+    if (_stop) { return ""; }
+    id = pending.back();
+    pending.pop_back();
+    for ( i = 0; i < ninstalled; i++ )
+    {
+      if (std::find(reqs[i].begin(), reqs[i].end(), id) == reqs[i].end())
+        continue;
+      if (id == _build.nameId()) { ndirect++; }
+      if (dependents.insert(installed[i]).second)
+        pending.push_back(installed[i]);
+    }
+  }
+  dependents.erase(_build.nameId());
+  if (dependents.size() == 0) { return "none"; }
+
+  return int_to_string(ndirect) + " direct, "
+       + int_to_string(dependents.size()) + " total";
+}
+
+/*******************************************************************************
+
+Total size of the files installed by the package, from the file list in its
+package database entry. Files shared with other packages are counted too.
+
+*******************************************************************************/
+std::string PackageDetails::readDiskUsage() const
+{
+  std::ifstream file;
+  std::string line;
+  bool in_list;
+  unsigned int nlines, nfiles;
+  long long size;
+  struct stat st;
+
+  if (! _build.getBoolProp("installed")) { return "not installed"; }
+
+  file.open((std::string(PACKAGE_DIR) + "/" +
+             _build.getProp("package_name")).c_str());
+  if (! file.is_open()) { return "unknown"; }
+
+  in_list = false;
+  nlines = 0;
+  nfiles = 0;
+  size = 0;
+  while (std::getline(file, line))
+  {
+    if (! in_list)
+    {
+      if (line == "FILE LIST:") { in_list = true; }
+      continue;
+    }
+    if ( (++nlines % 256 == 0) && _stop ) { break; }
+    if ( (line == "") || (line[line.size()-1] == '/') ) { continue; }
+    if ( (lstat(("/" + line).c_str(), &st) == 0) && S_ISREG(st.st_mode) )
+    {
+      nfiles++;
+      size += st.st_size;
+    }
+  }
+  file.close();
+
+  if (nfiles == 0) { return "no files"; }
+  else if (nfiles == 1) { return size_to_string(size) + " in 1 file"; }
+  else
+    return size_to_string(size) + " in " + int_to_string(nfiles) + " files";
+}
+
+/*******************************************************************************
+
+Worker thread. Fields are computed roughly from fastest to slowest.
+
+*******************************************************************************/
+void PackageDetails::run()
+{
+  std::string value;
+  unsigned int k, nentries;
+
+  nentries = _entries.size();
+  for ( k = 0; k < nentries; k++ ) { _index[_entries[k].name_id] = k; }
+
+  if (! _stop) { set(Description, readDescription()); }
+  if (! _stop) { set(Homepage, readHomepage()); }
+  if (! _stop) { set(Sources, readSources()); }
+  if (! _stop) { value = countDependencies(); }
+  if (! _stop) { set(Dependencies, value); }
+  if (! _stop) { value = countDependents(); }
+  if (! _stop) { set(Dependents, value); }
+  if (! _stop) { set(DiskUsage, readDiskUsage()); }
+
+  _running = false;
+}
+
+/*******************************************************************************
+
+Constructor and destructor
+
+*******************************************************************************/
+PackageDetails::PackageDetails()
+{
+  _values.assign(nfields, "");
+  _running = false;
+  _stop = false;
+  _generation = 0;
+}
+
+PackageDetails::~PackageDetails() { stop(); }
+
+/*******************************************************************************
+
+Starts computing fields for a SlackBuild
+
+*******************************************************************************/
+void PackageDetails::start(const BuildListItem & build,
+                  const std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  build_entry entry;
+  unsigned int i, j, ncategories, nbuilds;
+
+  stop();
+
+  _build = build;
+  _entries.resize(0);
+  _index.clear();
+  _read.resize(0);
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      const BuildListItem & item = slackbuilds[i][j];
+      entry.category = i;
+      entry.build = j;
+      entry.name_id = item.nameId();
+      entry.category_id = item.categoryId();
+      entry.installed = item.getBoolProp("installed");
+      entry.reqs_read = item.repoPropsRead();
+      if (entry.reqs_read) { entry.reqs = item.requiresIds(); }
+      else { entry.reqs.resize(0); }
+      _entries.push_back(entry);
+    }
+  }
+  _values.assign(nfields, "");
+  _stop = false;
+  _running = true;
+  _generation++;
+  _worker = std::thread(&PackageDetails::run, this);
+}
+
+/*******************************************************************************
+
+Copies repo info read by the worker into the lists. The lists must be the ones
+passed to start().
+
+*******************************************************************************/
+void PackageDetails::apply(
+                        std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  std::vector<repo_info> read;
+  unsigned int k, nread;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    read.swap(_read);
+  }
+
+  nread = read.size();
+  for ( k = 0; k < nread; k++ )
+  {
+    if (read[k].category >= slackbuilds.size()) { continue; }
+    if (read[k].build >= slackbuilds[read[k].category].size()) { continue; }
+    BuildListItem & item = slackbuilds[read[k].category][read[k].build];
+    if ( (item.nameId() != read[k].name_id) || item.repoPropsRead() )
+      continue;
+    item.setRepoInfo(read[k].check, read[k].available_version, read[k].reqs,
+                     read[k].available_buildnum);
+  }
+}
+
+/*******************************************************************************
+
+Stops the worker
+
+*******************************************************************************/
+void PackageDetails::stop()
+{
+  _stop = true;
+  if (_worker.joinable()) { _worker.join(); }
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+bool PackageDetails::busy() const { return _running; }
+unsigned int PackageDetails::generation() const { return _generation; }
+
+std::string PackageDetails::text() const
+{
+  unsigned int i;
+  std::string text;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  for ( i = 0; i < nfields; i++ )
+  {
+    if (i > 0) { text += "\n"; }
+    text += std::string(field_labels[i]) + ": ";
+    if (_values[i] == "") { text += "..."; }
+    else { text += _values[i]; }
+  }
+
+  return text;
+}
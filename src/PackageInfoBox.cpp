@@ -43,20 +43,22 @@ Constructors
 *******************************************************************************/
 PackageInfoBox::PackageInfoBox()
 {
-  std::vector<std::string> buttons(1), button_signals(1);
+  std::vector<std::string> buttons(1);
+  std::vector<Signal> button_signals(1);
 
   _name = "Package info";
   buttons[0] = "  Ok  ";
   button_signals[0] = signals::keyEnter;
   setButtons(buttons, button_signals);
   _centered = false;
-  setColor("fg_popup", "bg_popup");
-  setButtonColor("fg_highlight_active", "bg_highlight_active");
+  setColor(color::fg_popup, color::bg_popup);
+  setButtonColor(color::fg_highlight_active, color::bg_highlight_active);
 }
 
 PackageInfoBox::PackageInfoBox(WINDOW *win)
 {
-  std::vector<std::string> buttons(1), button_signals(1);
+  std::vector<std::string> buttons(1);
+  std::vector<Signal> button_signals(1);
 
   _win = win;
   _name = "Package info";
@@ -64,8 +66,8 @@ PackageInfoBox::PackageInfoBox(WINDOW *win)
   button_signals[0] = signals::keyEnter;
   setButtons(buttons, button_signals);
   _centered = false;
-  setColor("fg_popup", "bg_popup");
-  setButtonColor("fg_highlight_active", "bg_highlight_active");
+  setColor(color::fg_popup, color::bg_popup);
+  setButtonColor(color::fg_highlight_active, color::bg_highlight_active);
 }
 
 /*******************************************************************************
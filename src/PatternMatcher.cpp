@@ -0,0 +1,263 @@
+#include <vector>
+#include <string>
+#include <cstring>     // strchr
+#include <cctype>      // ispunct, isdigit
+#include <regex>
+#include "PatternMatcher.h"
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+PrefixTrie::PrefixTrie() { clear(); }
+
+/*******************************************************************************
+
+Adds a string or removes all of them
+
+*******************************************************************************/
+void PrefixTrie::insert(const std::string & prefix)
+{
+  unsigned int i, len, cur;
+  std::map<char, unsigned int>::const_iterator it;
+
+  cur = 0;
+  len = prefix.size();
+  for ( i = 0; i < len; i++ )
+  {
+    it = _nodes[cur].children.find(prefix[i]);
+    if (it != _nodes[cur].children.end()) { cur = it->second; }
+    else
+    {
+      _nodes.push_back(node());
+      _nodes.back().terminal = false;
+      _nodes[cur].children[prefix[i]] = _nodes.size()-1;
+      cur = _nodes.size()-1;
+    }
+  }
+  _nodes[cur].terminal = true;
+}
+
+void PrefixTrie::clear()
+{
+  _nodes.resize(1);
+  _nodes[0].children.clear();
+  _nodes[0].terminal = false;
+}
+
+/*******************************************************************************
+
+Checks whether any string in the trie is a prefix of str
+
+*******************************************************************************/
+bool PrefixTrie::hasPrefixOf(const std::string & str) const
+{
+  unsigned int i, len, cur;
+  std::map<char, unsigned int>::const_iterator it;
+
+  cur = 0;
+  len = str.size();
+  for ( i = 0; i < len; i++ )
+  {
+    if (_nodes[cur].terminal) { return true; }
+    it = _nodes[cur].children.find(str[i]);
+    if (it == _nodes[cur].children.end()) { return false; }
+    cur = it->second;
+  }
+
+  return _nodes[cur].terminal;
+}
+
+bool PrefixTrie::empty() const
+{
+  return (_nodes[0].children.size() == 0) && (! _nodes[0].terminal);
+}
+
+/*******************************************************************************
+
+Returns true if the character at idx is escaped by an odd number of
+backslashes before it
+
+*******************************************************************************/
+static bool is_escaped(const std::string & pattern, int idx)
+{
+  int i, nslashes;
+
+  nslashes = 0;
+  for ( i = idx-1; (i >= 0) && (pattern[i] == '\\'); i-- ) { nslashes++; }
+
+  return (nslashes % 2 == 1);
+}
+
+/*******************************************************************************
+
+If pattern has no special characters except for escaped punctuation (like
+\.), sets literal to the string it matches and returns true
+
+*******************************************************************************/
+static bool parse_literal(const std::string & pattern, std::string & literal)
+{
+  unsigned int i, len;
+
+  literal = "";
+  len = pattern.size();
+  for ( i = 0; i < len; i++ )
+  {
+    if (pattern[i] == '\\')
+    {
+      if ( (i+1 < len) && std::ispunct((unsigned char)(pattern[i+1])) )
+        literal += pattern[++i];
+      else { return false; }
+    }
+    else if (std::strchr(".^$|?*+()[]{}", pattern[i])) { return false; }
+    else { literal += pattern[i]; }
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+
+Removes a leading or trailing .* or (.*) from pattern. Returns true if there
+was one.
+
+*******************************************************************************/
+static bool strip_any(std::string & pattern, bool leading)
+{
+  unsigned int len;
+
+  len = pattern.size();
+  if (leading)
+  {
+    if (pattern.compare(0, 4, "(.*)") == 0) { pattern.erase(0, 4); }
+    else if (pattern.compare(0, 2, ".*") == 0) { pattern.erase(0, 2); }
+    else { return false; }
+  }
+  else
+  {
+    if ( (len >= 4) && (pattern.compare(len-4, 4, "(.*)") == 0) &&
+         (! is_escaped(pattern, len-4)) ) { pattern.erase(len-4); }
+    else if ( (len >= 2) && (pattern.compare(len-2, 2, ".*") == 0) &&
+              (! is_escaped(pattern, len-2)) ) { pattern.erase(len-2); }
+    else { return false; }
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+
+Returns true if pattern has a backreference like \1, which would refer to a
+different group once combined with other patterns
+
+*******************************************************************************/
+static bool has_backref(const std::string & pattern)
+{
+  unsigned int i, len;
+
+  len = pattern.size();
+  for ( i = 0; i+1 < len; i++ )
+  {
+    if (pattern[i] != '\\') { continue; }
+    if ( std::isdigit((unsigned char)(pattern[i+1])) &&
+         (pattern[i+1] != '0') ) { return true; }
+    i++;
+  }
+
+  return false;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+PatternMatcher::PatternMatcher() { _have_combined = false; }
+
+/*******************************************************************************
+
+Adds a pattern, sorted by form
+
+*******************************************************************************/
+void PatternMatcher::add(const std::string & pattern)
+{
+  std::string stripped, literal;
+  bool leading, trailing;
+
+  stripped = pattern;
+  leading = strip_any(stripped, true);
+  trailing = strip_any(stripped, false);
+  if (parse_literal(stripped, literal))
+  {
+    if (leading && trailing) { _substrings.push_back(literal); }
+    else if (leading)
+    {
+      _suffixes.insert(std::string(literal.rbegin(), literal.rend()));
+    }
+    else if (trailing) { _prefixes.insert(literal); }
+    else { _literals.insert(literal); }
+    return;
+  }
+
+  // A true regular expression. Compile it alone first, so that an invalid one
+  // is reported the same way as before.
+
+  std::regex reg(pattern);
+  if (has_backref(pattern)) { _backref_regexes.push_back(reg); }
+  else { _regex_sources.push_back(pattern); }
+}
+
+/*******************************************************************************
+
+Builds the combined regular expression
+
+*******************************************************************************/
+void PatternMatcher::compile()
+{
+  unsigned int i, nregexes;
+  std::string combined;
+
+  nregexes = _regex_sources.size();
+  _have_combined = (nregexes > 0);
+  if (! _have_combined) { return; }
+
+  for ( i = 0; i < nregexes; i++ )
+  {
+    if (i > 0) { combined += "|"; }
+    combined += "(?:" + _regex_sources[i] + ")";
+  }
+  _combined = std::regex(combined);
+}
+
+/*******************************************************************************
+
+Checks whether str fully matches any pattern. Cheap checks go first.
+
+*******************************************************************************/
+bool PatternMatcher::match(const std::string & str) const
+{
+  unsigned int i, nsubstrings, nbackrefs;
+
+  if (_literals.count(str) > 0) { return true; }
+  if (_prefixes.hasPrefixOf(str)) { return true; }
+  if ( (! _suffixes.empty()) &&
+       _suffixes.hasPrefixOf(std::string(str.rbegin(), str.rend())) )
+    return true;
+
+  nsubstrings = _substrings.size();
+  for ( i = 0; i < nsubstrings; i++ )
+  {
+    if (str.find(_substrings[i]) != std::string::npos) { return true; }
+  }
+
+  nbackrefs = _backref_regexes.size();
+  for ( i = 0; i < nbackrefs; i++ )
+  {
+    if (std::regex_match(str, _backref_regexes[i])) { return true; }
+  }
+
+  if (_have_combined && std::regex_match(str, _combined)) { return true; }
+
+  return false;
+}
@@ -0,0 +1,450 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>         // strchr
+#include <cerrno>
+#include <thread>          // this_thread
+#include <unistd.h>        // fork, pipe, dup2, execvp, read, close, setpgid
+#include <fcntl.h>         // fcntl, open
+#include <signal.h>        // kill, signal
+#include <sys/types.h>
+#include <sys/resource.h>  // rusage
+#include <sys/wait.h>      // wait4, WIFEXITED, WEXITSTATUS
+#include "Process.h"
+
+extern char **environ;
+
+/* Characters that need a shell to interpret them when not quoted */
+
+static const char *shell_chars = "|&;<>()$`*?[]{}~#\n";
+
+/* How long terminate() gives a process to exit after SIGTERM before killing
+   it, and how often it checks in the meantime */
+
+static const std::chrono::milliseconds term_grace(3000);
+static const std::chrono::milliseconds term_poll(50);
+
+/*******************************************************************************
+
+Splits a string into words, handling single and double quotes and backslash
+escapes as the shell would. needshell is set if the string uses anything else
+the shell interprets (pipes, redirections, variable expansion, globs, ...).
+Returns 0 on success or 1 if quotes are unbalanced.
+
+*******************************************************************************/
+static int split_words(const std::string & str,
+                       std::vector<std::string> & words, bool & needshell)
+{
+  unsigned int i, len;
+  std::string word;
+  bool inword;
+  char quote;
+
+  words.resize(0);
+  len = str.size();
+  inword = false;
+  needshell = false;
+  quote = 0;
+  for ( i = 0; i < len; i++ )
+  {
+    if (quote == '\'')
+    {
+      if (str[i] == '\'') { quote = 0; }
+      else { word += str[i]; }
+    }
+    else if (quote == '"')
+    {
+      if (str[i] == '"') { quote = 0; }
+      else if ( (str[i] == '$') || (str[i] == '`') ) { needshell = true; }
+      else if ( (str[i] == '\\') && (i+1 < len) &&
+                (strchr("\"\\$`", str[i+1]) != NULL) ) { word += str[++i]; }
+      else { word += str[i]; }
+    }
+    else if ( (str[i] == ' ') || (str[i] == '\t') )
+    {
+      if (inword) { words.push_back(word); }
+      word = "";
+      inword = false;
+    }
+    else
+    {
+      inword = true;
+      if ( (str[i] == '\'') || (str[i] == '"') ) { quote = str[i]; }
+      else if (str[i] == '\\')
+      {
+        if (i+1 < len) { word += str[++i]; }
+      }
+      else
+      {
+        if (strchr(shell_chars, str[i]) != NULL) { needshell = true; }
+        word += str[i];
+      }
+    }
+  }
+  if (quote != 0) { return 1; }
+  if (inword) { words.push_back(word); }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Checks whether a word has the form NAME=value
+
+*******************************************************************************/
+static bool is_assignment(const std::string & word)
+{
+  std::string::size_type eq;
+
+  eq = word.find('=');
+  if ( (eq == 0) || (eq == std::string::npos) ) { return false; }
+  if ( (word[0] >= '0') && (word[0] <= '9') ) { return false; }
+
+  return word.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                "abcdefghijklmnopqrstuvwxyz0123456789_") == eq;
+}
+
+/*******************************************************************************
+
+Splits a command string into leading VAR=value assignments and arguments. If
+the command uses shell features, it is run as /bin/sh -c cmd instead. Returns
+0 on success or 1 if the command is empty or has unbalanced quotes.
+
+*******************************************************************************/
+int parse_command(const std::string & cmd, command_line & cl)
+{
+  std::vector<std::string> words;
+  unsigned int i, nwords;
+  bool needshell;
+
+  cl.env.resize(0);
+  cl.argv.resize(0);
+  if (split_words(cmd, words, needshell) != 0) { return 1; }
+
+  if (needshell)
+  {
+    cl.argv.push_back("/bin/sh");
+    cl.argv.push_back("-c");
+    cl.argv.push_back(cmd);
+    return 0;
+  }
+
+  nwords = words.size();
+  for ( i = 0; (i < nwords) && is_assignment(words[i]); i++ )
+  {
+    cl.env.push_back(words[i]);
+  }
+  for ( ; i < nwords; i++ ) { cl.argv.push_back(words[i]); }
+
+  if (cl.argv.size() == 0) { return 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Parses a string of VAR=value assignments, removing any quotes, and appends
+them to env. Returns 0 on success or 1 if the string has anything else in it
+or uses shell features.
+
+*******************************************************************************/
+int parse_assignments(const std::string & str, std::vector<std::string> & env)
+{
+  std::vector<std::string> words;
+  unsigned int i, nwords;
+  bool needshell;
+
+  if ( (split_words(str, words, needshell) != 0) || needshell ) { return 1; }
+  nwords = words.size();
+  for ( i = 0; i < nwords; i++ )
+  {
+    if (! is_assignment(words[i])) { return 1; }
+  }
+  env.insert(env.end(), words.begin(), words.end());
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Constructor and destructor
+
+*******************************************************************************/
+Process::Process()
+{
+  _pid = -1;
+  _outfd = -1;
+  _running = false;
+  _capture = true;
+  _usage.pid = -1;
+  _usage.status = -1;
+  _usage.wall_seconds = 0.;
+  _usage.user_seconds = 0.;
+  _usage.system_seconds = 0.;
+  _usage.max_rss = 0;
+}
+
+Process::~Process()
+{
+  if (_running) { terminate(); }
+  if (_outfd >= 0) { close(_outfd); }
+}
+
+/*******************************************************************************
+
+Records exit status and resources used after the process has been waited for
+
+*******************************************************************************/
+void Process::reap(int status, const struct rusage & ru)
+{
+  std::chrono::duration<double> elapsed;
+
+  _running = false;
+  elapsed = std::chrono::steady_clock::now() - _start;
+  if (WIFEXITED(status)) { _usage.status = WEXITSTATUS(status); }
+  else { _usage.status = -1; }
+  _usage.wall_seconds = elapsed.count();
+  _usage.user_seconds = double(ru.ru_utime.tv_sec)
+                      + double(ru.ru_utime.tv_usec)*1.e-6;
+  _usage.system_seconds = double(ru.ru_stime.tv_sec)
+                        + double(ru.ru_stime.tv_usec)*1.e-6;
+  _usage.max_rss = ru.ru_maxrss;
+}
+
+/*******************************************************************************
+
+Starts command, executing the program directly with the command's environment
+assignments added to sboui's environment. In capture mode, the child gets its
+own process group, so that terminate() also reaches anything it starts, and
+reads stdin from /dev/null, since there is nobody to answer prompts. Returns 0
+on success or 1 if the command could not be started.
+
+*******************************************************************************/
+int Process::start(const command_line & cmd, bool capture)
+{
+  int fds[2], nullfd;
+  unsigned int i, j, nenv, nargs;
+  std::string::size_type eq;
+  std::vector<std::string> envstrings;
+  std::vector<char *> envp, argv;
+
+  if (_running) { return 1; }
+  if (_outfd >= 0)
+  {
+    close(_outfd);
+    _outfd = -1;
+  }
+
+  nargs = cmd.argv.size();
+  if (nargs == 0) { return 1; }
+
+  // Build argument and environment arrays before forking
+
+  for ( i = 0; environ[i] != NULL; i++ ) { envstrings.push_back(environ[i]); }
+  nenv = cmd.env.size();
+  for ( i = 0; i < nenv; i++ )
+  {
+    eq = cmd.env[i].find('=');
+    if (eq == std::string::npos) { continue; }
+    for ( j = 0; j < envstrings.size(); j++ )
+    {
+      if (envstrings[j].compare(0, eq+1, cmd.env[i], 0, eq+1) == 0)
+        break;
+    }
+    if (j < envstrings.size()) { envstrings[j] = cmd.env[i]; }
+    else { envstrings.push_back(cmd.env[i]); }
+  }
+  for ( i = 0; i < envstrings.size(); i++ )
+  {
+    envp.push_back(const_cast<char *>(envstrings[i].c_str()));
+  }
+  envp.push_back(NULL);
+  for ( i = 0; i < nargs; i++ )
+  {
+    argv.push_back(const_cast<char *>(cmd.argv[i].c_str()));
+  }
+  argv.push_back(NULL);
+
+  if (capture && (pipe(fds) != 0)) { return 1; }
+
+  _capture = capture;
+  _start = std::chrono::steady_clock::now();
+  _pid = fork();
+  if (_pid < 0)
+  {
+    if (capture)
+    {
+      close(fds[0]);
+      close(fds[1]);
+    }
+    return 1;
+  }
+
+  // Child
+
+  if (_pid == 0)
+  {
+    signal(SIGINT, SIG_DFL);
+    signal(SIGQUIT, SIG_DFL);
+    if (capture)
+    {
+      setpgid(0, 0);
+      nullfd = open("/dev/null", O_RDONLY);
+      if (nullfd >= 0)
+      {
+        dup2(nullfd, STDIN_FILENO);
+        close(nullfd);
+      }
+      dup2(fds[1], STDOUT_FILENO);
+      dup2(fds[1], STDERR_FILENO);
+      close(fds[0]);
+      close(fds[1]);
+    }
+    environ = &envp[0];
+    execvp(argv[0], &argv[0]);
+    _exit(127);
+  }
+
+  // Parent
+
+  _usage.pid = _pid;
+  _usage.status = -1;
+  _running = true;
+  if (capture)
+  {
+    setpgid(_pid, _pid);
+    close(fds[1]);
+    _outfd = fds[0];
+    fcntl(_outfd, F_SETFL, fcntl(_outfd, F_GETFL) | O_NONBLOCK);
+    fcntl(_outfd, F_SETFD, FD_CLOEXEC);
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Appends any output available now to out. Returns the number of bytes read.
+
+*******************************************************************************/
+int Process::readOutput(std::string & out)
+{
+  char buffer[4096];
+  ssize_t nread;
+  int total;
+
+  if (_outfd < 0) { return 0; }
+
+  total = 0;
+  while ( (nread = read(_outfd, buffer, sizeof(buffer))) > 0 )
+  {
+    out.append(buffer, nread);
+    total += nread;
+  }
+
+  // End of output: all writers have closed the pipe
+
+  if (nread == 0)
+  {
+    close(_outfd);
+    _outfd = -1;
+  }
+
+  return total;
+}
+
+/*******************************************************************************
+
+Checks whether the process is still running, without blocking
+
+*******************************************************************************/
+bool Process::running()
+{
+  int status;
+  struct rusage ru;
+
+  if (! _running) { return false; }
+  if (wait4(_pid, &status, WNOHANG, &ru) == _pid) { reap(status, ru); }
+
+  return _running;
+}
+
+/*******************************************************************************
+
+Waits for the process to exit and returns its exit status
+
+*******************************************************************************/
+int Process::wait()
+{
+  int status;
+  struct rusage ru;
+
+  if (! _running) { return _usage.status; }
+  while (wait4(_pid, &status, 0, &ru) < 0)
+  {
+    if (errno != EINTR)
+    {
+      _running = false;
+      _usage.status = -1;
+      return -1;
+    }
+  }
+  reap(status, ru);
+
+  return _usage.status;
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+int Process::exitStatus() const { return _usage.status; }
+const process_usage & Process::usage() const { return _usage; }
+pid_t Process::pid() const { return _pid; }
+
+/*******************************************************************************
+
+Terminates the process (and its process group in capture mode) and waits for
+it to exit. A process that is still running after a short grace period (e.g.,
+because it traps SIGTERM) is killed with SIGKILL, so this never blocks for
+long.
+
+*******************************************************************************/
+void Process::terminate()
+{
+  int status;
+  pid_t check;
+  struct rusage ru;
+  std::chrono::steady_clock::time_point deadline;
+
+  if (! _running) { return; }
+  if (_capture) { kill(-_pid, SIGTERM); }
+  else { kill(_pid, SIGTERM); }
+
+  deadline = std::chrono::steady_clock::now() + term_grace;
+  check = wait4(_pid, &status, WNOHANG, &ru);
+  while ( (check == 0) && (std::chrono::steady_clock::now() < deadline) )
+  {
+    std::this_thread::sleep_for(term_poll);
+    check = wait4(_pid, &status, WNOHANG, &ru);
+  }
+
+  if (check == 0)
+  {
+    if (_capture) { kill(-_pid, SIGKILL); }
+    else { kill(_pid, SIGKILL); }
+    check = wait4(_pid, &status, 0, &ru);
+  }
+
+  // Someone else already reaped it
+
+  if (check != _pid)
+  {
+    _running = false;
+    _usage.status = -1;
+    return;
+  }
+  reap(status, ru);
+  _usage.status = -1;
+}
@@ -2,6 +2,7 @@
 #include <curses.h>
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "TextInput.h"
 #include "QuickSearch.h"
 #include "MouseEvent.h"
@@ -13,11 +14,11 @@ the entry is changed, because the calling function needs to search as the user
 types.
 
 *******************************************************************************/
-std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
+Signal QuickSearch::exec(int y_offset, MouseEvent * mevent)
 {
   int ch;
   bool getting_input;
-  std::string retval;
+  Signal retval;
   unsigned int check_redraw;
 
   const int MY_DELETE = 330;
@@ -33,12 +34,12 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
     // Redraw (do not highlight, like a regular TextInput)
   
     draw(y_offset, false, false);
-    _redraw_type = "entry";
+    _redraw_type = redraw::entry;
     getting_input = false;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
 
       // Enter key: return Enter signal
 
@@ -46,7 +47,7 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
 
       // Backspace key pressed: delete previous character.
@@ -79,17 +80,17 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
         getting_input = true;
         if (_cursidx > 0) { _cursidx--; }
         if (_cursidx < _firsttext) { _firsttext = _cursidx; }
-        else { _redraw_type = "none"; }
+        else { _redraw_type = redraw::none; }
         break;
       case KEY_RIGHT:
         getting_input = true;
         if (_cursidx < _entry.size()) { _cursidx++; }
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _redraw_type = redraw::none; }
         break;
       case KEY_HOME:
         getting_input = true;
-        if (_cursidx == 0) { _redraw_type = "none"; }
+        if (_cursidx == 0) { _redraw_type = redraw::none; }
         _cursidx = 0;
         _firsttext = 0;
         break;
@@ -97,39 +98,39 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
         getting_input = true;
         _cursidx = _entry.size();
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _redraw_type = redraw::none; }
         break;
       case KEY_PPAGE:
-        retval = "ignore";
-        _redraw_type = "entry";
+        retval = signals::ignore;
+        _redraw_type = redraw::entry;
         break;
       case KEY_NPAGE:
-        retval = "ignore";
-        _redraw_type = "entry";
+        retval = signals::ignore;
+        _redraw_type = redraw::entry;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
 
       // Resize signal
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
 
       // Quit key
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
 
       // Add character to entry
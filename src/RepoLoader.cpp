@@ -0,0 +1,274 @@
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include "BuildListItem.h"
+#include "PackageDatabase.h"
+#include "BuildOptionsStore.h"
+#include "StringInterner.h"
+#include "backend.h"
+#include "RepoLoader.h"
+
+/*******************************************************************************
+
+Gets the location of a SlackBuild by name ID. Returns false if it is not in the
+list.
+
+*******************************************************************************/
+bool RepoLoader::locate(unsigned int name_id, build_location & loc) const
+{
+  if (name_id >= _locations.size()) { return false; }
+  loc = _locations[name_id];
+
+  return (loc.category >= 0);
+}
+
+/*******************************************************************************
+
+Publishes results, leaving results empty
+
+*******************************************************************************/
+void RepoLoader::publish(std::vector<loaded_build> & results)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _published.insert(_published.end(), results.begin(), results.end());
+  results.resize(0);
+}
+
+/*******************************************************************************
+
+Reads the package database and publishes installed SlackBuilds, with their
+installed version, package name, and blacklist status. Invalid package names
+are kept in _pkg_errors.
+
+*******************************************************************************/
+void RepoLoader::readInstalled()
+{
+  PackageDatabase packages;
+  std::vector<loaded_build> results;
+  loaded_build result;
+  std::string name, version, arch;
+  unsigned int ninstalled, k;
+
+  packages.read();
+  ninstalled = packages.size();
+#pragma omp parallel for private(k,result,name,version,arch)
+  for ( k = 0; k < ninstalled; k++ )
+  {
+    if (! packages.valid(k))
+    {
+#pragma omp critical
+      { _pkg_errors.emplace_back(packages.package(k)); }
+      continue;
+    }
+    result.name_id = interned_names.find(packages.name(k));
+    if (! locate(result.name_id, result.loc)) { continue; }
+
+    name = packages.name(k);
+    version = packages.version(k);
+    arch = packages.arch(k);
+    result.installed = true;
+    result.installed_version = version;
+    result.pkgbuild = packages.build(k);
+    result.package_name = packages.package(k);
+    result.blacklisted = blacklist.blacklisted(result.package_name, name,
+                                          version, arch, result.pkgbuild);
+#pragma omp critical
+    { results.push_back(result); }
+  }
+
+  publish(results);
+}
+
+/*******************************************************************************
+
+Reads saved build options and publishes SlackBuilds that have any
+
+*******************************************************************************/
+void RepoLoader::readBuildOpts()
+{
+  std::vector<loaded_build> results;
+  loaded_build result;
+  unsigned int id, nids;
+
+  if (! buildopts_store.loaded())
+  {
+    if (buildopts_store.read() != 0) { return; }
+  }
+  if (buildopts_store.size() == 0) { return; }
+
+  result.installed = false;
+  result.blacklisted = false;
+  nids = _locations.size();
+  for ( id = 0; id < nids; id++ )
+  {
+    if (_stop) { return; }
+    if (! locate(id, result.loc)) { continue; }
+    if (! buildopts_store.lookup(interned_names.str(id),
+                                 result.build_options)) { continue; }
+    result.name_id = id;
+    results.push_back(result);
+  }
+
+  publish(results);
+}
+
+/*******************************************************************************
+
+Worker thread. Installed SlackBuilds are published first so that they can be
+marked right away, and then those with build options. Repository info is not
+read here; see BuildListItem::ensureRepoProps.
+
+*******************************************************************************/
+void RepoLoader::run()
+{
+  readInstalled();
+  if (_read_buildopts && (! _stop)) { readBuildOpts(); }
+
+  _running = false;
+}
+
+/*******************************************************************************
+
+Constructor and destructor
+
+*******************************************************************************/
+RepoLoader::RepoLoader()
+{
+  _running = false;
+  _stop = false;
+  _active = false;
+  _read_buildopts = false;
+}
+
+RepoLoader::~RepoLoader() { stop(); }
+
+/*******************************************************************************
+
+Starts the worker for slackbuilds. Only the location of each SlackBuild is
+handed to the worker.
+
+*******************************************************************************/
+void RepoLoader::start(
+                 const std::vector<std::vector<BuildListItem> > & slackbuilds,
+                 bool read_buildopts)
+{
+  unsigned int i, j, ncategories, nbuilds, id;
+  build_location loc;
+
+  stop();
+
+  loc.category = -1;
+  loc.build = -1;
+  _locations.assign(0, loc);
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      id = slackbuilds[i][j].nameId();
+      if (id >= _locations.size()) { _locations.resize(id+1, loc); }
+      _locations[id].category = i;
+      _locations[id].build = j;
+    }
+  }
+
+  _published.resize(0);
+  _pkg_errors.resize(0);
+  _read_buildopts = read_buildopts;
+  _stop = false;
+  _running = true;
+  _active = true;
+  _worker = std::thread(&RepoLoader::run, this);
+}
+
+/*******************************************************************************
+
+Merges published results into slackbuilds. Properties the user may have changed
+in the meantime, like tags, are left alone. Returns the number of SlackBuilds
+updated.
+
+*******************************************************************************/
+unsigned int RepoLoader::apply(
+                        std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int k, nresults;
+  std::vector<loaded_build> results;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    results.swap(_published);
+  }
+
+  nresults = results.size();
+  for ( k = 0; k < nresults; k++ )
+  {
+    loaded_build & from = results[k];
+    if ( (from.loc.category >= int(slackbuilds.size())) ||
+         (from.loc.build >= int(slackbuilds[from.loc.category].size())) )
+      continue;
+    BuildListItem & to = slackbuilds[from.loc.category][from.loc.build];
+    if (to.nameId() != from.name_id) { continue; }
+
+    if (from.installed)
+    {
+      to.setBoolProp("installed", true);
+      to.setProp("installed_version", from.installed_version);
+      to.parseBuildNum(from.pkgbuild);
+      to.setProp("package_name", from.package_name);
+      to.setBoolProp("blacklisted", from.blacklisted);
+    }
+    if (from.build_options != "")
+      to.setProp("build_options", from.build_options);
+    to.updateUpgradable();
+  }
+
+  return nresults;
+}
+
+/*******************************************************************************
+
+Waits for the worker to finish
+
+*******************************************************************************/
+void RepoLoader::wait()
+{
+  if (_worker.joinable()) { _worker.join(); }
+}
+
+/*******************************************************************************
+
+Waits for the worker, gets invalid package names, and becomes inactive
+
+*******************************************************************************/
+void RepoLoader::finish(std::vector<std::string> & pkg_errors)
+{
+  wait();
+  pkg_errors = _pkg_errors;
+  _published.resize(0);
+  _locations.resize(0);
+  _active = false;
+}
+
+/*******************************************************************************
+
+Stops the worker and discards results
+
+*******************************************************************************/
+void RepoLoader::stop()
+{
+  _stop = true;
+  wait();
+  _published.resize(0);
+  _locations.resize(0);
+  _active = false;
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+bool RepoLoader::active() const { return _active; }
+bool RepoLoader::busy() const { return _running; }
@@ -7,6 +7,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "ListItem.h"
 #include "AbstractListBox.h"
 #include "ScrollBox.h"
@@ -255,7 +256,7 @@ ScrollBox::ScrollBox(WINDOW *win, const std::string & name)
 Handles mouse events
 
 *******************************************************************************/
-std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
+Signal ScrollBox::handleMouseEvent(MouseEvent * mevent)
 {
   int rows, cols, begy, begx, ycurs, xcurs, rowsavail, check_redraw;
   unsigned i, nbuttons;
@@ -285,8 +286,9 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           draw();
+          doupdate();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -310,9 +312,9 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = scrollPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "none";
+            _redraw_type = redraw::none;
           return signals::scroll;
         }
         else
@@ -324,9 +326,9 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = scrollNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           else
-            _redraw_type = "none";
+            _redraw_type = redraw::none;
           return signals::scroll;
         }
         else
@@ -338,9 +340,9 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = scrollFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
         else
-          _redraw_type = "none";
+          _redraw_type = redraw::none;
         return signals::scroll;
       }
     }
@@ -355,18 +357,18 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = scrollPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
     return signals::scroll;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = scrollNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
     else
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
     return signals::scroll;
   }
   else
@@ -379,10 +381,10 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
-std::string ScrollBox::exec(MouseEvent * mevent)
+Signal ScrollBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -394,7 +396,7 @@ std::string ScrollBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
@@ -402,14 +404,14 @@ std::string ScrollBox::exec(MouseEvent * mevent)
     case '\r':
     case KEY_ENTER:
       retval = signals::keyEnter;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Arrows/Home/End/PgUp/Dn: scrolling
@@ -417,52 +419,52 @@ std::string ScrollBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::scroll;
       check_redraw = scrollUp();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
     case KEY_DOWN:
       retval = signals::scroll;
       check_redraw = scrollDown();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
     case KEY_PPAGE:
       retval = signals::scroll;
       check_redraw = scrollPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
     case KEY_NPAGE:
       retval = signals::scroll;
       check_redraw = scrollNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
     case KEY_HOME:
       retval = signals::scroll;
       check_redraw = scrollFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
     case KEY_END:
       retval = signals::scroll;
       check_redraw = scrollLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::none; }
       break;
 
     // Resize signal
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Mouse
@@ -471,7 +473,7 @@ std::string ScrollBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "none";
+        _redraw_type = redraw::none;
         retval = signals::mouseEvent;
       }
       else
@@ -480,7 +482,7 @@ std::string ScrollBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
   }
   return retval;
@@ -27,7 +27,7 @@ void SearchBox::redrawFrame()
   left = std::floor(mid - double(msglen)/2.0) + 1;
   wmove(_win, 1, 1);
   wclrtoeol(_win);
-  if (colors.turnOn(_win, "fg_title", "bg_title") != 0)
+  if (colors.turnOn(_win, color::fg_title, color::bg_title) != 0)
     wattron(_win, A_BOLD);
   printSpaces(left-1);
   printToEol(_msg);
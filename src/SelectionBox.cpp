@@ -4,6 +4,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "ListItem.h"
 #include "SelectionBox.h"
 #include "MouseEvent.h"
@@ -19,7 +20,7 @@ SelectionBox::SelectionBox()
   _header_rows = 3;
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  setColor("fg_popup", "bg_popup");
+  setColor(color::fg_popup, color::bg_popup);
   _modal = true;
   _external_hotkeys.resize(0);
 }
@@ -32,7 +33,7 @@ SelectionBox::SelectionBox(WINDOW *win, const std::string & name)
   _header_rows = 3;
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  setColor("fg_popup", "bg_popup");
+  setColor(color::fg_popup, color::bg_popup);
   _modal = true;
   _external_hotkeys.resize(0);
 }
@@ -58,11 +59,11 @@ void SelectionBox::setExternalHotKeys(std::vector<char> hotkeys)
 User interaction
 
 *******************************************************************************/
-std::string SelectionBox::exec(MouseEvent * mevent)
+Signal SelectionBox::exec(MouseEvent * mevent)
 {
   int ch, check_redraw, hotkey;
   char ch_char, hotcharN, hotcharL;
-  std::string retval;
+  Signal retval;
   bool getting_input, check_hotkeys;
   unsigned int i;
   MEVENT event;
@@ -85,7 +86,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
 
       // Enter key: accept selection
 
@@ -96,41 +97,27 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           retval = _button_signals[_highlighted_button];
         else
           retval = signals::keyEnter;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
       // Arrows/Home/End/PgUp/Dn: change highlighted value
 
       case KEY_UP:
-        check_redraw = highlightPrevious();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
-        break;
       case KEY_DOWN:
-        check_redraw = highlightNext();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
-        break;
       case KEY_PPAGE:
-        check_redraw = highlightPreviousPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
-        break;
       case KEY_NPAGE:
-        check_redraw = highlightNextPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        _redraw_type = moveHighlight(ch);
         break;
       case KEY_HOME:
         check_redraw = highlightFirst();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
       case KEY_END:
         check_redraw = highlightLast();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _redraw_type = redraw::all; }
+        else { _redraw_type = redraw::changed; }
         break;
 
       // Right/Left: change highlighted button
@@ -139,13 +126,13 @@ std::string SelectionBox::exec(MouseEvent * mevent)
         if (_buttons.size() > 0)
         {
           check_redraw = highlightNextButton();
-          if (check_redraw == 1) { _redraw_type = "buttons"; }
-          else { _redraw_type = "none"; }
+          if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+          else { _redraw_type = redraw::none; }
         }
         else
         {
           retval = signals::keyRight;
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           getting_input = false;
         }
         break;
@@ -154,13 +141,13 @@ std::string SelectionBox::exec(MouseEvent * mevent)
         if (_buttons.size() > 0)
         {
           check_redraw = highlightPreviousButton();
-          if (check_redraw == 1) { _redraw_type = "buttons"; }
-          else { _redraw_type = "none"; }
+          if (check_redraw == 1) { _redraw_type = redraw::buttons; }
+          else { _redraw_type = redraw::none; }
         }
         else
         {
           retval = signals::keyLeft;
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
           getting_input = false;
         }
         break;
@@ -169,7 +156,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -177,7 +164,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -185,7 +172,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case KEY_F(9):
         retval = signals::keyF9;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -199,19 +186,19 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           if ( (retval == signals::keyEnter) || (retval == signals::quit) )
           {
             getting_input = false;
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           }
           else if ( (retval == signals::nullEvent) && (! _modal) )
           {
             retval = signals::mouseEvent;
             getting_input = false;
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
           }
         }
         break;
 
       default:
-        _redraw_type = "none";
+        _redraw_type = redraw::none;
         check_hotkeys = true;
         getting_input = true;
         break;
@@ -234,7 +221,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
             if ( (ch_char == hotcharN) || (ch_char == hotcharL) )
             {
               retval = hotcharN;
-              _redraw_type = "all";
+              _redraw_type = redraw::all;
               getting_input = true;
               setHighlight(i);
               break;
@@ -248,7 +235,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           if ( (ch_char == hotcharN) || (ch_char == hotcharL) )
           {
             retval = hotcharN;
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
             getting_input = false;
             break;
           }
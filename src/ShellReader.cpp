@@ -1,4 +1,5 @@
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include "string_util.h"
@@ -6,21 +7,23 @@
 
 /*******************************************************************************
 
-Checks variable name and removes 'varname=' if it is found
+Checks variable name and removes 'varname=' if it is found. The line is only
+changed if it is found, so that lines that don't match cost no copies.
 
 *******************************************************************************/
 bool ShellReader::checkVarname(std::string & line,
                                const std::string & varname) const
 {
-  unsigned int len;
+  std::string_view rest;
+  std::string::size_type len;
 
-  line = remove_comment(line, '#');
-  line = remove_leading_whitespace(line);
+  rest = remove_leading_whitespace_view(remove_comment_view(line, '#'));
 
   len = varname.size();
-  if (line.substr(0, len+1) == varname + "=")
+  if ( (rest.size() > len) && (rest[len] == '=') &&
+       (rest.compare(0, len, varname) == 0) )
   {
-    line = line.substr(len+1, line.size()-len-1);
+    line = std::string(rest.substr(len+1));
     return true;
   }
   else { return false; }
@@ -35,39 +38,42 @@ checkVarname has been called first so that VARNAME= has already been removed.
 int ShellReader::readVariable(std::string & line, std::string & value)
 {
   bool readnext, endvalue;
-  unsigned int len;
+  std::string_view rest, word;
+  std::string_view::size_type len, quote_pos;
   char quote;
-  std::size_t quote_pos;
 
   // Read the first line
 
-  line = trim(line);
-  len = line.size();
+  rest = trim_view(line);
+  len = rest.size();
   readnext = false;
-  if ( (line[0] == '"') || (line[0] == '\'') )
+  quote = '"';
+  if ( (len > 0) && ( (rest[0] == '"') || (rest[0] == '\'') ) )
   {
-    quote = line[0];                        // Get quote character
-    quote_pos = line.substr(1,len-1).find_first_of(quote);
-    if (quote_pos != std::string::npos)
+    quote = rest[0];                        // Get quote character
+    quote_pos = rest.find(quote, 1);
+    if (quote_pos != std::string_view::npos)
     {
-      value = line.substr(1,quote_pos);     // Value between quotes
+      value = rest.substr(1,quote_pos-1);   // Value between quotes
       return 0;
     } 
-    else if (line[len-1] == '\\')
+    else if (rest[len-1] == '\\')
     { 
-      value = trim(line.substr(1,len-2));   // Line continuation
+      value = trim_view(rest.substr(1,len-2));  // Line continuation
       readnext = true;
     }
     else
     {
-      value = trim(line.substr(1,len-1));   // Unclosed quote: go to next line
+      value = trim_view(rest.substr(1));    // Unclosed quote: go to next line
       readnext = true;
     }
   }
   else
   {
     // Just read the thing right after the equal sign
-    value = split(line)[0];
+    Tokenizer words(rest);
+    if (words.next(word)) { value = word; }
+    else { value = ""; }
     return 0;
   }
 
@@ -84,25 +90,25 @@ int ShellReader::readVariable(std::string & line, std::string & value)
         return 1;
       }
       std::getline(_file, line);
-      line = remove_leading_whitespace(line);
-      if (line[0] == '#') { continue; }     // Comment line
-      line = remove_comment(line, '#');
-      line = trim(line);
-
-      len = line.size();
-      quote_pos = line.substr(1,len-1).find_first_of(quote);
-      if (quote_pos != std::string::npos)   // End value
+      rest = remove_leading_whitespace_view(line);
+      if ( (rest.size() > 0) && (rest[0] == '#') ) { continue; }  // Comment
+      rest = trim_view(remove_comment_view(rest, '#'));
+
+      len = rest.size();
+      quote_pos = rest.find(quote, 1);
+      value += " ";
+      if (quote_pos != std::string_view::npos)  // End value
       {
         endvalue = true;
-        value += " " + trim(line.substr(0,quote_pos+1));
+        value += trim_view(rest.substr(0,quote_pos));
       }
-      else if (line[len-1] == '\\')         // Line continuation
+      else if ( (len > 0) && (rest[len-1] == '\\') )  // Line continuation
       {
-        value += " " + trim(line.substr(0,len-2));
+        value += trim_view(rest.substr(0,len-2));
       }
       else                                  // Unclosed quote: go to next line
       {
-        value += " " + trim(line);
+        value += rest;
       }
     }
   }
@@ -118,30 +124,32 @@ span multiple lines.
 *******************************************************************************/
 int ShellReader::readDefaultVariable(std::string & line, std::string & value)
 {
-  std::size_t dollarpos, brace0pos, colonpos, dashpos, brace1pos;
+  std::string_view rest;
+  std::string_view::size_type dollarpos, brace0pos, colonpos, dashpos,
+                              brace1pos;
 
-  line = trim(line);
+  rest = trim_view(line);
 
   // Check to make sure there is a ${VAR:-DEFAULT_VAL} construct
   
-  dollarpos = line.find_first_of('$');
-  if (dollarpos == std::string::npos)
+  dollarpos = rest.find('$');
+  if (dollarpos == std::string_view::npos)
     return 1;
 
-  brace0pos = line.find_first_of('{');
-  if (brace0pos == std::string::npos)
+  brace0pos = rest.find('{');
+  if (brace0pos == std::string_view::npos)
     return 1;
 
-  colonpos = line.find_first_of(':');
-  if (colonpos == std::string::npos)
+  colonpos = rest.find(':');
+  if (colonpos == std::string_view::npos)
     return 1;
 
-  dashpos = line.find_first_of('-');
-  if (dashpos == std::string::npos)
+  dashpos = rest.find('-');
+  if (dashpos == std::string_view::npos)
     return 1;
 
-  brace1pos = line.find_first_of('}');
-  if (brace1pos == std::string::npos)
+  brace1pos = rest.find('}');
+  if (brace1pos == std::string_view::npos)
     return 1;
 
   if (brace0pos < dollarpos)
@@ -158,7 +166,7 @@ int ShellReader::readDefaultVariable(std::string & line, std::string & value)
 
   // Pick out the value
 
-  value = line.substr(dashpos+1,brace1pos-dashpos-1); 
+  value = rest.substr(dashpos+1,brace1pos-dashpos-1); 
 
   return 0;
 }
@@ -0,0 +1,253 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstring>      // memcpy
+#include <stdio.h>      // rename
+#include <sys/stat.h>   // stat
+#include "DirListing.h"
+#include "Snapshot.h"
+
+/* Start of every snapshot file. Change the number when the format changes. */
+
+static const std::string snapshot_magic = "sboui-snapshot 1\n";
+
+/*******************************************************************************
+
+Gets the current state of a file
+
+*******************************************************************************/
+void Snapshot::stampFile(const std::string & path, stamp & st)
+{
+  struct stat sb;
+
+  st.path = path;
+  st.exists = (stat(path.c_str(), &sb) == 0);
+  st.mtime_sec = st.exists ? sb.st_mtim.tv_sec : 0;
+  st.mtime_nsec = st.exists ? sb.st_mtim.tv_nsec : 0;
+  st.size = st.exists ? sb.st_size : 0;
+}
+
+/*******************************************************************************
+
+Encodes values. Integers are stored as 8 bytes in native byte order, since the
+snapshot is only ever read back on the same machine. Strings are stored as
+their length and then their contents.
+
+*******************************************************************************/
+void Snapshot::encodeInt(std::string & buffer, long long val)
+{
+  char bytes[sizeof(long long)];
+
+  std::memcpy(bytes, &val, sizeof(long long));
+  buffer.append(bytes, sizeof(long long));
+}
+
+void Snapshot::encodeString(std::string & buffer, const std::string & str)
+{
+  encodeInt(buffer, str.size());
+  buffer += str;
+}
+
+/*******************************************************************************
+
+Decodes values at pos and moves pos past them. Returns false if the buffer
+ends first.
+
+*******************************************************************************/
+bool Snapshot::decodeInt(const std::string & buffer,
+                         std::string::size_type & pos, long long & val) const
+{
+  if (pos + sizeof(long long) > buffer.size()) { return false; }
+  std::memcpy(&val, buffer.data() + pos, sizeof(long long));
+  pos += sizeof(long long);
+
+  return true;
+}
+
+bool Snapshot::decodeString(const std::string & buffer,
+                            std::string::size_type & pos,
+                            std::string & str) const
+{
+  long long len;
+
+  if (! decodeInt(buffer, pos, len)) { return false; }
+  if ( (len < 0) || (pos + len > buffer.size()) ) { return false; }
+  str = buffer.substr(pos, len);
+  pos += len;
+
+  return true;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+Snapshot::Snapshot() { _pos = 0; }
+
+/*******************************************************************************
+
+Set location of snapshot file
+
+*******************************************************************************/
+void Snapshot::setPath(const std::string & path) { _path = path; }
+
+/*******************************************************************************
+
+Discards all values and dependencies
+
+*******************************************************************************/
+void Snapshot::clear()
+{
+  _deps.resize(0);
+  _data.clear();
+  _pos = 0;
+}
+
+/*******************************************************************************
+
+Records the current state of a file the values depend on. Files that don't
+exist can be added too, so that creating them invalidates the snapshot.
+
+*******************************************************************************/
+void Snapshot::addDependency(const std::string & path)
+{
+  stamp st;
+
+  stampFile(path, st);
+  _deps.push_back(st);
+}
+
+/*******************************************************************************
+
+Adds values
+
+*******************************************************************************/
+void Snapshot::putString(const std::string & str) { encodeString(_data, str); }
+void Snapshot::putBool(bool val) { _data += val ? '\1' : '\0'; }
+
+/*******************************************************************************
+
+Writes snapshot via a temporary file, so that a snapshot that was cut short is
+never read
+
+*******************************************************************************/
+int Snapshot::save(const std::string & key) const
+{
+  DirListing listing;
+  std::ofstream file;
+  std::string buffer, tmppath;
+  std::string::size_type pos;
+  unsigned int i, ndeps;
+
+  if (_path.size() == 0) { return 1; }
+
+  buffer = snapshot_magic;
+  encodeString(buffer, key);
+  ndeps = _deps.size();
+  encodeInt(buffer, ndeps);
+  for ( i = 0; i < ndeps; i++ )
+  {
+    encodeString(buffer, _deps[i].path);
+    encodeInt(buffer, _deps[i].exists ? 1 : 0);
+    encodeInt(buffer, _deps[i].mtime_sec);
+    encodeInt(buffer, _deps[i].mtime_nsec);
+    encodeInt(buffer, _deps[i].size);
+  }
+  encodeString(buffer, _data);
+
+  pos = _path.rfind('/');
+  if ( (pos != std::string::npos) && (pos > 0) )
+  {
+    if (listing.createFromPath(_path.substr(0, pos)) != 0) { return 1; }
+  }
+
+  tmppath = _path + ".tmp";
+  file.open(tmppath.c_str(), std::ios::binary);
+  if (not file.is_open()) { return 1; }
+  file.write(buffer.data(), buffer.size());
+  file.close();
+  if (file.fail()) { return 1; }
+
+  if (rename(tmppath.c_str(), _path.c_str()) != 0) { return 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads snapshot and checks that it was saved with the same key and that none of
+the files it depends on have changed since
+
+*******************************************************************************/
+int Snapshot::load(const std::string & key)
+{
+  std::ifstream file;
+  std::stringstream ss;
+  std::string buffer, savedkey;
+  std::string::size_type pos;
+  long long ndeps, exists, i;
+  stamp saved, current;
+
+  clear();
+  if (_path.size() == 0) { return 1; }
+
+  file.open(_path.c_str(), std::ios::binary);
+  if (not file.is_open()) { return 1; }
+  ss << file.rdbuf();
+  file.close();
+  buffer = ss.str();
+
+  if (buffer.compare(0, snapshot_magic.size(), snapshot_magic) != 0)
+    return 1;
+  pos = snapshot_magic.size();
+  if (! decodeString(buffer, pos, savedkey)) { return 1; }
+  if (savedkey != key) { return 1; }
+
+  if (! decodeInt(buffer, pos, ndeps)) { return 1; }
+  for ( i = 0; i < ndeps; i++ )
+  {
+    if (! ( decodeString(buffer, pos, saved.path) &&
+            decodeInt(buffer, pos, exists) &&
+            decodeInt(buffer, pos, saved.mtime_sec) &&
+            decodeInt(buffer, pos, saved.mtime_nsec) &&
+            decodeInt(buffer, pos, saved.size) ))
+      return 1;
+    saved.exists = (exists != 0);
+
+    stampFile(saved.path, current);
+    if ( (current.exists != saved.exists) ||
+         (current.mtime_sec != saved.mtime_sec) ||
+         (current.mtime_nsec != saved.mtime_nsec) ||
+         (current.size != saved.size) ) { return 1; }
+    _deps.push_back(saved);
+  }
+
+  if (! decodeString(buffer, pos, _data))
+  {
+    clear();
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads the next value
+
+*******************************************************************************/
+bool Snapshot::getString(std::string & str)
+{
+  return decodeString(_data, _pos, str);
+}
+
+bool Snapshot::getBool(bool & val)
+{
+  if (_pos >= _data.size()) { return false; }
+  val = (_data[_pos] != '\0');
+  _pos++;
+
+  return true;
+}
@@ -0,0 +1,87 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include "string_util.h"   // Tokenizer
+#include "StringInterner.h"
+
+const unsigned int StringInterner::none = (unsigned int)(-1);
+
+/*******************************************************************************
+
+Gets or assigns an ID. The caller must hold the lock.
+
+*******************************************************************************/
+unsigned int StringInterner::internLocked(std::string_view str)
+{
+  std::unordered_map<std::string_view, unsigned int>::const_iterator it;
+  unsigned int id;
+
+  it = _ids.find(str);
+  if (it != _ids.end()) { return it->second; }
+
+  id = _strings.size();
+  _strings.emplace_back(str);
+  _ids.emplace(_strings.back(), id);
+
+  return id;
+}
+
+/*******************************************************************************
+
+Gets the ID of a string, giving it one if needed
+
+*******************************************************************************/
+unsigned int StringInterner::intern(std::string_view str)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return internLocked(str);
+}
+
+/*******************************************************************************
+
+Interns each word of a space-separated list, in order, into ids. Words are
+split the same way as split().
+
+*******************************************************************************/
+void StringInterner::internList(std::string_view list,
+                                std::vector<unsigned int> & ids)
+{
+  Tokenizer words(list);
+  std::string_view word;
+
+  ids.resize(0);
+  std::lock_guard<std::mutex> lock(_mutex);
+  while (words.next(word))
+  {
+    if (word.size() > 0) { ids.push_back(internLocked(word)); }
+  }
+}
+
+/*******************************************************************************
+
+Gets the ID of a string, or none if it doesn't have one
+
+*******************************************************************************/
+unsigned int StringInterner::find(std::string_view str) const
+{
+  std::unordered_map<std::string_view, unsigned int>::const_iterator it;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  it = _ids.find(str);
+  if (it == _ids.end()) { return none; }
+
+  return it->second;
+}
+
+/*******************************************************************************
+
+Gets the string for an ID. The reference stays valid even as more strings are
+added.
+
+*******************************************************************************/
+const std::string & StringInterner::str(unsigned int id) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _strings[id];
+}
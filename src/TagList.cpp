@@ -5,6 +5,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "ListItem.h"
 #include "BuildListItem.h"
 #include "SelectionBox.h"
@@ -19,7 +20,7 @@ screen or not.
 *******************************************************************************/
 void TagList::redrawSingleItem(unsigned int idx)
 {
-  std::string fg, bg;
+  color::label fg, bg;
   int rows, cols; 
 
   getmaxyx(_win, rows, cols);
@@ -34,20 +35,20 @@ void TagList::redrawSingleItem(unsigned int idx)
   {
     if (_activated) 
     { 
-      fg = "fg_highlight_active";
-      bg = "bg_highlight_active"; 
+      fg = color::fg_highlight_active;
+      bg = color::bg_highlight_active; 
     }
     else
     {
-      fg = "fg_highlight_inactive";
-      bg = "bg_highlight_inactive"; 
+      fg = color::fg_highlight_inactive;
+      bg = color::bg_highlight_inactive; 
     }
     if (colors.turnOn(_win, fg, bg) != 0)
     { 
       if (_activated) { wattron(_win, A_REVERSE); }
     }
   } 
-  else { colors.turnOn(_win, "fg_popup", "bg_popup"); }
+  else { colors.turnOn(_win, color::fg_popup, color::bg_popup); }
 
   // Save highlight idx for redrawing later.
   // Note: prevents this method from being const.
@@ -113,7 +114,7 @@ void TagList::removeItem(ListItem *item)
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 void TagList::removeItem(unsigned int idx)
@@ -122,7 +123,7 @@ void TagList::removeItem(unsigned int idx)
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 void TagList::clearList()
@@ -132,7 +133,7 @@ void TagList::clearList()
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
 }
 
 /*******************************************************************************
@@ -170,6 +171,7 @@ unsigned int TagList::getDisplayList(const std::string & action)
       }
       else if (action == "Upgrade")
       {
+        item->ensureRepoProps();
         if (item->getBoolProp("upgradable"))
           add_item = true;
       }
@@ -195,10 +197,10 @@ unsigned int TagList::getDisplayList(const std::string & action)
 Handles mouse event
 
 *******************************************************************************/
-std::string TagList::handleMouseEvent(MouseEvent * mevent)
+Signal TagList::handleMouseEvent(MouseEvent * mevent)
 {
   int begy, begx, xcurs;
-  std::string retval;
+  Signal retval;
 
   getbegyx(_win, begy, begx);
   xcurs = mevent->x() - begx;
@@ -214,7 +216,7 @@ std::string TagList::handleMouseEvent(MouseEvent * mevent)
   {
     _items[_highlight]->setBoolProp("marked", 
                                (! _items[_highlight]->getBoolProp("marked")));
-    _redraw_type = "changed";
+    _redraw_type = redraw::changed;
   }
 
   return retval;
@@ -226,10 +228,10 @@ User interaction: returns key stroke or other signal. getDisplayList must be
 called first or nothing will be displayed!
 
 *******************************************************************************/
-std::string TagList::exec(MouseEvent * mevent)
+Signal TagList::exec(MouseEvent * mevent)
 {
   int ch, check_redraw;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -246,7 +248,7 @@ std::string TagList::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = read_key()) {
 
     // Enter key: accept selection
 
@@ -258,46 +260,29 @@ std::string TagList::exec(MouseEvent * mevent)
         retval = _button_signals[_highlighted_button];
       else
         retval = signals::keyEnter;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
 
     case KEY_UP:
-      retval = signals::highlight;
-      check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_DOWN:
-      retval = signals::highlight;
-      check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_PPAGE:
-      retval = signals::highlight;
-      check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
-      break;
     case KEY_NPAGE:
       retval = signals::highlight;
-      check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      _redraw_type = moveHighlight(ch);
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Right/left: change highlighted button
@@ -305,29 +290,29 @@ std::string TagList::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _redraw_type = redraw::all; }
+      else { _redraw_type = redraw::changed; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _redraw_type = redraw::all;
       break;
 
     // Space: toggle item
@@ -336,7 +321,7 @@ std::string TagList::exec(MouseEvent * mevent)
       retval = " ";
       _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-      _redraw_type = "changed";
+      _redraw_type = redraw::changed;
       break;
 
     // Mouse
@@ -345,16 +330,16 @@ std::string TagList::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _redraw_type = redraw::changed;
         retval = handleMouseEvent(mevent);
         if ( (retval == signals::keyEnter) || (retval == signals::quit) )
-          _redraw_type = "all";
+          _redraw_type = redraw::all;
       }
       break;
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
+      _redraw_type = redraw::none;
       break;
   }
   curs_set(0);
@@ -3,6 +3,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "InputItem.h"
 #include "TextInput.h"
 #include "MouseEvent.h"
@@ -61,7 +62,7 @@ Constructor
 *******************************************************************************/
 TextInput::TextInput()
 {
-  _redraw_type = "entry";
+  _redraw_type = redraw::entry;
   _item_type = "TextInput";
   _selectable = true;
   _entry = "";
@@ -108,7 +109,7 @@ void TextInput::removeLabel()
 Handles mouse event
 
 *******************************************************************************/
-std::string TextInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
+Signal TextInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
 {
   int begy, begx, ycurs, xcurs, xinpbeg, xinpend;
 
@@ -131,7 +132,7 @@ std::string TextInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
         _cursidx = _entry.size();
       else
         _cursidx = xcurs-_posx+_firsttext-_labellen;
-      _redraw_type = "entry";
+      _redraw_type = redraw::entry;
       return signals::nullEvent;  // Because the event was handled here
     }
   }
@@ -146,20 +147,21 @@ Draws text input
 *******************************************************************************/
 void TextInput::draw(int y_offset, bool force, bool highlight)
 {
-  if (force) { _redraw_type = "entry"; }
+  if (force) { _redraw_type = redraw::entry; }
 
   if (highlight)
   {
-    if (colors.turnOn(_win, "fg_highlight_active", "bg_highlight_active") != 0)
+    if (colors.turnOn(_win, color::fg_highlight_active,
+                       color::bg_highlight_active) != 0)
       wattron(_win, A_REVERSE);
   }
 
-  if (_redraw_type == "entry") { redrawEntry(y_offset); }
+  if (_redraw_type == redraw::entry) { redrawEntry(y_offset); }
   wmove(_win, _posy-y_offset, _posx + _cursidx + _labellen - _firsttext);
 
   if (highlight)
     if (colors.turnOff(_win) != 0) { wattroff(_win, A_REVERSE); }
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -167,11 +169,11 @@ void TextInput::draw(int y_offset, bool force, bool highlight)
 User interaction: returns key stroke
 
 *******************************************************************************/
-std::string TextInput::exec(int y_offset, MouseEvent * mevent)
+Signal TextInput::exec(int y_offset, MouseEvent * mevent)
 {
   int ch;
   bool getting_input;
-  std::string retval;
+  Signal retval;
   unsigned int check_redraw;
   MEVENT event;
 
@@ -188,11 +190,11 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
     // Redraw
   
     draw(y_offset, false, true);
-    _redraw_type = "entry";
+    _redraw_type = redraw::entry;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
 
       // Enter key: return Enter signal
 
@@ -200,7 +202,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
 
@@ -237,7 +239,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
         else
         {
           retval = signals::keyLeft;
-          _redraw_type = "entry";
+          _redraw_type = redraw::entry;
           getting_input = false;
         }
         break;
@@ -246,45 +248,45 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
         {
           _cursidx++;
           check_redraw = determineFirstText();
-          if (check_redraw == 0) { _redraw_type = "none"; }
+          if (check_redraw == 0) { _redraw_type = redraw::none; }
         }
         else
         {
           retval = signals::keyRight;
-          _redraw_type = "entry";
+          _redraw_type = redraw::entry;
           getting_input = false;
         }
         break;
       case KEY_HOME:
-        if (_cursidx == 0) { _redraw_type = "none"; }
+        if (_cursidx == 0) { _redraw_type = redraw::none; }
         _cursidx = 0;
         _firsttext = 0;
         break;
       case KEY_END:
         _cursidx = _entry.size();
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _redraw_type = redraw::none; }
         break;
       case KEY_PPAGE:
         retval = signals::highlightPrevPage;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
       case KEY_NPAGE:
         retval = signals::highlightNextPage;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
 
@@ -292,7 +294,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
 
@@ -300,7 +302,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         getting_input = false;
         break;
 
@@ -313,7 +315,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
           retval = handleMouseEvent(mevent, y_offset);
           if (retval == signals::mouseEvent)
           {
-            _redraw_type = "entry";
+            _redraw_type = redraw::entry;
             getting_input = false;
           }
         }
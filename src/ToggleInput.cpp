@@ -3,6 +3,7 @@
 #include "Color.h"
 #include "settings.h"
 #include "signals.h"
+#include "input.h"
 #include "InputItem.h"
 #include "ToggleInput.h"
 #include "MouseEvent.h"
@@ -37,7 +38,7 @@ Constructor
 *******************************************************************************/
 ToggleInput::ToggleInput()
 {
-  _redraw_type = "all";
+  _redraw_type = redraw::all;
   _item_type = "ToggleInput";
   _selectable = true;
   _name = "ToggleInput";
@@ -57,7 +58,7 @@ void ToggleInput::toggle() { _enabled = !_enabled; }
 Handles mouse event
 
 *******************************************************************************/
-std::string ToggleInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
+Signal ToggleInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
 {
   int begy, begx, ycurs, xcurs;
 
@@ -90,22 +91,23 @@ Draws input
 *******************************************************************************/
 void ToggleInput::draw(int y_offset, bool force, bool highlight)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _redraw_type = redraw::all; }
 
   if (highlight)
   {
-    if (colors.turnOn(_win, "fg_highlight_active", "bg_highlight_active") != 0)
+    if (colors.turnOn(_win, color::fg_highlight_active,
+                       color::bg_highlight_active) != 0)
       wattron(_win, A_REVERSE);
   }
 
-  if ( (_redraw_type == "all") || (_redraw_type == "entry") )
+  if (_redraw_type & redraw::entry)
     redrawEntry(y_offset);
-  if (_redraw_type == "all") { redrawText(y_offset); }
+  if (_redraw_type == redraw::all) { redrawText(y_offset); }
   wmove(_win, _posy-y_offset, _posx+1);
 
   if (highlight)
     if (colors.turnOff(_win) != 0) { wattroff(_win, A_REVERSE); }
-  wrefresh(_win);
+  wnoutrefresh(_win);
 }
 
 /*******************************************************************************
@@ -113,11 +115,11 @@ void ToggleInput::draw(int y_offset, bool force, bool highlight)
 User interaction allows user to toggle the item
 
 *******************************************************************************/
-std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
+Signal ToggleInput::exec(int y_offset, MouseEvent * mevent)
 {
   int ch;
   bool getting_input;
-  std::string retval;
+  Signal retval;
   MEVENT event;
 
   const int MY_ESC = 27;
@@ -132,11 +134,11 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
     // Redraw
   
     draw(y_offset, false, true);
-    _redraw_type = "entry";
+    _redraw_type = redraw::entry;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = read_key()) {
 
       // Enter key: return enter signal
 
@@ -144,7 +146,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -152,51 +154,51 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
 
       case ' ':
         toggle();
-        _redraw_type = "entry";
+        _redraw_type = redraw::entry;
         break;
 
       // Navigation keys
 
       case KEY_HOME:
         retval = signals::highlightFirst;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_END:
         retval = signals::highlightLast;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_PPAGE:
         retval = signals::highlightPrevPage;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_NPAGE:
         retval = signals::highlightNextPage;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_RIGHT:
         retval = signals::keyRight;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
       case KEY_LEFT:
         retval = signals::keyLeft;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -204,7 +206,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -212,7 +214,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
 
@@ -225,17 +227,17 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
           retval = handleMouseEvent(mevent, y_offset);
           if (retval == signals::mouseEvent)
           {
-            _redraw_type = "all";
+            _redraw_type = redraw::all;
             getting_input = false;
           }
           else
-            _redraw_type = "entry";
+            _redraw_type = redraw::entry;
         }
         break;
 
       default:
         retval = char(ch);
-        _redraw_type = "all";
+        _redraw_type = redraw::all;
         getting_input = false;
         break;
     }
@@ -0,0 +1,216 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cctype>     // isdigit, isalpha, tolower
+#include "string_util.h"
+#include "VersionKey.h"
+
+/* Letter runs that mark a pre-release when they follow a version, e.g.
+   1.0rc1 or 2.0-beta, so that 1.0rc1 is older than 1.0 */
+
+static const char *prerelease_tags[] = { "alpha", "beta", "pre", "rc" };
+static const unsigned int nprerelease_tags =
+  sizeof(prerelease_tags)/sizeof(prerelease_tags[0]);
+
+/*******************************************************************************
+
+Finds the kernel tag and splits the rest of the version into runs of digits
+and letters. Anything else (., -, +, etc.) just separates runs. The kernel tag
+is the part after the first _ (up to any next _) if it is three numbers
+separated by dots.
+
+*******************************************************************************/
+void VersionKey::parse()
+{
+  std::string::size_type underpos, tagend, end, i, len;
+  std::string_view tag;
+  unsigned int ndot;
+  segment seg;
+
+  _segments.resize(0);
+  _kernel_tagged = false;
+
+  end = _version.size();
+  underpos = _version.find('_');
+  if ( (underpos != std::string::npos) && (underpos+1 < _version.size()) )
+  {
+    tagend = _version.find('_', underpos+1);
+    if (tagend == std::string::npos) { tagend = _version.size(); }
+    tag = trim_view(std::string_view(_version).substr(underpos+1,
+                                                      tagend-underpos-1));
+    ndot = 0;
+    _kernel_tagged = true;
+    for ( i = 0; i < tag.size(); i++ )
+    {
+      if (tag[i] == '.') { ndot++; }
+      else if (! std::isdigit((unsigned char)tag[i]))
+      {
+        _kernel_tagged = false;
+        break;
+      }
+    }
+    if (ndot != 2) { _kernel_tagged = false; }
+    if (_kernel_tagged) { end = underpos; }
+  }
+
+  i = 0;
+  while (i < end)
+  {
+    seg.numeric = std::isdigit((unsigned char)_version[i]);
+    if ( (! seg.numeric) && (! std::isalpha((unsigned char)_version[i])) )
+    {
+      i++;
+      continue;
+    }
+    len = 1;
+    while ( (i+len < end) &&
+            ( seg.numeric ? std::isdigit((unsigned char)_version[i+len])
+                          : std::isalpha((unsigned char)_version[i+len]) ) )
+      len++;
+    seg.pos = i;
+    seg.len = len;
+    _segments.push_back(seg);
+    i += len;
+  }
+}
+
+/*******************************************************************************
+
+Compares segment a of this version to segment b of another. Numbers compare by
+value (without converting, so they can be any length) and are newer than
+letters. Letters compare alphabetically, ignoring case.
+
+*******************************************************************************/
+int VersionKey::compareSegments(const VersionKey & other, unsigned int a,
+                                unsigned int b) const
+{
+  std::string_view sa, sb;
+  unsigned int i;
+  int ca, cb;
+
+  const segment & x = _segments[a];
+  const segment & y = other._segments[b];
+  if (x.numeric != y.numeric) { return x.numeric ? 1 : -1; }
+
+  sa = std::string_view(_version).substr(x.pos, x.len);
+  sb = std::string_view(other._version).substr(y.pos, y.len);
+
+  if (x.numeric)
+  {
+    while ( (sa.size() > 1) && (sa[0] == '0') ) { sa.remove_prefix(1); }
+    while ( (sb.size() > 1) && (sb[0] == '0') ) { sb.remove_prefix(1); }
+    if (sa.size() != sb.size()) { return sa.size() < sb.size() ? -1 : 1; }
+    return sa.compare(sb);
+  }
+
+  for ( i = 0; (i < sa.size()) && (i < sb.size()); i++ )
+  {
+    ca = std::tolower((unsigned char)sa[i]);
+    cb = std::tolower((unsigned char)sb[i]);
+    if (ca != cb) { return ca < cb ? -1 : 1; }
+  }
+  if (sa.size() != sb.size()) { return sa.size() < sb.size() ? -1 : 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Checks whether segment a is a pre-release tag
+
+*******************************************************************************/
+bool VersionKey::preRelease(unsigned int a) const
+{
+  std::string_view text;
+  unsigned int i, k;
+
+  if (_segments[a].numeric) { return false; }
+
+  text = std::string_view(_version).substr(_segments[a].pos,
+                                           _segments[a].len);
+  for ( k = 0; k < nprerelease_tags; k++ )
+  {
+    std::string_view tag(prerelease_tags[k]);
+    if (text.size() != tag.size()) { continue; }
+    for ( i = 0; i < tag.size(); i++ )
+    {
+      if (std::tolower((unsigned char)text[i]) != tag[i]) { break; }
+    }
+    if (i == tag.size()) { return true; }
+  }
+
+  return false;
+}
+
+/*******************************************************************************
+
+Constructors
+
+*******************************************************************************/
+VersionKey::VersionKey() { _kernel_tagged = false; }
+
+VersionKey::VersionKey(const std::string & version)
+{
+  _version = version;
+  parse();
+}
+
+/*******************************************************************************
+
+Sets version string, parsing it only if it has changed
+
+*******************************************************************************/
+void VersionKey::set(const std::string & version)
+{
+  if (version == _version) { return; }
+  _version = version;
+  parse();
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+const std::string & VersionKey::str() const { return _version; }
+bool VersionKey::kernelTagged() const { return _kernel_tagged; }
+
+/*******************************************************************************
+
+Checks whether this (installed) version is the other (available) one with a
+kernel tag appended
+
+*******************************************************************************/
+bool VersionKey::differsByKernel(const VersionKey & other) const
+{
+  if (! _kernel_tagged) { return false; }
+
+  return _version.compare(0, other._version.size(), other._version) == 0;
+}
+
+/*******************************************************************************
+
+Compares to another version, ignoring kernel tags. Segments are compared in
+turn. If one version has more segments than the other but is otherwise the
+same, it is newer (1.0.1 > 1.0), unless the extra part is a pre-release tag
+(1.0rc1 < 1.0).
+
+*******************************************************************************/
+int VersionKey::compare(const VersionKey & other) const
+{
+  unsigned int i, na, nb;
+  int check;
+
+  na = _segments.size();
+  nb = other._segments.size();
+  for ( i = 0; (i < na) && (i < nb); i++ )
+  {
+    check = compareSegments(other, i, i);
+    if (check != 0) { return check; }
+  }
+
+  if (na > nb) { return preRelease(nb) ? -1 : 1; }
+  else if (nb > na) { return other.preRelease(na) ? 1 : -1; }
+
+  return 0;
+}
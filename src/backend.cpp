@@ -1,10 +1,10 @@
 #include <iostream>
-#include <stdlib.h>   // system
-#include <sys/wait.h> // WEXITSTATUS, WIFEXITED
+#include <signal.h>   // sigaction
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sstream>
-#include <algorithm>  // sort
+#include <algorithm>  // sort, max
 #include <fstream>
 #include <atomic>
 #include <ctime>      // strftime
@@ -15,6 +15,13 @@
 #include "ShellReader.h"
 #include "settings.h"
 #include "Blacklist.h"
+#include "Journal.h"
+#include "BuildHistory.h"
+#include "BuildOptionsStore.h"
+#include "Process.h"
+#include "PackageDatabase.h"
+#include "StringInterner.h"
+#include "BuildChanges.h"
 #include "backend.h"
 
 #ifndef PACKAGE_DIR
@@ -24,6 +31,12 @@
 using namespace settings;
 
 Blacklist blacklist;
+Journal journal;
+BuildHistory build_history;
+BuildOptionsStore buildopts_store;
+StringInterner interned_names;
+unsigned int repo_generation = 1;
+BuildChanges build_changes;
 
 /*******************************************************************************
 
@@ -48,30 +61,33 @@ int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
   slackbuilds.resize(0); 
   ncategories = top_dir.size();
   if (ncategories == 0) { return 2; }
+  slackbuilds.reserve(ncategories);
   for ( i = 0; i < ncategories; i++ )
   {
     cat_entry = top_dir(i);
     if (cat_entry.type == "dir")
     {
-      std::vector<BuildListItem> cat_builds;
+      // Items are built in place, since copying one copies all its props
+
+      slackbuilds.emplace_back();
+      std::vector<BuildListItem> & cat_builds = slackbuilds.back();
       category_dir.setFromPath(cat_entry.path + "/" + cat_entry.name);
       nbuilds = category_dir.size();
+      cat_builds.reserve(nbuilds);
       for ( j = 0; j < nbuilds; j++ )
       {
         build_entry = category_dir(j);
         if (build_entry.type == "dir")
         {
-          BuildListItem build;
-          build.setName(build_entry.name);
-          build.setProp("category", cat_entry.name);
+          cat_builds.emplace_back();
+          BuildListItem & build = cat_builds.back();
+          build.setNameAndCategory(build_entry.name, cat_entry.name);
           // Check if blacklisted by name at this point
           build.setBoolProp("blacklisted",
                             blacklist.nameBlacklisted(build.name()));
-          cat_builds.push_back(build);
         }
         else { break; }   // Directories are listed first, so we're done
       }
-      slackbuilds.push_back(cat_builds);
     }
     else { break; }       // Directories are listed first, so we're done
   }  
@@ -81,45 +97,32 @@ int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
 
 /*******************************************************************************
 
-Reads build options in /var/lib/sboui/buildopts
+Reads saved build options the first time it is called and sets them for each
+SlackBuild that has any. Saved options for SlackBuilds that are not in the
+repository are ignored. Returns 0 on success or 1 if the options could not be
+read.
 
 *******************************************************************************/
 int read_buildopts(std::vector<std::vector<BuildListItem> > & slackbuilds)
 {
-  DirListing listing;
-  std::string buildopts_dir, fpath, buildopts, opt, buildname;
-  unsigned int k, nbuilds_opts, stat;
-  int i, j;
-  std::ifstream file;
-  std::size_t ext_idx;
-
-  // Open directory
-
-  buildopts_dir = "/var/lib/sboui/buildopts";
-  stat = listing.setFromPath(buildopts_dir);
-  if (stat == 1) { return stat; }
+  std::string buildopts;
+  unsigned int i, j, ncategories, nbuilds;
 
-  // Read build options for each SlackBuild
+  if (! buildopts_store.loaded())
+  {
+    if (buildopts_store.read() != 0) { return 1; }
+  }
+  if (buildopts_store.size() == 0) { return 0; }
 
-  nbuilds_opts = listing.size();
-  for ( k = 0; k < nbuilds_opts; k++ )
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
   {
-    fpath = buildopts_dir + "/" + listing(k).name;
-    ext_idx = listing(k).name.find(".buildopts");
-    if (ext_idx == std::string::npos) { continue; }
-    file.open(fpath.c_str());
-    buildopts = "";
-    while (1)
-    { 
-      std::getline(file, opt);
-      buildopts += opt;
-      if (file.eof()) { break; }
-      else { buildopts += ";"; }
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      if (buildopts_store.lookup(slackbuilds[i][j].name(), buildopts))
+        slackbuilds[i][j].setProp("build_options", buildopts);
     }
-    buildname = listing(k).name.substr(0,ext_idx);
-    find_slackbuild(buildname, slackbuilds, i, j);
-    slackbuilds[i][j].setProp("build_options", buildopts);
-    file.close();
   }
 
   return 0;
@@ -163,67 +166,57 @@ int find_slackbuild(const std::string & name,
 
 /*******************************************************************************
 
-Gets basename of a file (removes path)
+Splits a package name into name, version, arch, and build, as views into it.
+Returns 1 if package name is badly formed; 0 otherwise.
 
 *******************************************************************************/
-std::string basename(const std::string & fullpath)
+int split_pkg_name(std::string_view pkg, std::string_view & name,
+                   std::string_view & version, std::string_view & arch,
+                   std::string_view & build)
 {
-  std::vector<std::string> splitpkg;
-
-  splitpkg = split(fullpath, '/');
-  return splitpkg[splitpkg.size()-1];
-}
-
-/*******************************************************************************
-
-Gets package info from entry in installed package list. Returns 1 if package
-name is badly formed; 0 otherwise.
+  std::string_view::size_type pos[3];
+  unsigned int i;
 
-*******************************************************************************/
-int get_pkg_info(const std::string & pkg, std::string & name,
-                 std::string & version, std::string & arch,
-                 std::string & build)
-{
-  std::vector<std::string> splitpkg;
-  unsigned int i, nsplit;
+  name = version = arch = build = std::string_view();
 
-  name = "";
-  version = "";
-  arch = "";
-  build = "";
+  // Name may itself contain dashes, so the other fields are found from the end
 
-  splitpkg = split(pkg, '-');
-  nsplit = splitpkg.size();
-  if (nsplit < 4) { return 1; }
+  if ( (pkg.size() > 0) && (pkg.back() == '-') ) { pkg.remove_suffix(1); }
+  for ( i = 0; i < 3; i++ )
+  {
+    pos[i] = pkg.rfind('-', i == 0 ? std::string_view::npos : pos[i-1]-1);
+    if ( (pos[i] == std::string_view::npos) ||
+         ( (i < 2) && (pos[i] == 0) ) ) { return 1; }
+  }
 
-  name = ""; 
-  for ( i = 0; i < nsplit-4; i++ ) { name += splitpkg[i] + "-"; }
-  name += splitpkg[nsplit-4];
-  version = splitpkg[nsplit-3];
-  arch = splitpkg[nsplit-2];
-  build = splitpkg[nsplit-1];
+  name = trim_view(pkg.substr(0, pos[2]));
+  version = trim_view(pkg.substr(pos[2]+1, pos[1]-pos[2]-1));
+  arch = trim_view(pkg.substr(pos[1]+1, pos[0]-pos[1]-1));
+  build = trim_view(pkg.substr(pos[0]+1));
 
   return 0;
 }
 
 /*******************************************************************************
 
-Returns list of all installed packages (not just the ones from the repo)
+Gets package info from entry in installed package list. Returns 1 if package
+name is badly formed; 0 otherwise.
 
 *******************************************************************************/
-std::vector<std::string> list_installed_packages()
+int get_pkg_info(const std::string & pkg, std::string & name,
+                 std::string & version, std::string & arch,
+                 std::string & build)
 {
-  std::vector<std::string> pkglist;
-  DirListing packages_dir(std::string(PACKAGE_DIR), false, false);
-  unsigned int npackages, i;
+  std::string_view vname, vversion, varch, vbuild;
+  int check;
 
-  npackages = packages_dir.size();
-  for ( i = 0; i < npackages; i++ )
-  {
-    pkglist.push_back(basename(packages_dir(i).path + packages_dir(i).name));
-  }
+  check = split_pkg_name(pkg, vname, vversion, varch, vbuild);
+  name = vname;
+  version = vversion;
+  arch = varch;
+  build = vbuild;
 
-  return pkglist;
+  return check;
 }
 
 /*******************************************************************************
@@ -232,24 +225,22 @@ Checks if a SlackBuild is installed and sets info if so.
 
 *******************************************************************************/
 bool check_installed(const BuildListItem & build,
-                     const std::vector<std::string> & installedpkgs,
+                     const PackageDatabase & packages,
                      std::string & pkg, std::string & version,
                      std::string & arch, std::string & pkgbuild)
 {
-  std::string name;
-  unsigned int ninstalled, i;
+  int idx;
 
-  ninstalled = installedpkgs.size();
-  for ( i = 0; i < ninstalled; i++ )
+  idx = packages.find(build.name());
+  if (idx >= 0)
   {
-    get_pkg_info(installedpkgs[i], name, version, arch, pkgbuild);
-    if (name == build.name())
-    {
-      pkg = installedpkgs[i];
-      return true;
-    }
+    pkg = packages.package(idx);
+    version = packages.version(idx);
+    arch = packages.arch(idx);
+    pkgbuild = packages.build(idx);
+    return true;
   }
-    
+
   pkg = "";
   version = "";
   arch = "";
@@ -349,84 +340,242 @@ bool compare_builds_by_category(const BuildListItem *item1,
  
 /*******************************************************************************
 
-Determines which SlackBuilds are installed and sets related properties. Also
-checks for invalid names and missing .info files.
+Marks installed SlackBuilds and sets their installed version, package name, and
+blacklist status. Invalid package names are added to pkg_errors, and the
+locations of installed SlackBuilds in the list are returned in installed.
 
 *******************************************************************************/
-void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
-                         std::vector<std::string> & pkg_errors,
-                         std::vector<std::string> & missing_info)
+void mark_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
+                    std::vector<std::string> & pkg_errors,
+                    std::vector<build_location> & installed)
 {
-  std::vector<std::string> installedpkgs;
-  std::string name, version, arch, build, curcategory, response;
+  PackageDatabase packages;
+  std::string name, pkg, version, build;
   unsigned int ninstalled, k;
-  int i, j, check, pkgcheck, infocheck;
+  int i, j, check;
+  build_location loc;
 
   pkg_errors.resize(0);
-  missing_info.resize(0);
-  installedpkgs = list_installed_packages();
-  ninstalled = installedpkgs.size();
-#pragma omp parallel for private(k,pkgcheck,name,version,arch,build,check,i,j,\
-                                 infocheck)
+  installed.resize(0);
+  packages.read();
+  ninstalled = packages.size();
+#pragma omp parallel for private(k,name,pkg,version,build,check,i,j,loc)
   for ( k = 0; k < ninstalled; k++ )
   {
     // Check for invalid package names
 
-    pkgcheck = get_pkg_info(installedpkgs[k], name, version, arch, build);
-    if (pkgcheck != 0)
+    if (! packages.valid(k))
     {
 #pragma omp critical
-      { pkg_errors.push_back(installedpkgs[k]); }
+      { pkg_errors.emplace_back(packages.package(k)); }
       continue;
     }
+    name = packages.name(k);
     check = find_slackbuild(name, slackbuilds, i, j);
     if (check == 0)
     {
+      pkg = packages.package(k);
+      version = packages.version(k);
+      build = packages.build(k);
       slackbuilds[i][j].setBoolProp("installed", true);
       slackbuilds[i][j].setProp("installed_version", version);
       slackbuilds[i][j].parseBuildNum(build);
-      slackbuilds[i][j].setProp("package_name", installedpkgs[k]);
+      slackbuilds[i][j].setProp("package_name", pkg);
 
       slackbuilds[i][j].setBoolProp("blacklisted",
-                        blacklist.blacklisted(installedpkgs[k], name, version,
-                                              arch, build));
-
-      // Read props, set upgradable status, and check for missing .info file
-
-      infocheck = slackbuilds[i][j].readPropsFromRepo();
-      if (infocheck != 0)
+                        blacklist.blacklisted(pkg, name, version,
+                                      std::string(packages.arch(k)), build));
+      loc.category = i;
+      loc.build = j;
 #pragma omp critical
-        { missing_info.push_back(slackbuilds[i][j].name()); }
+      { installed.push_back(loc); }
     }
   } 
 }
 
 /*******************************************************************************
 
-Runs system command and returns exit status
+Reads repository info for SlackBuilds that don't have it yet and sets
+upgradable status. Those with missing .info files are added to missing_info.
 
 *******************************************************************************/
+void ensure_repo_props(const std::vector<BuildListItem *> & builds,
+                       std::vector<std::string> & missing_info)
+{
+  std::vector<BuildListItem *> unread;
+  unsigned int k, nbuilds;
+  int i, nunread, infocheck;
+
+  nbuilds = builds.size();
+  for ( k = 0; k < nbuilds; k++ )
+  {
+    if (! builds[k]->repoPropsRead()) { unread.push_back(builds[k]); }
+  }
+
+  nunread = unread.size();
+#pragma omp parallel for private(infocheck)
+  for ( i = 0; i < nunread; i++ )
+  {
+    infocheck = unread[i]->readPropsFromRepo();
+    if (infocheck != 0)
+#pragma omp critical
+      { missing_info.push_back(unread[i]->name()); }
+  }
+}
+
+/*******************************************************************************
+
+Determines which SlackBuilds are installed and sets related properties. Also
+checks for invalid names and missing .info files.
+
+*******************************************************************************/
+void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
+                         std::vector<std::string> & pkg_errors,
+                         std::vector<std::string> & missing_info)
+{
+  std::vector<build_location> installed;
+
+  missing_info.resize(0);
+  mark_installed(slackbuilds, pkg_errors, installed);
+  ensure_repo_props(list_installed(slackbuilds), missing_info);
+}
+
+/*******************************************************************************
+
+Runs a command attached to the terminal and returns its exit status, or -1 if
+it could not be run or was killed. Like system(), sboui ignores interrupts
+while waiting, so that Ctrl-C stops the command but not sboui. The program is
+executed directly rather than through the shell unless the command needs it.
+
+*******************************************************************************/
+int run_command(const command_line & cmd, process_usage & usage)
+{
+  Process process;
+  struct sigaction ignore, oldint, oldquit;
+  int retval;
+
+  ignore.sa_handler = SIG_IGN;
+  sigemptyset(&ignore.sa_mask);
+  ignore.sa_flags = 0;
+  sigaction(SIGINT, &ignore, &oldint);
+  sigaction(SIGQUIT, &ignore, &oldquit);
+
+  if (process.start(cmd, false) == 0) { retval = process.wait(); }
+  else { retval = -1; }
+  usage = process.usage();
+
+  sigaction(SIGINT, &oldint, NULL);
+  sigaction(SIGQUIT, &oldquit, NULL);
+
+  return retval;
+}
+
 int run_command(const std::string & cmd)
 {
-  int check;
-  unsigned int i, nsplit;
-  std::vector<std::string> splitcmd;
-  std::string runcmd;
+  command_line cl;
+  process_usage usage;
 
-  // Get rid of extraneous spaces
+  if (parse_command(cmd, cl) != 0) { return -1; }
 
-  splitcmd = split(cmd);
-  nsplit = splitcmd.size();
-  runcmd = "";
-  for ( i = 0; i < nsplit-1; i++ ) { runcmd += splitcmd[i] + " "; }
-  runcmd += splitcmd[nsplit-1];
-  
-  check = system(cmd.c_str());
+  return run_command(cl, usage);
+}
+
+/*******************************************************************************
+
+Sets up command used to install/upgrade/reinstall/remove a SlackBuild. Build
+options are passed in the environment directly, unless one of them needs the
+shell (e.g. to expand a variable), in which case the whole command is run
+through the shell as it would be typed. Returns 0 on success or 1 if the action
+is not recognized or the command can't be parsed.
+
+*******************************************************************************/
+int action_command(const BuildListItem & build, const std::string & action,
+                   command_line & cmd)
+{
+  std::string vars, cmdstr;
+  std::vector<std::string> build_options;
+  unsigned int i, noptions;
+
+  if (action == "Install")
+  {
+    vars = install_vars;
+    cmdstr = install_cmd + " " + build.name() + " " + install_clos;
+  }
+  else if (action == "Upgrade")
+  {
+    vars = upgrade_vars;
+    cmdstr = upgrade_cmd + " " + build.name() + " " + upgrade_clos;
+  }
+  else if (action == "Reinstall")
+  {
+    vars = install_vars;
+    cmdstr = reinstall_cmd + " " + build.name() + " " + install_clos;
+  }
+  else if (action == "Remove")
+    return parse_command("removepkg " + build.getProp("package_name"), cmd);
+  else
+    return 1;
+
+  if (parse_command(vars + " " + cmdstr, cmd) != 0) { return 1; }
+
+  build_options = split(build.getProp("build_options"), ';');
+  noptions = build_options.size();
+  for ( i = 0; i < noptions; i++ )
+  {
+    if (parse_assignments(build_options[i], cmd.env) != 0)
+      return parse_command(vars + " " + build.buildOptionsEnv() + " " + cmdstr,
+                           cmd);
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
 
-  // See `man waitpid` for more info on WEXITSTATUS and WIFEXITED
+Checks that an action took effect after its command finished successfully and
+updates properties, recording the change in build_changes. Returns 0 if so, 1
+if not. After an upgrade, the SlackBuild may still be upgradable if the package
+manager didn't think it was; the caller should check and reinstall instead.
 
-  if (WIFEXITED(check)) { return WEXITSTATUS(check); }
-  else { return -1; }
+*******************************************************************************/
+int check_action(BuildListItem & build, const std::string & action)
+{
+  PackageDatabase packages;
+
+  packages.read();
+  build.readInstalledProps(packages);
+  build_changes.record(&build);
+  if (action == "Remove")
+  {
+    if (build.getBoolProp("installed")) { return 1; }
+    else { return 0; }
+  }
+  else if (action == "Upgrade")
+  {
+    build.readPropsFromRepo();
+    return 0;
+  }
+  else if (build.getBoolProp("installed"))
+  {
+    build.readPropsFromRepo();
+    return 0;
+  }
+  else { return 1; }
+}
+
+/*******************************************************************************
+
+Runs the command for an action on a SlackBuild and returns its exit status
+
+*******************************************************************************/
+static int run_action(const BuildListItem & build, const std::string & action,
+                      process_usage & usage)
+{
+  command_line cmd;
+
+  if (action_command(build, action, cmd) != 0) { return -1; }
+
+  return run_command(cmd, usage);
 }
 
 /*******************************************************************************
@@ -436,25 +585,21 @@ Installs a SlackBuild
 *******************************************************************************/
 int install_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
+  process_usage usage;
 
-  cmd = install_vars + " " + build.buildOptionsEnv() + " " + install_cmd
-      + " " + build.name() + " " + install_clos;
-  check = run_command(cmd);
+  check = run_action(build, "Install", usage);
   if (check != 0) { return check; }
 
   // Check to make sure it was actually installed and update properties
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed"))
-  {
-    build.readPropsFromRepo();
-    return 0;
-  }
-  else { return 1; }
+  check = check_action(build, "Install");
+  if (check == 0)
+    build_history.record(build, usage.wall_seconds,
+                         usage.user_seconds + usage.system_seconds,
+                         usage.max_rss);
+
+  return check;
 }
 
 /*******************************************************************************
@@ -464,26 +609,30 @@ Upgrades a SlackBuild
 *******************************************************************************/
 int upgrade_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
+  process_usage usage, reinst_usage;
 
-  cmd = upgrade_vars + " " + build.buildOptionsEnv() + " " + upgrade_cmd
-      + " " + build.name() + " " + upgrade_clos;
-  check = run_command(cmd);
+  check = run_action(build, "Upgrade", usage);
   if (check != 0) { return check; }
 
   // If upgrade didn't work (maybe package manager doesn't think it's 
   //  upgradable), reinstall instead
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  build.readPropsFromRepo();
+  check_action(build, "Upgrade");
   if (build.getBoolProp("upgradable"))
   {
-    check = reinstall_slackbuild(build); 
+    check = run_action(build, "Reinstall", reinst_usage);
     if (check != 0) { return check; }
+    check = check_action(build, "Reinstall");
+    if (check != 0) { return check; }
+    usage.wall_seconds += reinst_usage.wall_seconds;
+    usage.user_seconds += reinst_usage.user_seconds;
+    usage.system_seconds += reinst_usage.system_seconds;
+    usage.max_rss = std::max(usage.max_rss, reinst_usage.max_rss);
   }
+  build_history.record(build, usage.wall_seconds,
+                       usage.user_seconds + usage.system_seconds,
+                       usage.max_rss);
 
   return 0;
 }
@@ -495,25 +644,15 @@ Reinstalls a SlackBuild
 *******************************************************************************/
 int reinstall_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
+  process_usage usage;
 
-  cmd = install_vars + " " + build.buildOptionsEnv() + " " + reinstall_cmd
-      + " " + build.name() + " " + install_clos;
-  check = run_command(cmd);
+  check = run_action(build, "Reinstall", usage);
   if (check != 0) { return check; }
 
   // Check to make sure it was actually installed and update properties
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed"))
-  {
-    build.readPropsFromRepo();
-    return 0;
-  }
-  else { return 1; }
+  return check_action(build, "Reinstall");
 }
 
 /*******************************************************************************
@@ -523,20 +662,15 @@ Removes a SlackBuild
 *******************************************************************************/
 int remove_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
+  process_usage usage;
 
-  cmd = "removepkg " + build.getProp("package_name");
-  check = run_command(cmd);
+  check = run_action(build, "Remove", usage);
   if (check != 0) { return check; }
 
   // Check to make sure it was actually removed
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed")) { return 1; }
-  else { return 0; }
+  return check_action(build, "Remove");
 }
 
 /*******************************************************************************
@@ -626,6 +760,7 @@ int sync_repo(bool interactive)
 
   if (retval == 0)
   {
+    repo_generation++;
     DirListing listing;
     unsigned int stat;
     std::ofstream file;
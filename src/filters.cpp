@@ -1,12 +1,17 @@
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory>     // shared_ptr
+#include <algorithm>  // find
 #include <curses.h>
 #include "BuildListItem.h"
 #include "CategoryListItem.h"
 #include "CategoryListBox.h"
 #include "BuildListBox.h"
+#include "ListSource.h"
 #include "string_util.h"
 #include "settings.h"   // repo_dir
+#include "backend.h"    // ensure_repo_props
 #include "filters.h"
 
 /*******************************************************************************
@@ -72,11 +77,12 @@ std::vector<BuildListItem *> list_nondeps(
                          std::vector<std::vector<BuildListItem> > & slackbuilds)
 {
   std::vector<BuildListItem *> installedlist, nondeplist;
-  unsigned int i, j, k, ninstalled, ndeps;
+  unsigned int i, j, ninstalled;
   bool isdep;
-  std::vector<std::string> deplist;
+  std::vector<std::string> missing_info;
 
   installedlist = list_installed(slackbuilds);
+  ensure_repo_props(installedlist, missing_info);
 
   // N^2 (max) loop through installed packages to see which are dependencies
 
@@ -87,16 +93,9 @@ std::vector<BuildListItem *> list_nondeps(
     for ( j = 0; j < ninstalled; j++ )
     {
       if (j == i) { continue; }
-      deplist = split(installedlist[j]->getProp("requires"));
-      ndeps = deplist.size();
-      for ( k = 0; k < ndeps; k++ )
-      {
-        if (deplist[k] == installedlist[i]->name())
-        {
-          isdep = true;
-          break;
-        }
-      }
+      const std::vector<unsigned int> & deps = installedlist[j]->requiresIds();
+      isdep = ( std::find(deps.begin(), deps.end(), installedlist[i]->nameId())
+                != deps.end() );
       if (isdep) { break; }
     } 
     if (! isdep) { nondeplist.push_back(installedlist[i]); }
@@ -209,6 +208,218 @@ void filter_by_func(std::vector<std::vector<BuildListItem *> > & slackbuilds,
 
 /*******************************************************************************
 
+Finds the position of list[idx] in a list box whose items are a subset of list
+in the same order. Returns true if it is there; if not, pos is where it would
+have to be inserted to keep that order.
+
+*******************************************************************************/
+template<typename T>
+static bool find_in_order(ListBox & listbox, const std::vector<T *> & list,
+                          unsigned int idx, unsigned int & pos)
+{
+  unsigned int j, nitems;
+
+  nitems = listbox.numItems();
+  pos = 0;
+  for ( j = 0; j < idx; j++ )
+  {
+    if ( (pos < nitems) && (listbox.itemByIdx(pos) == list[j]) ) { pos++; }
+  }
+
+  return (pos < nitems) && (listbox.itemByIdx(pos) == list[idx]);
+}
+
+/*******************************************************************************
+
+Checks whether categories should be tagged, only for the categories that the
+given SlackBuilds are in
+
+*******************************************************************************/
+void update_category_tags(const std::vector<BuildListItem *> & builds,
+                          CategoryListBox & clistbox,
+                          std::vector<BuildListBox> & blistboxes)
+{
+  unsigned int i, k, nbuilds, ncategories;
+  std::vector<bool> checked;
+
+  ncategories = clistbox.numItems();
+  checked.assign(ncategories, false);
+  nbuilds = builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    const std::string & category = builds[i]->getProp("category");
+    for ( k = 0; k < ncategories; k++ )
+    {
+      if (clistbox.itemByIdx(k)->name() == category) { break; }
+    }
+    if ( (k == ncategories) || checked[k] ) { continue; }
+    checked[k] = true;
+    if (blistboxes[k].allTagged())
+      clistbox.itemByIdx(k)->setBoolProp("tagged", true);
+    else
+      clistbox.itemByIdx(k)->setBoolProp("tagged", false);
+  }
+}
+
+/*******************************************************************************
+
+Updates lists made by filter_by_func for SlackBuilds that have changed, rather
+than filtering everything again. Each changed SlackBuild that is in the input
+lists is added to or removed from its BuildListBox according to func, in the
+order filter_by_func would give, and categories are added or removed as they
+gain or lose SlackBuilds. SlackBuilds are added before any are removed, so that
+a category is not removed and added again. Highlighted items stay highlighted.
+nfiltered is set to the number of SlackBuilds now shown.
+
+*******************************************************************************/
+void patch_filter(const std::vector<BuildListItem *> & changed,
+                  std::vector<std::vector<BuildListItem *> > & slackbuilds,
+                  bool (*func)(const BuildListItem &),
+                  std::vector<CategoryListItem *> & categories,
+                  WINDOW *blistboxwin, CategoryListBox & clistbox,
+                  std::vector<BuildListBox> & blistboxes,
+                  unsigned int & nfiltered, bool overwrite)
+{
+  unsigned int i, k, nchanged, ncategories, cat_idx, build_idx, box_idx,
+               item_idx, pass;
+  std::vector<BuildListItem *>::iterator it;
+  bool category_shown, build_shown, show;
+  BuildListBox initlistbox;
+
+  // Add SlackBuilds in the first pass and remove them in the second
+
+  nchanged = changed.size();
+  for ( pass = 0; pass < 2; pass++ )
+  {
+    for ( i = 0; i < nchanged; i++ )
+    {
+      // Only SlackBuilds in the input lists can be shown
+
+      const std::string & category = changed[i]->getProp("category");
+      ncategories = categories.size();
+      for ( cat_idx = 0; cat_idx < ncategories; cat_idx++ )
+      {
+        if (categories[cat_idx]->name() == category) { break; }
+      }
+      if (cat_idx == ncategories) { continue; }
+      it = std::find(slackbuilds[cat_idx].begin(), slackbuilds[cat_idx].end(),
+                     changed[i]);
+      if (it == slackbuilds[cat_idx].end()) { continue; }
+      build_idx = it - slackbuilds[cat_idx].begin();
+
+      category_shown = find_in_order(clistbox, categories, cat_idx, box_idx);
+      build_shown = category_shown &&
+                    find_in_order(blistboxes[box_idx], slackbuilds[cat_idx],
+                                  build_idx, item_idx);
+      show = func(*changed[i]);
+
+      if ( show && (! build_shown) && (pass == 0) )
+      {
+        if (! category_shown)
+        {
+          if (clistbox.numItems() == 0) { blistboxes.resize(0); }
+          clistbox.insertItem(box_idx, categories[cat_idx]);
+          BuildListBox blistbox;
+          blistbox.setWindow(blistboxwin);
+          blistbox.setName(categories[cat_idx]->name());
+          blistbox.setActivated(false);
+          blistboxes.insert(blistboxes.begin()+box_idx, blistbox);
+          item_idx = 0;
+        }
+        blistboxes[box_idx].insertItem(item_idx, changed[i]);
+      }
+      else if ( (! show) && build_shown && (pass == 1) )
+      {
+        blistboxes[box_idx].removeItem(item_idx);
+        if (blistboxes[box_idx].numItems() == 0)
+        {
+          clistbox.removeItem(box_idx);
+          blistboxes.erase(blistboxes.begin()+box_idx);
+        }
+
+        // The input lists match what is shown if they were overwritten
+
+        if (overwrite)
+        {
+          slackbuilds[cat_idx].erase(slackbuilds[cat_idx].begin()+build_idx);
+          if (slackbuilds[cat_idx].size() == 0)
+          {
+            slackbuilds.erase(slackbuilds.begin()+cat_idx);
+            categories.erase(categories.begin()+cat_idx);
+          }
+        }
+      }
+    }
+  }
+
+  update_category_tags(changed, clistbox, blistboxes);
+
+  nfiltered = 0;
+  ncategories = clistbox.numItems();
+  for ( k = 0; k < ncategories; k++ ) { nfiltered += blistboxes[k].numItems(); }
+
+  // Initialize with empty lists if filter is now empty
+
+  if ( (nfiltered == 0) && (blistboxes.size() == 0) )
+  {
+    initlistbox.setWindow(blistboxwin);
+    initlistbox.setActivated(false);
+    initlistbox.setName("SlackBuilds");
+    blistboxes.push_back(initlistbox);
+  }
+}
+
+/*******************************************************************************
+
+Lists all SlackBuilds. Instead of copying pointers to every SlackBuild into the
+list boxes, each BuildListBox reads its category's SlackBuilds in place, so
+memory use does not grow with the size of the repository.
+
+*******************************************************************************/
+void list_all(std::vector<std::vector<BuildListItem> > & slackbuilds,
+              std::vector<CategoryListItem *> & categories,
+              WINDOW *blistboxwin, CategoryListBox & clistbox,
+              std::vector<BuildListBox> & blistboxes, unsigned int & nbuilds)
+{
+  unsigned int i, ncategories;
+  BuildListBox blistbox;
+
+  ncategories = slackbuilds.size();
+  blistboxes.resize(0);
+  blistboxes.reserve(ncategories);
+  clistbox.clearList();
+  clistbox.setActivated(true);
+  nbuilds = 0;
+
+  blistbox.setWindow(blistboxwin);
+  blistbox.setActivated(false);
+  for ( i = 0; i < ncategories; i++ )
+  {
+    if (slackbuilds[i].size() == 0) { continue; }
+    clistbox.addItem(categories[i]);
+    blistbox.setName(categories[i]->name());
+    blistbox.setSource(std::make_shared<VectorSource<BuildListItem> >(
+                       slackbuilds[i]));
+    blistboxes.push_back(blistbox);
+    if (blistboxes.back().allTagged())
+      categories[i]->setBoolProp("tagged", true);
+    else
+      categories[i]->setBoolProp("tagged", false);
+    nbuilds += slackbuilds[i].size();
+  }
+
+  // Initialize with empty list if the repository is empty
+
+  if (nbuilds == 0)
+  {
+    blistbox.setName("SlackBuilds");
+    blistbox.clearList();
+    blistboxes.push_back(blistbox);
+  }
+}
+
+/*******************************************************************************
+
 Filters lists by non-dependencies. all_slackbuilds is the list of all
 slackbuilds in the repo; slackbuilds is the input list (which could
 be the same as all_slackbuilds).
@@ -222,7 +433,7 @@ void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
                     unsigned int & nnondeps, bool overwrite)
 {
   unsigned int i, j, k, ncategories, nbuilds, nfiltered_categories;
-  std::vector<std::string> filtered_categories;
+  std::vector<unsigned int> filtered_categories;
   bool category_found;
   BuildListBox initlistbox;
   std::vector<BuildListItem *> allnondeplist, nondeplist;
@@ -244,7 +455,7 @@ void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
       {
           for ( k = 0; k < nnondeps; k++ )
           {
-              if (slackbuilds[i][j]->name() == allnondeplist[k]->name())
+              if (slackbuilds[i][j]->nameId() == allnondeplist[k]->nameId())
               {
                   nondeplist.push_back(slackbuilds[i][j]);
                   break;
@@ -260,7 +471,7 @@ void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
     nfiltered_categories = filtered_categories.size();
     for ( j = 0; j < nfiltered_categories; j++ )
     {
-      if (nondeplist[i]->getProp("category") == filtered_categories[j])
+      if (nondeplist[i]->categoryId() == filtered_categories[j])
       {
         blistboxes[j].addItem(nondeplist[i]);
         category_found = true;
@@ -280,7 +491,7 @@ void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
           blistbox.setActivated(false);
           blistbox.addItem(nondeplist[i]);
           blistboxes.push_back(blistbox);
-          filtered_categories.push_back(nondeplist[i]->getProp("category"));
+          filtered_categories.push_back(nondeplist[i]->categoryId());
           break;
         }
       }
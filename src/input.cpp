@@ -0,0 +1,118 @@
+#include <vector>
+#include <functional>
+#include <curses.h>
+#include "input.h"
+
+/* How often to run idle hooks that have work in progress (milliseconds) */
+
+static const int idle_poll_interval = 100;
+
+struct idle_hook {
+  unsigned int id;
+  std::function<bool()> func;
+};
+
+static std::vector<idle_hook> idle_hooks;
+static unsigned int next_hook_id = 1;
+
+/*******************************************************************************
+
+Runs idle hooks. Returns true if any of them has work in progress. A hook may
+open a dialog that adds or removes hooks of its own, so a copy of the list is
+run.
+
+*******************************************************************************/
+static bool run_idle_hooks()
+{
+  unsigned int i, nhooks;
+  bool busy;
+  std::vector<idle_hook> hooks;
+
+  busy = false;
+  hooks = idle_hooks;
+  nhooks = hooks.size();
+  for ( i = 0; i < nhooks; i++ )
+  {
+    if (hooks[i].func()) { busy = true; }
+  }
+
+  return busy;
+}
+
+/*******************************************************************************
+
+Reads a key from the terminal like getch(). If no idle hook has work in
+progress, this simply blocks. Otherwise, it waits for input in short intervals
+and runs the hooks in between. Widgets only stage their windows with
+wnoutrefresh when drawing; everything staged since the last key is sent to the
+terminal here in a single update.
+
+*******************************************************************************/
+int read_key()
+{
+  int ch;
+
+  while (true)
+  {
+    if (run_idle_hooks()) { timeout(idle_poll_interval); }
+    else { timeout(-1); }
+
+    doupdate();
+    ch = getch();
+    if (ch != ERR) { break; }
+  }
+  timeout(-1);
+
+  return ch;
+}
+
+/*******************************************************************************
+
+Removes further presses of key already waiting in the input queue and returns
+how many there were. Keys arrive faster than the screen can be updated while
+one is held down, so the caller can act on all of them before drawing once.
+
+*******************************************************************************/
+int drain_repeats(int key)
+{
+  int ch, count;
+
+  count = 0;
+  timeout(0);
+  while ( (ch = getch()) == key ) { count++; }
+  timeout(-1);
+  if (ch != ERR) { ungetch(ch); }
+
+  return count;
+}
+
+/*******************************************************************************
+
+Registers or removes an idle hook
+
+*******************************************************************************/
+unsigned int add_idle_hook(const std::function<bool()> & hook)
+{
+  idle_hook newhook;
+
+  newhook.id = next_hook_id++;
+  newhook.func = hook;
+  idle_hooks.push_back(newhook);
+
+  return newhook.id;
+}
+
+void remove_idle_hook(unsigned int id)
+{
+  unsigned int i, nhooks;
+
+  nhooks = idle_hooks.size();
+  for ( i = 0; i < nhooks; i++ )
+  {
+    if (idle_hooks[i].id == id)
+    {
+      idle_hooks.erase(idle_hooks.begin() + i);
+      return;
+    }
+  }
+}
@@ -1,9 +1,11 @@
 #include <string>
 #include <vector>
-#include <algorithm>       // reverse, max
+#include <unordered_set>
+#include <algorithm>       // max
 #include "BuildListItem.h"
-#include "backend.h"       // get_reqs, find_slackbuild, list_installed
-#include "string_util.h"   // split
+#include "StringInterner.h"
+#include "backend.h"       // get_reqs, find_slackbuild, list_installed,
+                           //   ensure_repo_props, interned_names
 #include "requirements.h"
 
 /*******************************************************************************
@@ -31,46 +33,51 @@ void add_req(BuildListItem * build,
 
 /*******************************************************************************
 
-Recursively computes list of requirements for a SlackBuild. List must be
-reversed after calling this to get the proper build order. Returns 1 if a
+Recursively adds requirements of a SlackBuild to the build order, each after
+its own requirements. SlackBuilds already in visited are skipped, so each one
+is resolved (and its .info file read) only once no matter how many others
+depend on it. Requirements and visited are interned name IDs. Returns 1 if a
 requirement is not found in the list, 2 if a .info file is missing, or 0
-otherwise
+otherwise.
 
 *******************************************************************************/
-int get_reqs_recursive(const BuildListItem & build,
+int add_reqs_recursive(const BuildListItem & build,
                        std::vector<BuildListItem *> & reqlist,
+                       std::unordered_set<unsigned int> & visited,
                        std::vector<std::vector<BuildListItem> > & slackbuilds)
 {
+  static const unsigned int readme = interned_names.intern("%README%");
   unsigned int i, ndeps;
-  std::vector<std::string> deplist;
+  std::vector<unsigned int> deplist;
   std::string reqs;
   int idx0, idx1, check, maxcheck;
 
-  if (build.getBoolProp("installed")) { deplist = 
-                                        split(build.getProp("requires")); }
+  if (build.getBoolProp("installed") && build.repoPropsRead())
+    deplist = build.requiresIds();
   else 
   {
     check = get_reqs(build, reqs);
-    if (check == 0) { deplist = split(reqs); }
+    if (check == 0) { interned_names.internList(reqs, deplist); }
     else { return 2; }
   }
   
   maxcheck = 0;
-  check = 0;
   ndeps = deplist.size();
   for ( i = 0; i < ndeps; i++ )
   { 
-    if (deplist[i] != "%README%")
-    { 
-      check = find_slackbuild(deplist[i], slackbuilds, idx0, idx1);
-      if (check == 0)
-      {
-        add_req(&slackbuilds[idx0][idx1], reqlist);
-        check = get_reqs_recursive(slackbuilds[idx0][idx1], reqlist, slackbuilds); 
-      }
-      else { check = 1; }
-      maxcheck = std::max(check, maxcheck);
+    if ( (deplist[i] == readme) || (! visited.insert(deplist[i]).second) )
+      continue;
+
+    check = find_slackbuild(interned_names.str(deplist[i]), slackbuilds, idx0,
+                            idx1);
+    if (check == 0)
+    {
+      check = add_reqs_recursive(slackbuilds[idx0][idx1], reqlist, visited,
+                                 slackbuilds); 
+      reqlist.push_back(&slackbuilds[idx0][idx1]);
     }
+    else { check = 1; }
+    maxcheck = std::max(check, maxcheck);
   }
 
   return maxcheck;
@@ -86,17 +93,46 @@ int compute_reqs_order(const BuildListItem & build,
                        std::vector<BuildListItem *> & reqlist,
                        std::vector<std::vector<BuildListItem> > & slackbuilds)
 {
-  int check;
+  std::unordered_set<unsigned int> visited;
 
   reqlist.resize(0);
-  check = get_reqs_recursive(build, reqlist, slackbuilds);
-  std::reverse(reqlist.begin(), reqlist.end());
+  visited.insert(interned_names.intern(build.name()));
 
-  return check;
+  return add_reqs_recursive(build, reqlist, visited, slackbuilds);
 }  
 
 /*******************************************************************************
 
+Computes a single build order for a set of SlackBuilds and all of their
+requirements. Shared requirements appear only once, and requested SlackBuilds
+are included in the order after anything they depend on.
+
+*******************************************************************************/
+int compute_reqs_order(const std::vector<BuildListItem *> & builds,
+                       std::vector<BuildListItem *> & reqlist,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  std::unordered_set<unsigned int> visited;
+  unsigned int i, nbuilds;
+  int check, maxcheck;
+
+  reqlist.resize(0);
+  maxcheck = 0;
+  nbuilds = builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (! visited.insert(interned_names.intern(builds[i]->name())).second)
+      continue;
+    check = add_reqs_recursive(*builds[i], reqlist, visited, slackbuilds);
+    reqlist.push_back(builds[i]);
+    maxcheck = std::max(check, maxcheck);
+  }
+
+  return maxcheck;
+}
+
+/*******************************************************************************
+
 Recursively finds installed SlackBuilds that depend on a given SlackBuild
 
 *******************************************************************************/
@@ -104,17 +140,18 @@ void get_inverse_reqs_recursive(const BuildListItem & build,
                       std::vector<BuildListItem *> & invreqlist,
                       std::vector<BuildListItem *> & installedlist)
 {
-  unsigned int i, j, ninstalled, ndeps;
-  std::vector<std::string> deplist;
+  unsigned int i, j, ninstalled, ndeps, id;
 
+  id = interned_names.intern(build.name());
   ninstalled = installedlist.size();
   for ( i = 0; i < ninstalled; i++ )
   {
-    deplist = split(installedlist[i]->getProp("requires"));
+    const std::vector<unsigned int> & deplist =
+                                            installedlist[i]->requiresIds();
     ndeps = deplist.size();
     for ( j = 0; j < ndeps; j++ )
     {
-      if (deplist[j] == build.name())
+      if (deplist[j] == id)
       {
         add_req(installedlist[i], invreqlist);
         get_inverse_reqs_recursive(*installedlist[i], invreqlist, 
@@ -135,8 +172,10 @@ void compute_inv_reqs(const BuildListItem & build,
                       std::vector<std::vector<BuildListItem> > & slackbuilds)
 {
   std::vector<BuildListItem *> installedlist;
+  std::vector<std::string> missing_info;
 
   invreqlist.resize(0);
   installedlist = list_installed(slackbuilds);
+  ensure_repo_props(installedlist, missing_info);
   get_inverse_reqs_recursive(build, invreqlist, installedlist);
 }
@@ -27,7 +27,7 @@ int main(int argc, char *argv[])
   if (clos.requestInputFile()) { check = read_config(clos.inputFile()); }
   else { check = read_config(); }
 
-  // Read blacklist
+  // Read blacklist and cached verdicts
 
   blacklist.read("/etc/sboui/blacklist"); 
 
@@ -38,7 +38,9 @@ int main(int argc, char *argv[])
   else if (clos.upgradable())
   {
     MainWindow mainwindow(PACKAGE_VERSION);
-    return mainwindow.listUpgradable();
+    check = mainwindow.listUpgradable();
+    blacklist.save();
+    return check;
   }
 
   // Set up ncurses (needed because we set colors while reading config file)
@@ -8,6 +8,7 @@
 #include "Color.h"
 #include "ColorTheme.h"
 #include "DirListing.h"
+#include "Snapshot.h"
 #include "settings.h"
 
 #ifndef DATADIR
@@ -35,6 +36,7 @@ namespace settings
   std::string layout;
   bool resolve_deps, confirm_changes, enable_color, rebuild_inv_deps;
   bool save_buildopts, warn_invalid_pkgnames, cumulative_filters;
+  bool background_jobs;
 }
 
 Color colors;
@@ -45,21 +47,79 @@ using namespace libconfig;
 
 const std::string default_conf_file = CONFDIR "/sboui.conf";
 
+/* Settings kept in the config snapshot. editor and viewer are not included,
+   because they come from the environment. */
+
+static std::string * const snapshot_strings[] = {
+  &repo_dir, &repo_tag, &package_manager, &sync_cmd, &install_cmd,
+  &upgrade_cmd, &reinstall_cmd, &install_clos, &install_vars, &upgrade_clos,
+  &upgrade_vars, &color_theme, &layout
+};
+static bool * const snapshot_bools[] = {
+  &resolve_deps, &confirm_changes, &enable_color, &rebuild_inv_deps,
+  &save_buildopts, &warn_invalid_pkgnames, &cumulative_filters,
+  &background_jobs
+};
+
+/* Snapshot of the settings and active color theme, and what went into it */
+
+static Snapshot config_snapshot;
+static std::string snapshot_key;
+static std::vector<std::string> config_files;
+static bool config_from_snapshot = false;
+static bool config_clean = false;         // Read with no errors or warnings
+
+/* Active color theme, if it was found in a theme file */
+
+static ColorTheme active_theme;
+static std::string active_theme_path;
+static bool active_theme_found = false;
+
+/* Whether color_themes has all themes, or just the default and active ones */
+
+static bool color_themes_listed = false;
+
 /*******************************************************************************
 
-Reads color themes from system and local directories
+Gets system and local color theme directories
+
+*******************************************************************************/
+static void get_theme_dirs(std::string & system_themes_dir,
+                           std::string & user_themes_dir)
+{
+  char *env_home;
+
+  system_themes_dir = DATADIR "/themes";
+  env_home = std::getenv("HOME");
+  if (env_home != NULL)
+    user_themes_dir = std::string(env_home) + "/.local/share/sboui/themes";
+  else
+    user_themes_dir = "";
+}
+
+/*******************************************************************************
+
+Reads all color themes from system and local directories, the first time it is
+called after setup_color. Until then, only the default and active themes are
+known.
 
 *******************************************************************************/
 void get_color_themes()
 {
-  std::string env_home, system_themes_dir, user_themes_dir, theme_full_path;
+  std::string system_themes_dir, user_themes_dir, theme_full_path;
   unsigned int i, ndirs, stat, j, nfiles, k, nthemes;
   DirListing themes_dir;
   direntry theme_file;
+  ColorTheme default_theme;
 
-  env_home = std::getenv("HOME");
-  system_themes_dir = DATADIR "/themes";
-  user_themes_dir = env_home + "/.local/share/sboui/themes";
+  if (color_themes_listed) { return; }
+  color_themes_listed = true;
+
+  color_themes.clear();
+  default_theme.setDefaultColors();
+  color_themes.push_back(default_theme);
+
+  get_theme_dirs(system_themes_dir, user_themes_dir);
   ndirs = 2;
   for ( i = 0; i < ndirs; i++ )
   {
@@ -98,14 +158,182 @@ void get_color_themes()
 
 /*******************************************************************************
 
-Reads settings from configuration file
+Finds a color theme by name without reading every theme file. Themes later in
+get_color_themes mask earlier ones with the same name, so the directories are
+searched the other way around: local before system, and each in reverse
+order, stopping at the first match. Returns 0 if found or 1 if not.
+
+*******************************************************************************/
+static int find_color_theme(const std::string & name, ColorTheme & theme,
+                            std::string & theme_full_path)
+{
+  std::string system_themes_dir, user_themes_dir;
+  unsigned int i, ndirs, stat, j;
+  DirListing themes_dir;
+  direntry theme_file;
+
+  get_theme_dirs(system_themes_dir, user_themes_dir);
+  ndirs = 2;
+  for ( i = 0; i < ndirs; i++ )
+  {
+    if (i == 0) { stat = themes_dir.setFromPath(user_themes_dir); }
+    else { stat = themes_dir.setFromPath(system_themes_dir); }
+    if (stat == 1) { continue; }
+
+    for ( j = themes_dir.size(); j > 0; j-- )
+    {
+      theme_file = themes_dir(j-1);
+      if ( (theme_file.type == "reg") || (theme_file.type == "lnk") )
+      {
+        theme_full_path = theme_file.path + theme_file.name;
+        stat = theme.read(theme_full_path);
+        if ( (stat == 0) && (theme.name() == name) ) { return 0; }
+      }
+    }
+  }
+
+  return 1;
+}
+
+/*******************************************************************************
+
+Reads settings and active color theme from the snapshot. Returns true if all
+of them were read.
+
+*******************************************************************************/
+static bool read_config_snapshot()
+{
+  unsigned int i, nstrings, nbools, ncolors;
+  std::vector<std::string> theme_colors;
+  std::string theme_name;
+
+  nstrings = sizeof(snapshot_strings)/sizeof(snapshot_strings[0]);
+  for ( i = 0; i < nstrings; i++ )
+  {
+    if (! config_snapshot.getString(*snapshot_strings[i])) { return false; }
+  }
+  nbools = sizeof(snapshot_bools)/sizeof(snapshot_bools[0]);
+  for ( i = 0; i < nbools; i++ )
+  {
+    if (! config_snapshot.getBool(*snapshot_bools[i])) { return false; }
+  }
+
+  if (! config_snapshot.getBool(active_theme_found)) { return false; }
+  if (! active_theme_found) { return true; }
+
+  if (! config_snapshot.getString(theme_name)) { return false; }
+  active_theme.setName(theme_name);
+  active_theme.getColors(theme_colors);
+  ncolors = theme_colors.size();
+  for ( i = 0; i < ncolors; i++ )
+  {
+    if (! config_snapshot.getString(theme_colors[i])) { return false; }
+  }
+  if (active_theme.setColors(theme_colors) != 0) { return false; }
+
+  return config_snapshot.getString(active_theme_path);
+}
+
+/*******************************************************************************
+
+Saves settings and active color theme to the snapshot, along with the files
+they were read from. Theme directories are included so that adding a theme
+that would mask the active one is noticed. Nothing is saved if reading the
+config file gave errors or warnings, so that they are shown again next time.
+
+*******************************************************************************/
+static void write_config_snapshot()
+{
+  unsigned int i, nstrings, nbools, ncolors, nfiles;
+  std::vector<std::string> theme_colors;
+  std::string system_themes_dir, user_themes_dir;
+
+  if (! config_clean) { return; }
+
+  config_snapshot.clear();
+  nfiles = config_files.size();
+  for ( i = 0; i < nfiles; i++ )
+  {
+    config_snapshot.addDependency(config_files[i]);
+  }
+  get_theme_dirs(system_themes_dir, user_themes_dir);
+  config_snapshot.addDependency(system_themes_dir);
+  if (user_themes_dir != "") { config_snapshot.addDependency(user_themes_dir); }
+  if (active_theme_found) { config_snapshot.addDependency(active_theme_path); }
+
+  nstrings = sizeof(snapshot_strings)/sizeof(snapshot_strings[0]);
+  for ( i = 0; i < nstrings; i++ )
+  {
+    config_snapshot.putString(*snapshot_strings[i]);
+  }
+  nbools = sizeof(snapshot_bools)/sizeof(snapshot_bools[0]);
+  for ( i = 0; i < nbools; i++ )
+  {
+    config_snapshot.putBool(*snapshot_bools[i]);
+  }
+
+  config_snapshot.putBool(active_theme_found);
+  if (active_theme_found)
+  {
+    config_snapshot.putString(active_theme.name());
+    active_theme.getColors(theme_colors);
+    ncolors = theme_colors.size();
+    for ( i = 0; i < ncolors; i++ )
+    {
+      config_snapshot.putString(theme_colors[i]);
+    }
+    config_snapshot.putString(active_theme_path);
+  }
+
+  config_snapshot.save(snapshot_key);
+}
+
+/*******************************************************************************
+
+Gets editor and viewer from environment variables if available
+
+*******************************************************************************/
+static void read_env_programs()
+{
+  char *env_editor, *env_viewer;
+
+  env_editor = std::getenv("VISUAL");
+  if (env_editor == NULL)
+  {
+    env_editor = std::getenv("EDITOR");
+  }
+  if (env_editor != NULL)
+  { 
+    std::stringstream ssed;
+    ssed << env_editor;
+    ssed >> editor;
+  }
+  else
+    editor = "vi";
+
+  env_viewer = std::getenv("PAGER");
+  if (env_viewer != NULL)
+  { 
+    std::stringstream ssed;
+    ssed << env_viewer;
+    ssed >> viewer;
+  }
+  else
+    viewer = "less";
+}
+
+/*******************************************************************************
+
+Reads settings from configuration file, or from the snapshot if the file has
+not changed since it was saved
 
 *******************************************************************************/
 int read_config(const std::string & conf_file)
 {
   Config cfg;
   std::string my_conf_file, home, response;
-  char *env_home, *env_editor, *env_viewer;
+  char *env_home;
+  bool warned;
 
   // Determine config file to read
 
@@ -123,12 +351,33 @@ int read_config(const std::string & conf_file)
     else { my_conf_file = ""; }
   }
 
+  // Use snapshot if nothing has changed. It is kept in the user's home
+  // directory and is specific to the config file requested.
+
+  env_home = std::getenv("HOME");
+  if (env_home != NULL)
+    config_snapshot.setPath(std::string(env_home) +
+                            "/.cache/sboui/config.snapshot");
+  snapshot_key = PACKAGE_VERSION "\n" + conf_file;
+  if ( (config_snapshot.load(snapshot_key) == 0) && read_config_snapshot() )
+  {
+    read_env_programs();
+    config_from_snapshot = true;
+    return 0;
+  }
+  config_from_snapshot = false;
+  config_clean = false;
+  warned = false;
+  config_files.resize(0);
+
   // Read default config file if no user file
 
+  config_files.push_back(my_conf_file);
   try { cfg.readFile(my_conf_file.c_str()); }
   catch(const FileIOException &fioex)
   {
     my_conf_file = default_conf_file;
+    config_files.push_back(my_conf_file);
     try { cfg.readFile(my_conf_file.c_str()); }
     catch(const FileIOException &fioex1)
     {
@@ -170,10 +419,14 @@ int read_config(const std::string & conf_file)
   if (! cfg.lookupValue("cumulative_filters", cumulative_filters))
     cumulative_filters = true;
 
+  if (! cfg.lookupValue("background_jobs", background_jobs))
+    background_jobs = false;
+
   if (! cfg.lookupValue("layout", layout)) { layout = "horizontal"; }
   else if ( (layout != "horizontal") && (layout != "vertical") )
   {
     layout = "horizontal";
+    warned = true;
     std::cout << "Unrecognized layout option. Using default." << std::endl;
     std::cout << "Press Enter to continue ...";
     std::getline(std::cin, response);
@@ -181,29 +434,7 @@ int read_config(const std::string & conf_file)
 
   // Get editor and viewer from environment variables if available
 
-  env_editor = std::getenv("VISUAL");
-  if (env_editor == NULL)
-  {
-    env_editor = std::getenv("EDITOR");
-  }
-  if (env_editor != NULL)
-  { 
-    std::stringstream ssed;
-    ssed << env_editor;
-    ssed >> editor;
-  }
-  else
-    editor = "vi";
-
-  env_viewer = std::getenv("PAGER");
-  if (env_viewer != NULL)
-  { 
-    std::stringstream ssed;
-    ssed << env_viewer;
-    ssed >> viewer;
-  }
-  else
-    viewer = "less";
+  read_env_programs();
 
   if (! cfg.lookupValue("install_clos", install_clos)) { install_clos = ""; }
 
@@ -236,6 +467,7 @@ int read_config(const std::string & conf_file)
                 << std::endl;
       return 1;
     }
+    warned = true;
     std::cout << "No repo_dir setting in " << my_conf_file << ". Using default "
               << "for " << package_manager << "." << std::endl;
     std::cout << "Press Enter to continue ...";
@@ -322,6 +554,8 @@ int read_config(const std::string & conf_file)
   if (! cfg.lookupValue("color_theme", color_theme))
     color_theme = "default (dark)";
 
+  config_clean = (! warned);
+
   return 0;
 }
 
@@ -375,6 +609,7 @@ int write_config(const std::string & conf_file)
   root.add("color_theme", Setting::TypeString) = color_theme;
   root.add("warn_invalid_pkgnames", Setting::TypeBoolean) = warn_invalid_pkgnames;
   root.add("cumulative_filters", Setting::TypeBoolean) = cumulative_filters;
+  root.add("background_jobs", Setting::TypeBoolean) = background_jobs;
 
   // Overwrite config file
 
@@ -394,20 +629,44 @@ int write_config(const std::string & conf_file)
 
 /*******************************************************************************
 
-Sets up and applies color themes
+Sets up and applies color themes. Only the default and active themes are
+loaded here; see get_color_themes. Saves the config snapshot if the config file
+was read.
 
 *******************************************************************************/
 int setup_color()
 {
   int check;
+  unsigned int i, nthemes;
   std::string response;
   ColorTheme default_theme;
 
   color_themes.clear();
+  color_themes_listed = false;
   default_theme.setDefaultColors();
   color_themes.push_back(default_theme);
   apply_color_theme("default (dark)");
-  get_color_themes(); 
+
+  if (! config_from_snapshot)
+  {
+    active_theme_found = (find_color_theme(color_theme, active_theme,
+                                           active_theme_path) == 0);
+    write_config_snapshot();
+  }
+  if (active_theme_found)
+  {
+    nthemes = color_themes.size();
+    for ( i = 0; i < nthemes; i++ )
+    {
+      if (color_themes[i].name() == active_theme.name())
+      {
+        color_themes.erase(color_themes.begin()+i);
+        break;
+      }
+    }
+    color_themes.push_back(active_theme);
+  }
+
   if (enable_color)
   {
     check = activate_color(color_theme);
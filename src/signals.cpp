@@ -1,25 +1,84 @@
-#include <string>
 #include "signals.h"
 
+/*******************************************************************************
+
+Constructors
+
+*******************************************************************************/
+Signal::Signal()
+{
+  _type = None;
+  _key = 0;
+}
+
+Signal::Signal(event type)
+{
+  _type = type;
+  _key = 0;
+}
+
+Signal::Signal(char key)
+{
+  _type = Key;
+  _key = (unsigned char)key;
+}
+
+Signal::Signal(const char *key)
+{
+  _key = (unsigned char)key[0];
+  if (_key == 0) { _type = None; }
+  else { _type = Key; }
+}
+
+/*******************************************************************************
+
+Get attributes
+
+*******************************************************************************/
+Signal::event Signal::type() const { return _type; }
+int Signal::key() const { return _key; }
+
+/*******************************************************************************
+
+Comparison
+
+*******************************************************************************/
+bool Signal::operator == (const Signal & other) const
+{
+  return (_type == other._type) && (_key == other._key);
+}
+
+bool Signal::operator != (const Signal & other) const
+{
+  return ! (*this == other);
+}
+
+/*******************************************************************************
+
+Signals shared by widgets
+
+*******************************************************************************/
+
 namespace signals
 {
-  std::string resize = "__RESIZE__";
-  std::string quit = "__QUIT__";
-  std::string highlight = "__HIGHLIGHT__";
-  std::string highlightFirst = "__HIGHLIGHTFIRST__";
-  std::string highlightLast = "__HIGHLIGHTLAST__";
-  std::string highlightPrev = "__HIGHLIGHTPREV__";
-  std::string highlightNext = "__HIGHLIGHTNEXT__";
-  std::string highlightPrevPage = "__HIGHLIGHTPREVPAGE__";
-  std::string highlightNextPage = "__HIGHLIGHTNEXTPAGE__";
-  std::string keyTab = "__TAB__";
-  std::string keyEnter = "__ENTER__";
-  std::string scroll = "__SCROLL__";
-  std::string keyRight = "__KEYRIGHT__";
-  std::string keyLeft = "__KEYLEFT__";
-  std::string keySpace = "__KEYSPACE__";
-  std::string mouseEvent = "__MOUSEEVENT__";
-  std::string nullEvent = "__NULLEVENT__";
-  std::string tag = "__TAG__";
-  std::string keyF9 = "__KEYF9__";
+  const Signal resize(Signal::Resize);
+  const Signal quit(Signal::Quit);
+  const Signal highlight(Signal::Highlight);
+  const Signal highlightFirst(Signal::HighlightFirst);
+  const Signal highlightLast(Signal::HighlightLast);
+  const Signal highlightPrev(Signal::HighlightPrev);
+  const Signal highlightNext(Signal::HighlightNext);
+  const Signal highlightPrevPage(Signal::HighlightPrevPage);
+  const Signal highlightNextPage(Signal::HighlightNextPage);
+  const Signal keyTab(Signal::KeyTab);
+  const Signal keyEnter(Signal::KeyEnter);
+  const Signal scroll(Signal::Scroll);
+  const Signal keyRight(Signal::KeyRight);
+  const Signal keyLeft(Signal::KeyLeft);
+  const Signal keySpace(Signal::KeySpace);
+  const Signal mouseEvent(Signal::Mouse);
+  const Signal nullEvent(Signal::NullEvent);
+  const Signal tag(Signal::Tag);
+  const Signal keyF9(Signal::KeyF9);
+  const Signal ignore(Signal::Ignore);
 }
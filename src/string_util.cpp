@@ -1,4 +1,5 @@
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
 #include <vector>
@@ -59,14 +60,9 @@ Converts a string to lower case
 *******************************************************************************/
 std::string string_to_lower(const std::string & instr)
 {
-  std::string outstr;
-  std::string::size_type k, len;
+  std::string outstr(instr);
 
-  len = instr.size();
-  for ( k = 0; k < len; k++ )
-  {
-    outstr.push_back(std::tolower(instr[k]));
-  }
+  to_lower_inplace(outstr);
   return outstr;
 }
 
@@ -77,20 +73,7 @@ Trims white space, line ending characters, etc. from end of string
 *******************************************************************************/
 std::string trim(const std::string & instr)
 {
-  int i, trimlen, len;
-
-  len = instr.size();
-  trimlen = len;
-  for ( i = len-1; i >= 0; i-- )
-  {
-    if ( (instr[i] != ' ') && (instr[i] != '\n') && (instr[i] != '\0') )
-    {
-      trimlen = i+1;
-      break;
-    }
-  }
-
-  return instr.substr(0, trimlen);
+  return std::string(trim_view(instr));
 }
 
 /*******************************************************************************
@@ -100,17 +83,7 @@ Removes leading whitespace
 *******************************************************************************/
 std::string remove_leading_whitespace(const std::string & instr)
 {
-  unsigned int i, trimlen, len;
-
-  len = instr.size();
-  trimlen = 0;
-  for ( i = 0; i < len; i++ )
-  {
-    if (instr[i] == ' ') { trimlen += 1; }
-    else { break; }
-  }
-
-  return instr.substr(trimlen, len-trimlen);
+  return std::string(remove_leading_whitespace_view(instr));
 }
 
 /*******************************************************************************
@@ -120,28 +93,21 @@ Removes trailing comment from string
 *******************************************************************************/
 std::string remove_comment(const std::string & instr, char delim)
 {
-  std::size_t comment_pos;
-
-  comment_pos = instr.find_first_of(delim);
-  if (comment_pos != std::string::npos)
-    return instr.substr(0, comment_pos);
-  else
-    return instr;
+  return std::string(remove_comment_view(instr, delim));
 }
 
 /*******************************************************************************
 
-Splits a string into a vector of strings. Adapted from the answer here:
-http://stackoverflow.com/questions/236129/split-a-string-in-c#236803
+Splits a string into a vector of strings, trimming each one
 
 *******************************************************************************/
 std::vector<std::string> split(const std::string & instr, char delim)
 {
-  std::stringstream ss(instr);
+  Tokenizer tokens(instr, delim);
   std::vector<std::string> splitstr;
-  std::string item;
+  std::string_view item;
 
-  while (std::getline(ss, item, delim)) { splitstr.push_back(trim(item)); }
+  while (tokens.next(item)) { splitstr.emplace_back(item); }
 
   return splitstr;
 }
@@ -196,17 +162,16 @@ bool find_in_file(const std::string & pattern, const std::string & filename,
 {
   std::ifstream file;
   std::string searchpattern, line;
-  std::vector<std::string> splitline;
+  std::string_view word;
   bool match;
-  std::size_t pos;
-  unsigned int i, nwords, wordlen;
+  std::size_t pos, wordlen;
   char last;
 
   file.open(filename.c_str());
   if (not file.is_open()) { return false; }
 
-  if (case_sensitive) { searchpattern = pattern; }
-  else { searchpattern = string_to_lower(pattern); }
+  searchpattern = pattern;
+  if (! case_sensitive) { to_lower_inplace(searchpattern); }
 
   match = false;
   while (! file.eof())
@@ -217,7 +182,7 @@ bool find_in_file(const std::string & pattern, const std::string & filename,
 
     if (line[0] == '#') { continue; }
 
-    if (! case_sensitive) { line = string_to_lower(line); }
+    if (! case_sensitive) { to_lower_inplace(line); }
 
     // Search for pattern in entire line
 
@@ -231,19 +196,18 @@ bool find_in_file(const std::string & pattern, const std::string & filename,
 
     else
     {
-      splitline = split(line, ' ');
-      nwords = splitline.size();
-      for ( i = 0; i < nwords; i++ )
+      Tokenizer words(line, ' ');
+      while (words.next(word))
       {
-        if (splitline[i] == searchpattern) { match = true; }
-        else
+        if (word == searchpattern) { match = true; }
+        else if (word.size() > 0)
         {
-          wordlen = splitline[i].size();
-          if (splitline[i].substr(0,wordlen-1) == searchpattern)
+          wordlen = word.size();
+          if (word.substr(0,wordlen-1) == searchpattern)
           {
             // Check for punctuation
 
-            last = splitline[i][wordlen-1];
+            last = word[wordlen-1];
             if ( (last == '.') || (last == ',') || (last == ';') ||
                  (last == ':') || (last == ')') || (last == '?') ||
                  (last == '!') ) { match = true; }
@@ -258,3 +222,143 @@ bool find_in_file(const std::string & pattern, const std::string & filename,
   file.close();
   return match;
 }
+
+/*******************************************************************************
+
+Converts a duration in seconds to a short human-readable string, e.g. 1h 05m,
+12m 30s, or 45s
+
+*******************************************************************************/
+std::string duration_to_string(double seconds)
+{
+  long total, hours, minutes, secs;
+  std::string minstr, secstr;
+
+  total = long(seconds + 0.5);
+  if (total < 0) { total = 0; }
+  hours = total / 3600;
+  minutes = (total % 3600) / 60;
+  secs = total % 60;
+
+  minstr = int_to_string(int(minutes));
+  if (minutes < 10) { minstr = "0" + minstr; }
+  secstr = int_to_string(int(secs));
+  if (secs < 10) { secstr = "0" + secstr; }
+
+  if (hours > 0) { return int_to_string(int(hours)) + "h " + minstr + "m"; }
+  else if (minutes > 0) { return int_to_string(int(minutes)) + "m " + secstr
+                                 + "s"; }
+  else { return int_to_string(int(secs)) + "s"; }
+}
+
+/*******************************************************************************
+
+Converts a size in bytes to a short human-readable string, e.g. 512 B, 12 K,
+or 3 M. Returns an empty string for sizes of 0 or less.
+
+*******************************************************************************/
+std::string size_to_string(long long size)
+{
+  if (size <= 0) { return ""; }
+  else if (size < 1024) { return int_to_string(int(size)) + " B"; }
+  else if (size < 1024*1024) { return int_to_string(int(size/1024)) + " K"; }
+  else { return int_to_string(int(size/(1024*1024))) + " M"; }
+}
+
+/*******************************************************************************
+
+Converts a string to lower case in place
+
+*******************************************************************************/
+void to_lower_inplace(std::string & str)
+{
+  std::string::size_type k, len;
+
+  len = str.size();
+  for ( k = 0; k < len; k++ )
+  {
+    str[k] = std::tolower((unsigned char)str[k]);
+  }
+}
+
+/*******************************************************************************
+
+Trims white space, line ending characters, etc. from end of string view
+
+*******************************************************************************/
+std::string_view trim_view(std::string_view instr)
+{
+  std::string_view::size_type len;
+
+  len = instr.size();
+  while ( (len > 0) && ( (instr[len-1] == ' ') || (instr[len-1] == '\n') ||
+                         (instr[len-1] == '\0') ) ) { len--; }
+
+  return instr.substr(0, len);
+}
+
+/*******************************************************************************
+
+Removes leading whitespace from string view
+
+*******************************************************************************/
+std::string_view remove_leading_whitespace_view(std::string_view instr)
+{
+  std::string_view::size_type i, len;
+
+  len = instr.size();
+  for ( i = 0; i < len; i++ )
+  {
+    if (instr[i] != ' ') { break; }
+  }
+
+  return instr.substr(i);
+}
+
+/*******************************************************************************
+
+Removes trailing comment from string view
+
+*******************************************************************************/
+std::string_view remove_comment_view(std::string_view instr, char delim)
+{
+  std::string_view::size_type comment_pos;
+
+  comment_pos = instr.find(delim);
+  if (comment_pos != std::string_view::npos)
+    return instr.substr(0, comment_pos);
+  else
+    return instr;
+}
+
+/*******************************************************************************
+
+Tokenizer constructor
+
+*******************************************************************************/
+Tokenizer::Tokenizer(std::string_view instr, char delim)
+{
+  _str = instr;
+  _pos = 0;
+  _delim = delim;
+}
+
+/*******************************************************************************
+
+Gets the next field, trimmed like trim(). As with std::getline, a delimiter at
+the very end does not start another, empty field.
+
+*******************************************************************************/
+bool Tokenizer::next(std::string_view & token)
+{
+  std::string_view::size_type end;
+
+  if (_pos >= _str.size()) { return false; }
+
+  end = _str.find(_delim, _pos);
+  if (end == std::string_view::npos) { end = _str.size(); }
+  token = trim_view(_str.substr(_pos, end-_pos));
+  _pos = end+1;
+
+  return true;
+}